@@ -23,12 +23,14 @@
 
 #include "verilatedos.h"
 #include "verilated_imp.h"
+#include "verilated_fmtprog.h"
 
 #include "verilated_config.h"
 
 #include <algorithm>
 #include <cctype>
 #include <cerrno>
+#include <chrono>
 #include <sstream>
 #include <sys/stat.h>  // mkdir
 #include <list>
@@ -38,6 +40,9 @@
 #if defined(_WIN32) || defined(__MINGW32__)
 # include <direct.h>  // mkdir
 #endif
+#if !defined(_WIN32) || defined(__CYGWIN__)
+# include <sys/mman.h>  // $readmem mapping
+#endif
 // clang-format on
 
 /// Max static char array for VL_VALUE_STRING
@@ -72,6 +77,18 @@ Verilated::CommandArgValues Verilated::s_args;
 
 VerilatedImp::VerilatedImpU VerilatedImp::s_s;
 
+#ifdef VL_THREADED
+VerilatedMutex VerilatedLogAsync::s_mutex;
+std::vector<VerilatedLogAsync::Ring*> VerilatedLogAsync::s_rings;
+std::vector<VerilatedLogAsync::Entry> VerilatedLogAsync::s_pending;
+std::atomic<vluint64_t> VerilatedLogAsync::s_epoch{0};
+std::atomic<bool> VerilatedLogAsync::s_running{false};
+std::thread VerilatedLogAsync::s_thread;
+VL_THREAD_LOCAL VerilatedLogAsync::Ring* VerilatedLogAsync::t_ringp = nullptr;
+bool VerilatedLogAsync::s_holding = false;
+VerilatedLogAsync::Mark VerilatedLogAsync::s_hold;
+#endif
+
 // Guarantees to call setup() and teardown() just once.
 struct VerilatedInitializer {
     VerilatedInitializer() { setup(); }
@@ -164,7 +181,9 @@ void vl_stop_maybe(const char* filename, int linenum, const char* hier, bool may
 
 void VL_FINISH_MT(const char* filename, int linenum, const char* hier) VL_MT_SAFE {
 #ifdef VL_THREADED
+    const VerilatedLogAsync::Mark mark = VerilatedLogAsync::mark();
     VerilatedThreadMsgQueue::post(VerilatedMsg([=]() {  //
+        const VerilatedLogAsync::Hold hold{mark};  // Earlier $display output first
         vl_finish(filename, linenum, hier);
     }));
 #else
@@ -174,7 +193,9 @@ void VL_FINISH_MT(const char* filename, int linenum, const char* hier) VL_MT_SAF
 
 void VL_STOP_MT(const char* filename, int linenum, const char* hier, bool maybe) VL_MT_SAFE {
 #ifdef VL_THREADED
+    const VerilatedLogAsync::Mark mark = VerilatedLogAsync::mark();
     VerilatedThreadMsgQueue::post(VerilatedMsg([=]() {  //
+        const VerilatedLogAsync::Hold hold{mark};  // Earlier $display output first
         vl_stop_maybe(filename, linenum, hier, maybe);
     }));
 #else
@@ -184,7 +205,9 @@ void VL_STOP_MT(const char* filename, int linenum, const char* hier, bool maybe)
 
 void VL_FATAL_MT(const char* filename, int linenum, const char* hier, const char* msg) VL_MT_SAFE {
 #ifdef VL_THREADED
+    const VerilatedLogAsync::Mark mark = VerilatedLogAsync::mark();
     VerilatedThreadMsgQueue::post(VerilatedMsg([=]() {  //
+        const VerilatedLogAsync::Hold hold{mark};  // Earlier $display output first
         vl_fatal(filename, linenum, hier, msg);
     }));
 #else
@@ -254,10 +277,158 @@ void VL_PRINTF_MT(const char* formatp, ...) VL_MT_SAFE {
     va_start(ap, formatp);
     std::string out = _vl_string_vprintf(formatp, ap);
     va_end(ap);
+    if (VL_UNLIKELY(Verilated::logAsync())) {
+        VerilatedLogAsync::post(out);
+        return;
+    }
     VerilatedThreadMsgQueue::post(VerilatedMsg([=]() {  //
         VL_PRINTF("%s", out.c_str());
     }));
 }
+
+//===========================================================================
+// Asynchronous logging
+
+void VerilatedLogAsync::Ring::put(size_t pos, const void* datap, size_t len) {
+    const size_t start = pos & (SIZE - 1);
+    const size_t first = std::min(len, SIZE - start);
+    memcpy(m_data + start, datap, first);
+    memcpy(m_data, static_cast<const char*>(datap) + first, len - first);
+}
+void VerilatedLogAsync::Ring::get(size_t pos, void* datap, size_t len) const {
+    const size_t start = pos & (SIZE - 1);
+    const size_t first = std::min(len, SIZE - start);
+    memcpy(datap, m_data + start, first);
+    memcpy(static_cast<char*>(datap) + first, m_data, len - first);
+}
+
+VerilatedLogAsync::Ring* VerilatedLogAsync::newRing() VL_MT_SAFE {
+    // Rings live until exit, as a thread may end with text not yet drained
+    Ring* const ringp = new Ring;
+    const VerilatedLockGuard lock(s_mutex);
+    s_rings.push_back(ringp);
+    return ringp;
+}
+
+void VerilatedLogAsync::post(const std::string& text) VL_MT_SAFE {
+    Ring* ringp = t_ringp;
+    if (VL_UNLIKELY(!ringp)) ringp = t_ringp = newRing();
+    Header header;
+    header.m_epoch = s_epoch.load(std::memory_order_relaxed);
+    header.m_mtaskId = Verilated::mtaskId();
+    const char* datap = text.data();
+    size_t left = text.size();
+    while (left) {
+        // Long text is split; pieces stay adjacent as they share a header key
+        header.m_length = std::min(left, Ring::SIZE / 4);
+        const size_t need = sizeof(Header) + header.m_length;
+        const size_t head = ringp->m_head.load(std::memory_order_relaxed);
+        while (VL_UNLIKELY(head + need - ringp->m_tail.load(std::memory_order_acquire)
+                           > Ring::SIZE)) {
+            std::this_thread::yield();  // Full, wait for writer
+        }
+        ringp->put(head, &header, sizeof(Header));
+        ringp->put(head + sizeof(Header), datap, header.m_length);
+        ringp->m_head.store(head + need, std::memory_order_release);
+        datap += header.m_length;
+        left -= header.m_length;
+    }
+}
+
+void VerilatedLogAsync::drain() VL_REQUIRES(s_mutex) {
+    for (Ring* ringp : s_rings) {
+        size_t tail = ringp->m_tail.load(std::memory_order_relaxed);
+        const size_t head = ringp->m_head.load(std::memory_order_acquire);
+        while (tail != head) {
+            Header header;
+            ringp->get(tail, &header, sizeof(Header));
+            Entry entry;
+            entry.m_epoch = header.m_epoch;
+            entry.m_mtaskId = header.m_mtaskId;
+            entry.m_pos = tail;
+            entry.m_text.resize(header.m_length);
+            ringp->get(tail + sizeof(Header), &entry.m_text[0], header.m_length);
+            s_pending.push_back(std::move(entry));
+            tail += sizeof(Header) + header.m_length;
+        }
+        ringp->m_tail.store(tail, std::memory_order_release);
+    }
+}
+
+VerilatedLogAsync::Mark VerilatedLogAsync::mark() VL_MT_SAFE {
+    const size_t pos = t_ringp ? t_ringp->m_head.load(std::memory_order_relaxed) : 0;
+    return Mark{s_epoch.load(std::memory_order_relaxed), Verilated::mtaskId(), pos};
+}
+
+void VerilatedLogAsync::write(const Mark& limit) VL_REQUIRES(s_mutex) {
+    // Print text before limit, and before any hold
+    if (s_pending.empty()) return;
+    const Mark upto = (s_holding && s_hold < limit) ? s_hold : limit;
+    std::stable_sort(s_pending.begin(), s_pending.end(), [](const Entry& a, const Entry& b) {
+        if (a.m_epoch != b.m_epoch) return a.m_epoch < b.m_epoch;
+        return a.m_mtaskId < b.m_mtaskId;
+    });
+    auto it = s_pending.begin();
+    for (; it != s_pending.end(); ++it) {
+        if (!(it->mark() < upto)) break;
+        fwrite(it->m_text.data(), 1, it->m_text.size(), stdout);
+    }
+    if (it == s_pending.begin()) return;
+    s_pending.erase(s_pending.begin(), it);
+    fflush(stdout);
+}
+
+void VerilatedLogAsync::writerLoop() VL_MT_SAFE {
+    while (s_running.load(std::memory_order_relaxed)) {
+        {
+            const VerilatedLockGuard lock(s_mutex);
+            // Read epoch before draining, so all text of earlier evals is seen.
+            // Print that, and this eval's text from outside any mtask, which
+            // sorts before this eval's mtasks.
+            const vluint64_t epoch = s_epoch.load(std::memory_order_acquire);
+            drain();
+            write(Mark{epoch, 1, 0});
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(500));
+    }
+}
+
+void VerilatedLogAsync::start() VL_MT_UNSAFE {
+    if (s_running) return;
+    s_running = true;
+    s_thread = std::thread(&VerilatedLogAsync::writerLoop);
+}
+
+void VerilatedLogAsync::stop() VL_MT_UNSAFE {
+    if (!s_running) return;
+    s_running = false;
+    s_thread.join();
+    const VerilatedLockGuard lock(s_mutex);
+    drain();
+    write(Mark{~0ULL, 0, 0});
+}
+
+void VerilatedLogAsync::flush() VL_MT_SAFE {
+    if (!Verilated::logAsync()) return;
+    const vluint64_t epoch = s_epoch.load(std::memory_order_acquire);
+    const VerilatedLockGuard lock(s_mutex);
+    drain();
+    write(Verilated::mtaskId() ? Mark{epoch, 1, 0} : Mark{~0ULL, 0, 0});
+}
+
+VerilatedLogAsync::Hold::Hold(const Mark& mark) {
+    if (!Verilated::logAsync()) return;
+    const VerilatedLockGuard lock(s_mutex);
+    s_holding = true;
+    s_hold = mark;
+    drain();
+    write(Mark{~0ULL, 0, 0});
+}
+VerilatedLogAsync::Hold::~Hold() {
+    if (!Verilated::logAsync()) return;
+    const VerilatedLockGuard lock(s_mutex);
+    s_holding = false;
+}
 #endif
 
 //===========================================================================
@@ -278,12 +449,30 @@ Verilated::Serialized::Serialized() {
     s_timeprecision = VL_TIME_PRECISION;  // Initial value until overriden by _Vconfigure
 }
 
-void Verilated::NonSerialized::setup() { s_profThreadsFilenamep = strdup("profile_threads.dat"); }
+void Verilated::NonSerialized::setup() {
+    s_profThreadsFilenamep = strdup("profile_threads.dat");
+    s_profSampleFilenamep = strdup("profile_sample.dat");
+    s_profCostFilenamep = strdup("profile_cost.dat");
+}
 void Verilated::NonSerialized::teardown() {
+#ifdef VL_THREADED
+    if (s_logAsync) VerilatedLogAsync::stop();
+#endif
     if (s_profThreadsFilenamep) {
         VL_DO_CLEAR(free(const_cast<char*>(s_profThreadsFilenamep)),
                     s_profThreadsFilenamep = nullptr);
     }
+    if (s_profThreadsJsonFilenamep) {
+        VL_DO_CLEAR(free(const_cast<char*>(s_profThreadsJsonFilenamep)),
+                    s_profThreadsJsonFilenamep = nullptr);
+    }
+    if (s_profSampleFilenamep) {
+        VL_DO_CLEAR(free(const_cast<char*>(s_profSampleFilenamep)),
+                    s_profSampleFilenamep = nullptr);
+    }
+    if (s_profCostFilenamep) {
+        VL_DO_CLEAR(free(const_cast<char*>(s_profCostFilenamep)), s_profCostFilenamep = nullptr);
+    }
 }
 
 size_t Verilated::serialized2Size() VL_PURE { return sizeof(VerilatedImp::s_s.v.m_ser); }
@@ -375,6 +564,269 @@ WDataOutP VL_RAND_RESET_W(int obits, WDataOutP outwp) VL_MT_SAFE {
     return outwp;
 }
 
+#ifndef VL_RAND_RESET_CHUNK_BYTES
+/// Minimum bytes per thread when resetting large arrays in parallel
+# define VL_RAND_RESET_CHUNK_BYTES (64 * 1024 * 1024)
+#endif
+
+static inline vluint64_t _vl_rand_reset_mix(vluint64_t x) VL_PURE {
+    // SplitMix64 finalizer; a counter-based generator needs no state
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+static vluint64_t _vl_rand_seed_key() VL_MT_SAFE {
+    // With no seed, all users in this process share one random base
+    static const vluint64_t s_unseeded
+        = (static_cast<vluint64_t>(vl_sys_rand32()) << 32) ^ vl_sys_rand32();
+    return Verilated::randSeed() ? Verilated::randSeedDefault64() : s_unseeded;
+}
+
+static vluint64_t _vl_rand_hash_str(vluint64_t hash, const char* strp) VL_PURE {
+    // FNV-1a
+    for (const char* cp = strp; *cp; ++cp) {
+        hash = (hash ^ static_cast<vluint8_t>(*cp)) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static vluint64_t _vl_rand_reset_key(const char* scopep, const char* namep) VL_MT_SAFE {
+    vluint64_t hash = 0xcbf29ce484222325ULL;
+    hash = _vl_rand_hash_str(hash, scopep);
+    hash = _vl_rand_hash_str(hash, ".");
+    hash = _vl_rand_hash_str(hash, namep);
+    return _vl_rand_reset_mix(_vl_rand_seed_key() ^ hash);
+}
+
+template <class T_Elem>
+static void _vl_rand_reset_mask(T_Elem* datap, vluint64_t elements, T_Elem mask) VL_MT_SAFE {
+    for (vluint64_t i = 0; i < elements; ++i) datap[i] &= mask;
+}
+
+static void _vl_rand_reset_range(int obits, size_t rowbytes, vluint8_t* datap,
+                                 vluint64_t elements, vluint64_t key,
+                                 vluint64_t wordOffset) VL_MT_SAFE {
+    // Fill with 64 bits of random per 8 bytes, keyed by byte offset within the array
+    const size_t bytes = elements * rowbytes;
+    const size_t words = bytes / sizeof(vluint64_t);
+    if (Verilated::randReset() == 1) {
+        memset(datap, 0xff, bytes);
+    } else {
+        for (size_t i = 0; i < words; ++i) {
+            const vluint64_t value = _vl_rand_reset_mix(key + (wordOffset + i));
+            memcpy(datap + i * sizeof(vluint64_t), &value, sizeof(value));
+        }
+        if (const size_t tail = bytes % sizeof(vluint64_t)) {
+            const vluint64_t value = _vl_rand_reset_mix(key + (wordOffset + words));
+            memcpy(datap + words * sizeof(vluint64_t), &value, tail);
+        }
+    }
+    // Clear bits above each element's width
+    if (obits <= 8) {
+        _vl_rand_reset_mask(datap, elements, static_cast<CData>(VL_MASK_I(obits)));
+    } else if (obits <= 16) {
+        _vl_rand_reset_mask(reinterpret_cast<SData*>(datap), elements,
+                            static_cast<SData>(VL_MASK_I(obits)));
+    } else if (obits <= VL_IDATASIZE) {
+        _vl_rand_reset_mask(reinterpret_cast<IData*>(datap), elements, VL_MASK_I(obits));
+    } else if (obits <= VL_QUADSIZE) {
+        _vl_rand_reset_mask(reinterpret_cast<QData*>(datap), elements,
+                            static_cast<QData>(VL_MASK_Q(obits)));
+    } else if (VL_BITBIT_E(obits)) {
+        EData* const wordsp = reinterpret_cast<EData*>(datap);
+        const int rowWords = VL_WORDS_I(obits);
+        for (vluint64_t i = 0; i < elements; ++i) {
+            wordsp[i * rowWords + rowWords - 1] &= VL_MASK_E(obits);
+        }
+    }
+}
+
+static size_t _vl_rand_reset_row_bytes(int obits) VL_PURE {
+    return obits <= 8 ? sizeof(CData)
+           : obits <= 16 ? sizeof(SData)
+           : obits <= VL_IDATASIZE ? sizeof(IData)
+           : obits <= VL_QUADSIZE ? sizeof(QData)
+           : VL_WORDS_I(obits) * sizeof(EData);
+}
+
+vluint64_t VL_RAND_RESET_ARRAY_KEY(const char* scopep, const char* namep) VL_MT_SAFE {
+    return _vl_rand_reset_key(scopep, namep);
+}
+
+void VL_RAND_RESET_ARRAY_PAGE(int obits, vluint64_t elements, void* datap, vluint64_t key,
+                              vluint64_t firstElement) VL_MT_SAFE {
+    const size_t rowbytes = _vl_rand_reset_row_bytes(obits);
+    vluint8_t* const bytesp = static_cast<vluint8_t*>(datap);
+    if (Verilated::randReset() == 0) {
+        memset(bytesp, 0, elements * rowbytes);
+        return;
+    }
+    _vl_rand_reset_range(obits, rowbytes, bytesp, elements, key,
+                         firstElement * rowbytes / sizeof(vluint64_t));
+}
+
+void VL_RAND_RESET_ARRAY(int obits, vluint64_t elements, void* datap, const char* scopep,
+                         const char* namep) VL_MT_SAFE {
+    const size_t rowbytes = _vl_rand_reset_row_bytes(obits);
+    vluint8_t* const bytesp = static_cast<vluint8_t*>(datap);
+    if (Verilated::randReset() == 0) {
+        memset(bytesp, 0, elements * rowbytes);
+        return;
+    }
+    const vluint64_t key = _vl_rand_reset_key(scopep, namep);
+#ifdef VL_THREADED
+    // Values depend only on the key and offset, so any split gives the same result
+    const size_t threads = std::min<vluint64_t>(
+        std::thread::hardware_concurrency(), elements * rowbytes / VL_RAND_RESET_CHUNK_BYTES);
+    if (threads >= 2) {
+        // Split on multiples of 8 elements so every split is 64-bit aligned
+        const vluint64_t perThread = (elements / threads) & ~7ULL;
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i < threads; ++i) {
+            const vluint64_t first = perThread * i;
+            const vluint64_t count = (i == threads - 1) ? elements - first : perThread;
+            const auto func = [=]() {
+                _vl_rand_reset_range(obits, rowbytes, bytesp + first * rowbytes, count, key,
+                                     first * rowbytes / sizeof(vluint64_t));
+            };
+            if (i == threads - 1) {
+                func();
+            } else {
+                workers.emplace_back(func);
+            }
+        }
+        for (auto& worker : workers) worker.join();
+        return;
+    }
+#endif
+    _vl_rand_reset_range(obits, rowbytes, bytesp, elements, key, 0);
+}
+
+//===========================================================================
+// Random streams
+// Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2,
+// 3"); the 128-bit counter is the stream ID and the block index, and the key
+// comes from the seed.  Each block gives two 64-bit values.
+
+static inline void _vl_philox_round(vluint32_t ctr[4], const vluint32_t key[2]) VL_PURE {
+    const vluint64_t prod0 = static_cast<vluint64_t>(0xD2511F53U) * ctr[0];
+    const vluint64_t prod1 = static_cast<vluint64_t>(0xCD9E8D57U) * ctr[2];
+    const vluint32_t hi0 = static_cast<vluint32_t>(prod0 >> 32);
+    const vluint32_t hi1 = static_cast<vluint32_t>(prod1 >> 32);
+    const vluint32_t lo0 = static_cast<vluint32_t>(prod0);
+    const vluint32_t lo1 = static_cast<vluint32_t>(prod1);
+    ctr[0] = hi1 ^ ctr[1] ^ key[0];
+    ctr[1] = lo1;
+    ctr[2] = hi0 ^ ctr[3] ^ key[1];
+    ctr[3] = lo0;
+}
+
+static void _vl_philox_block(vluint64_t seedKey, vluint64_t stream, vluint64_t block,
+                             vluint64_t& lor, vluint64_t& hir) VL_PURE {
+    vluint32_t ctr[4] = {static_cast<vluint32_t>(block), static_cast<vluint32_t>(block >> 32),
+                         static_cast<vluint32_t>(stream), static_cast<vluint32_t>(stream >> 32)};
+    vluint32_t key[2] = {static_cast<vluint32_t>(seedKey), static_cast<vluint32_t>(seedKey >> 32)};
+    for (int round = 0; round < 10; ++round) {
+        if (round) {
+            key[0] += 0x9E3779B9U;
+            key[1] += 0xBB67AE85U;
+        }
+        _vl_philox_round(ctr, key);
+    }
+    lor = (static_cast<vluint64_t>(ctr[1]) << 32) | ctr[0];
+    hir = (static_cast<vluint64_t>(ctr[3]) << 32) | ctr[2];
+}
+
+// State words 0-1 are the index of the next value, words 2-3 the stream ID
+static inline vluint64_t _vl_rand_stream_word(WDataInP statep, int word) VL_PURE {
+    return (static_cast<vluint64_t>(statep[word + 1]) << 32) | statep[word];
+}
+static inline void _vl_rand_stream_set(WDataOutP statep, int word, vluint64_t value) {
+    statep[word] = static_cast<EData>(value);
+    statep[word + 1] = static_cast<EData>(value >> 32);
+}
+
+void VL_RAND_STREAM_INIT(WDataOutP statep, const char* scopep, vluint64_t site) VL_MT_SAFE {
+    const vluint64_t stream
+        = _vl_rand_reset_mix(site) ^ _vl_rand_hash_str(0xcbf29ce484222325ULL, scopep);
+    _vl_rand_stream_set(statep, 0, 0);
+    _vl_rand_stream_set(statep, 2, _vl_rand_reset_mix(stream));
+}
+
+// Stream ID of the call site constructing objects on this thread, 0 if none
+static VL_THREAD_LOCAL vluint64_t t_randParent = 0;
+
+VlRandStreamParent::VlRandStreamParent(WDataOutP statep) VL_MT_SAFE
+    : m_prevParent{t_randParent} {
+    // Never 0, so a parent is told from no parent
+    t_randParent = vl_rand_stream64(statep) | 1ULL;
+}
+VlRandStreamParent::~VlRandStreamParent() { t_randParent = m_prevParent; }
+
+void VL_RAND_STREAM_INIT_OBJ(WDataOutP statep, const char* classp, vluint64_t site) VL_MT_SAFE {
+    vluint64_t stream
+        = _vl_rand_reset_mix(site) ^ _vl_rand_hash_str(0xcbf29ce484222325ULL, classp);
+    if (VL_LIKELY(t_randParent)) {
+        stream ^= _vl_rand_reset_mix(t_randParent);
+    } else {
+        // Constructed where there is no stream, e.g. in a static method:
+        // number in construction order on this thread.  Threads run a fixed
+        // schedule of mtasks, so this only varies with --threads.
+        static VL_THREAD_LOCAL vluint64_t t_orphans = 0;
+        stream ^= _vl_rand_reset_mix(~++t_orphans);
+    }
+    _vl_rand_stream_set(statep, 0, 0);
+    _vl_rand_stream_set(statep, 2, _vl_rand_reset_mix(stream));
+}
+
+vluint64_t vl_rand_stream64(WDataOutP statep) VL_MT_SAFE {
+    const vluint64_t index = _vl_rand_stream_word(statep, 0);
+    _vl_rand_stream_set(statep, 0, index + 1);
+    vluint64_t lo;
+    vluint64_t hi;
+    _vl_philox_block(_vl_rand_seed_key(), _vl_rand_stream_word(statep, 2), index >> 1, lo, hi);
+    return (index & 1) ? hi : lo;
+}
+
+void vl_rand_stream_fill(WDataOutP statep, vluint64_t* outp, size_t count) VL_MT_SAFE {
+    // Same values as count calls to vl_rand_stream64, but one block per two values
+    const vluint64_t seedKey = _vl_rand_seed_key();
+    const vluint64_t stream = _vl_rand_stream_word(statep, 2);
+    vluint64_t index = _vl_rand_stream_word(statep, 0);
+    _vl_rand_stream_set(statep, 0, index + count);
+    vluint64_t lo;
+    vluint64_t hi;
+    size_t i = 0;
+    if ((index & 1) && count) {
+        _vl_philox_block(seedKey, stream, index >> 1, lo, hi);
+        outp[i++] = hi;
+        ++index;
+    }
+    for (; i + 1 < count; i += 2, index += 2) {
+        _vl_philox_block(seedKey, stream, index >> 1, outp[i], outp[i + 1]);
+    }
+    if (i < count) {
+        _vl_philox_block(seedKey, stream, index >> 1, lo, hi);
+        outp[i] = lo;
+    }
+}
+
+WDataOutP VL_RANDOM_STREAM_W(int obits, WDataOutP outwp, WDataOutP statep) VL_MT_SAFE {
+    const int words = VL_WORDS_I(obits);
+    vluint64_t values[16];
+    for (int i = 0; i < words; i += 32) {
+        const int chunk = std::min(words - i, 32);
+        vl_rand_stream_fill(statep, values, (chunk + 1) / 2);
+        for (int w = 0; w < chunk; ++w) {
+            outwp[i + w] = static_cast<EData>(values[w / 2] >> ((w & 1) * 32));
+        }
+    }
+    outwp[words - 1] &= VL_MASK_E(obits);
+    return outwp;
+}
+
 WDataOutP VL_ZERO_RESET_W(int obits, WDataOutP outwp) VL_MT_SAFE {
     for (int i = 0; i < VL_WORDS_I(obits); ++i) outwp[i] = 0;
     return outwp;
@@ -392,12 +844,182 @@ void _VL_DEBUG_PRINT_W(int lbits, WDataInP iwp) VL_MT_SAFE {
 //===========================================================================
 // Slow math
 
+// Wide multiply and divide repack 32-bit words into 64-bit limbs.  Only the
+// low half of a product is formed.  Karatsuba is not used, as at up to
+// VL_MULS_MAX_WORDS it measured no faster than the schoolbook loop.
+#define VL_MUL_MAX_LIMBS ((VL_MULS_MAX_WORDS + 1) / 2)  ///< Max limbs
+
+static inline void _vl_limb_pack(vluint64_t* op, WDataInP iwp, int words) VL_MT_SAFE {
+    for (int i = 0; i < words / 2; ++i) {
+        op[i] = static_cast<vluint64_t>(iwp[2 * i])
+                | (static_cast<vluint64_t>(iwp[2 * i + 1]) << 32ULL);
+    }
+    if (words & 1) op[words / 2] = static_cast<vluint64_t>(iwp[words - 1]);
+}
+static inline void _vl_limb_unpack(WDataOutP owp, const vluint64_t* ip, int words) VL_MT_SAFE {
+    for (int i = 0; i < words; ++i) {
+        owp[i] = static_cast<EData>(ip[i / 2] >> ((i & 1) ? 32ULL : 0ULL));
+    }
+}
+
+// 64x64->128 multiply, returns low limb
+static inline vluint64_t _vl_limb_mul1(vluint64_t a, vluint64_t b, vluint64_t& hir) VL_PURE {
+#ifdef VL_HAVE_INT128
+    const unsigned __int128 p = static_cast<unsigned __int128>(a) * b;
+    hir = static_cast<vluint64_t>(p >> 64);
+    return static_cast<vluint64_t>(p);
+#else
+    const vluint64_t al = a & 0xffffffffULL;
+    const vluint64_t ah = a >> 32ULL;
+    const vluint64_t bl = b & 0xffffffffULL;
+    const vluint64_t bh = b >> 32ULL;
+    const vluint64_t ll = al * bl;
+    const vluint64_t lh = al * bh;
+    const vluint64_t hl = ah * bl;
+    const vluint64_t mid = (ll >> 32ULL) + (lh & 0xffffffffULL) + (hl & 0xffffffffULL);
+    hir = ah * bh + (lh >> 32ULL) + (hl >> 32ULL) + (mid >> 32ULL);
+    return (mid << 32ULL) | (ll & 0xffffffffULL);
+#endif
+}
+
+// op[0..n) += ap[0..n) * b, returns carry-out limb
+static vluint64_t _vl_limb_addmul1(vluint64_t* op, const vluint64_t* ap, int n,
+                                   vluint64_t b) VL_MT_SAFE {
+    vluint64_t carry = 0;
+    for (int i = 0; i < n; ++i) {
+        vluint64_t hi;
+        vluint64_t lo = _vl_limb_mul1(ap[i], b, hi);
+        lo += carry;
+        hi += (lo < carry);
+        lo += op[i];
+        hi += (lo < op[i]);
+        op[i] = lo;
+        carry = hi;
+    }
+    return carry;
+}
+
+// Truncated product op[0..n) = (ap[0..n) * bp[0..n)) mod B^n
+static void _vl_limb_mullo(vluint64_t* op, const vluint64_t* ap, const vluint64_t* bp,
+                           int n) VL_MT_SAFE {
+    for (int i = 0; i < n; ++i) op[i] = 0;
+    for (int j = 0; j < n; ++j) _vl_limb_addmul1(op + j, ap, n - j, bp[j]);
+}
+
+WDataOutP _vl_mul_w(int words, WDataOutP owp, WDataInP lwp, WDataInP rwp) VL_MT_SAFE {
+    // owp may alias lwp and/or rwp
+    const int limbs = (words + 1) / 2;
+    vluint64_t a[VL_MUL_MAX_LIMBS];
+    vluint64_t b[VL_MUL_MAX_LIMBS];
+    vluint64_t o[VL_MUL_MAX_LIMBS];
+    _vl_limb_pack(a, lwp, words);
+    _vl_limb_pack(b, rwp, words);
+    _vl_limb_mullo(o, a, b, limbs);
+    _vl_limb_unpack(owp, o, words);
+    // Last output word is dirty
+    return owp;
+}
+
+#ifdef VL_HAVE_INT128
+static WDataOutP _vl_moddiv_limb(int lbits, WDataOutP owp, WDataInP lwp, WDataInP rwp,
+                                 bool is_modulus) VL_MT_SAFE {
+    // Knuth Algorithm D as in _vl_moddiv_w, with 64-bit digits
+    typedef unsigned __int128 vluint128_t;
+    const int words = VL_WORDS_I(lbits);
+    const int limbs = (words + 1) / 2;
+    vluint64_t u[VL_MUL_MAX_LIMBS + 1];
+    vluint64_t v[VL_MUL_MAX_LIMBS];
+    vluint64_t q[VL_MUL_MAX_LIMBS];
+    _vl_limb_pack(u, lwp, words);
+    _vl_limb_pack(v, rwp, words);
+    int um = limbs;
+    while (um > 0 && !u[um - 1]) --um;
+    int vm = limbs;
+    while (vm > 0 && !v[vm - 1]) --vm;
+    for (int i = 0; i < words; ++i) owp[i] = 0;
+    if (VL_UNLIKELY(vm == 0)  // rwp==0 so division by zero.  Return 0.
+        || VL_UNLIKELY(um == 0)) {  // 0/x so short circuit and return 0
+        return owp;
+    }
+    for (int i = 0; i < limbs; ++i) q[i] = 0;
+
+    if (um < vm) {  // Quotient zero, remainder is the dividend
+    } else if (vm == 1) {  // Single divisor limb breaks rest of algorithm
+        vluint64_t k = 0;
+        for (int j = um - 1; j >= 0; --j) {
+            const vluint128_t unw = (static_cast<vluint128_t>(k) << 64) | u[j];
+            q[j] = static_cast<vluint64_t>(unw / v[0]);
+            k = static_cast<vluint64_t>(unw - static_cast<vluint128_t>(q[j]) * v[0]);
+        }
+        u[0] = k;
+        for (int i = 1; i < limbs; ++i) u[i] = 0;
+    } else {
+        // Normalize so MSB of vn[vm-1] is set
+        const int s = __builtin_clzll(v[vm - 1]);
+        vluint64_t un[VL_MUL_MAX_LIMBS + 1];
+        vluint64_t vn[VL_MUL_MAX_LIMBS];
+        for (int i = vm - 1; i > 0; --i) vn[i] = (v[i] << s) | (s ? v[i - 1] >> (64 - s) : 0);
+        vn[0] = v[0] << s;
+        un[um] = s ? u[um - 1] >> (64 - s) : 0;
+        for (int i = um - 1; i > 0; --i) un[i] = (u[i] << s) | (s ? u[i - 1] >> (64 - s) : 0);
+        un[0] = u[0] << s;
+
+        for (int j = um - vm; j >= 0; --j) {
+            // Estimate
+            const vluint128_t unw = (static_cast<vluint128_t>(un[j + vm]) << 64) | un[j + vm - 1];
+            vluint128_t qhat = unw / vn[vm - 1];
+            vluint128_t rhat = unw - qhat * vn[vm - 1];
+            while ((qhat >> 64) || (qhat * vn[vm - 2] > ((rhat << 64) | un[j + vm - 2]))) {
+                --qhat;
+                rhat += vn[vm - 1];
+                if (rhat >> 64) break;
+            }
+            // Multiply by estimate and subtract
+            vluint64_t borrow = 0;
+            vluint64_t carry = 0;
+            for (int i = 0; i < vm; ++i) {
+                const vluint128_t p = qhat * vn[i] + carry;
+                carry = static_cast<vluint64_t>(p >> 64);
+                const vluint64_t plo = static_cast<vluint64_t>(p);
+                const vluint64_t d = un[i + j] - plo;
+                const vluint64_t b1 = (un[i + j] < plo);
+                un[i + j] = d - borrow;
+                borrow = b1 | (d < borrow);
+            }
+            const vluint128_t sub = static_cast<vluint128_t>(carry) + borrow;
+            const bool over = (un[j + vm] < sub);
+            un[j + vm] -= static_cast<vluint64_t>(sub);
+            q[j] = static_cast<vluint64_t>(qhat);  // Save quotient digit
+            if (over) {
+                // Over subtracted; correct by adding back
+                --q[j];
+                vluint64_t k = 0;
+                for (int i = 0; i < vm; ++i) {
+                    const vluint128_t t = static_cast<vluint128_t>(un[i + j]) + vn[i] + k;
+                    un[i + j] = static_cast<vluint64_t>(t);
+                    k = static_cast<vluint64_t>(t >> 64);
+                }
+                un[j + vm] += k;
+            }
+        }
+        // Reverse normalization of the remainder
+        for (int i = 0; i < vm; ++i) u[i] = (un[i] >> s) | (s ? un[i + 1] << (64 - s) : 0);
+        for (int i = vm; i < limbs; ++i) u[i] = 0;
+    }
+    _vl_limb_unpack(owp, is_modulus ? u : q, words);
+    return owp;
+}
+#endif
+
 WDataOutP _vl_moddiv_w(int lbits, WDataOutP owp, WDataInP lwp, WDataInP rwp,
                        bool is_modulus) VL_MT_SAFE {
     // See Knuth Algorithm D.  Computes u/v = q.r
     // This isn't massively tuned, as wide division is rare
     // for debug see V3Number version
     // Requires clean input
+#ifdef VL_HAVE_INT128
+    if (VL_WORDS_I(lbits) > 2) return _vl_moddiv_limb(lbits, owp, lwp, rwp, is_modulus);
+#endif
     int words = VL_WORDS_I(lbits);
     for (int i = 0; i < words; ++i) owp[i] = 0;
     // Find MSB and check for zero.
@@ -508,22 +1130,25 @@ WDataOutP _vl_moddiv_w(int lbits, WDataOutP owp, WDataInP lwp, WDataInP rwp,
 WDataOutP VL_POW_WWW(int obits, int, int rbits, WDataOutP owp, WDataInP lwp,
                      WDataInP rwp) VL_MT_SAFE {
     // obits==lbits, rbits can be different
+    const int words = VL_WORDS_I(obits);
     owp[0] = 1;
-    for (int i = 1; i < VL_WORDS_I(obits); i++) owp[i] = 0;
+    for (int i = 1; i < words; i++) owp[i] = 0;
+    // Only need to square up to the most significant exponent bit
+    int rmsbp1 = VL_MOSTSETBITP1_W(VL_WORDS_I(rbits), rwp);
+    if (rmsbp1 > rbits) rmsbp1 = rbits;
     // cppcheck-suppress variableScope
     WData powstore[VL_MULS_MAX_WORDS];  // Fixed size, as MSVC++ doesn't allow [words] here
-    WData lastpowstore[VL_MULS_MAX_WORDS];  // Fixed size, as MSVC++ doesn't allow [words] here
-    WData lastoutstore[VL_MULS_MAX_WORDS];  // Fixed size, as MSVC++ doesn't allow [words] here
-    // cppcheck-suppress variableScope
     VL_ASSIGN_W(obits, powstore, lwp);
-    for (int bit = 0; bit < rbits; bit++) {
-        if (bit > 0) {  // power = power*power
-            VL_ASSIGN_W(obits, lastpowstore, powstore);
-            VL_MUL_W(VL_WORDS_I(obits), powstore, lastpowstore, lastpowstore);
-        }
+    bool outOne = true;  // owp is still 1, so a multiply is a copy
+    for (int bit = 0; bit < rmsbp1; bit++) {
+        if (bit > 0) _vl_mul_w(words, powstore, powstore, powstore);  // power = power*power
         if (VL_BITISSET_W(rwp, bit)) {  // out *= power
-            VL_ASSIGN_W(obits, lastoutstore, owp);
-            VL_MUL_W(VL_WORDS_I(obits), owp, lastoutstore, powstore);
+            if (outOne) {
+                VL_ASSIGN_W(obits, owp, powstore);
+                outOne = false;
+            } else {
+                _vl_mul_w(words, owp, owp, powstore);
+            }
         }
     }
     return owp;
@@ -692,251 +1317,256 @@ std::string _vl_vsformat_time(char* tmp, double ld, bool left, size_t width) {
 // Do a va_arg returning a quad, assuming input argument is anything less than wide
 #define _VL_VA_ARG_Q(ap, bits) (((bits) <= VL_IDATASIZE) ? va_arg(ap, IData) : va_arg(ap, QData))
 
-void _vl_vsformat(std::string& output, const char* formatp, va_list ap) VL_MT_SAFE {
-    // Format a Verilog $write style format into the output list
-    // The format must be pre-processed (and lower cased) by Verilator
+static inline char* _vl_vsformat_udec(char* endp, vluint64_t value) VL_PURE {
+    // Write decimal digits ending just before endp, return first digit
+    static const char s_pairs[] = "00010203040506070809"
+                                  "10111213141516171819"
+                                  "20212223242526272829"
+                                  "30313233343536373839"
+                                  "40414243444546474849"
+                                  "50515253545556575859"
+                                  "60616263646566676869"
+                                  "70717273747576777879"
+                                  "80818283848586878889"
+                                  "90919293949596979899";
+    char* digitp = endp;
+    while (value >= 100) {
+        const unsigned pair = static_cast<unsigned>(value % 100) * 2;
+        value /= 100;
+        *--digitp = s_pairs[pair + 1];
+        *--digitp = s_pairs[pair];
+    }
+    if (value >= 10) {
+        const unsigned pair = static_cast<unsigned>(value) * 2;
+        *--digitp = s_pairs[pair + 1];
+        *--digitp = s_pairs[pair];
+    } else {
+        *--digitp = static_cast<char>('0' + value);
+    }
+    return digitp;
+}
+
+static inline void _vl_vsformat_pad(std::string& output, const char* datap, size_t digits,
+                                    size_t width, bool left, char padChar) {
+    const size_t needmore = width > digits ? width - digits : 0;
+    if (!left && needmore) output.append(needmore, padChar);
+    output.append(datap, digits);
+    if (left && needmore) output.append(needmore, padChar);
+}
+
+static void _vl_vsformat_run(std::string& output, const char* progp, va_list ap) VL_MT_SAFE {
+    // Execute a format program into the output list
     // Arguments are in "width, arg-value (or WDataIn* if wide)" form
     //
     // Note uses a single buffer internally; presumes only one usage per printf
     // Note also assumes variables < 64 are not wide, this assumption is
     // sometimes not true in low-level routines written here in verilated.cpp
     static VL_THREAD_LOCAL char t_tmp[VL_VALUE_STRING_MAX_WIDTH];
-    const char* pctp = nullptr;  // Most recent %##.##g format
-    bool inPct = false;
-    bool widthSet = false;
-    bool left = false;
-    size_t width = 0;
-    for (const char* pos = formatp; *pos; ++pos) {
-        if (!inPct && pos[0] == '%') {
-            pctp = pos;
-            inPct = true;
-            widthSet = false;
-            width = 0;
-        } else if (!inPct) {  // Normal text
-            // Fast-forward to next escape and add to output
-            const char* ep = pos;
-            while (ep[0] && ep[0] != '%') ep++;
-            if (ep != pos) {
-                output.append(pos, ep - pos);
-                pos += ep - pos - 1;
-            }
-        } else {  // Format character
-            inPct = false;
-            char fmt = pos[0];
-            switch (fmt) {
-            case '0':  // FALLTHRU
-            case '1':  // FALLTHRU
-            case '2':  // FALLTHRU
-            case '3':  // FALLTHRU
-            case '4':  // FALLTHRU
-            case '5':  // FALLTHRU
-            case '6':  // FALLTHRU
-            case '7':  // FALLTHRU
-            case '8':  // FALLTHRU
-            case '9':
-                inPct = true;  // Get more digits
-                widthSet = true;
-                width = width * 10 + (fmt - '0');
-                break;
-            case '-':
-                left = true;
-                inPct = true;  // Get more digits
-                break;
-            case '.':
-                inPct = true;  // Get more digits
-                break;
-            case '%':  //
-                output += '%';
-                break;
-            case 'N': {  // "C" string with name of module, add . if needed
-                const char* cstrp = va_arg(ap, const char*);
-                if (VL_LIKELY(*cstrp)) {
-                    output += cstrp;
-                    output += '.';
-                }
-                break;
-            }
-            case 'S': {  // "C" string
-                const char* cstrp = va_arg(ap, const char*);
+    for (const char* pos = progp; *pos;) {
+        const char fmt = *pos++;
+        if (fmt == VL_FMTPROG_TEXT) {
+            const size_t len = VerilatedFmtProg::readNum(pos);
+            output.append(pos, len);
+            pos += len;
+            continue;
+        }
+        const char flags = *pos++;
+        const bool widthSet = flags & VL_FMTPROG_WIDTHSET;
+        const bool left = flags & VL_FMTPROG_LEFT;
+        size_t width = VerilatedFmtProg::readNum(pos);
+        switch (fmt) {
+        case 'N': {  // "C" string with name of module, add . if needed
+            const char* cstrp = va_arg(ap, const char*);
+            if (VL_LIKELY(*cstrp)) {
                 output += cstrp;
-                break;
+                output += '.';
             }
-            case '@': {  // Verilog/C++ string
-                va_arg(ap, int);  // # bits is ignored
-                const std::string* cstrp = va_arg(ap, const std::string*);
-                std::string padding;
-                if (width > cstrp->size()) padding.append(width - cstrp->size(), ' ');
-                output += left ? (*cstrp + padding) : (padding + *cstrp);
-                break;
+            break;
+        }
+        case 'S': {  // "C" string
+            const char* cstrp = va_arg(ap, const char*);
+            output += cstrp;
+            break;
+        }
+        case '@': {  // Verilog/C++ string
+            va_arg(ap, int);  // # bits is ignored
+            const std::string* cstrp = va_arg(ap, const std::string*);
+            _vl_vsformat_pad(output, cstrp->data(), cstrp->size(), width, left, ' ');
+            break;
+        }
+        case 'e':
+        case 'f':
+        case 'g':
+        case '^': {  // Realtime
+            const int lbits = va_arg(ap, int);
+            double d = va_arg(ap, double);
+            if (lbits) {}  // UNUSED - always 64
+            if (fmt == '^') {  // Realtime
+                if (!widthSet) width = VerilatedImp::timeFormatWidth();
+                output += _vl_vsformat_time(t_tmp, d, left, width);
+            } else {
+                const size_t speclen = VerilatedFmtProg::readNum(pos);
+                const std::string fmts(pos, speclen);
+                pos += speclen;
+                sprintf(t_tmp, fmts.c_str(), d);
+                output += t_tmp;
             }
-            case 'e':
-            case 'f':
-            case 'g':
-            case '^': {  // Realtime
-                const int lbits = va_arg(ap, int);
-                double d = va_arg(ap, double);
-                if (lbits) {}  // UNUSED - always 64
-                if (fmt == '^') {  // Realtime
-                    if (!widthSet) width = VerilatedImp::timeFormatWidth();
-                    output += _vl_vsformat_time(t_tmp, d, left, width);
-                } else {
-                    std::string fmts(pctp, pos - pctp + 1);
-                    sprintf(t_tmp, fmts.c_str(), d);
-                    output += t_tmp;
-                }
-                break;
+            break;
+        }
+        default: {
+            // Deal with all read-and-print somethings
+            const int lbits = va_arg(ap, int);
+            QData ld = 0;
+            WData qlwp[VL_WQ_WORDS_E];
+            WDataInP lwp = nullptr;
+            if (lbits <= VL_QUADSIZE) {
+                ld = _VL_VA_ARG_Q(ap, lbits);
+                VL_SET_WQ(qlwp, ld);
+                lwp = qlwp;
+            } else {
+                lwp = va_arg(ap, WDataInP);
+                ld = lwp[0];
             }
-            default: {
-                // Deal with all read-and-print somethings
-                const int lbits = va_arg(ap, int);
-                QData ld = 0;
-                WData qlwp[VL_WQ_WORDS_E];
-                WDataInP lwp = nullptr;
+            int lsb = lbits - 1;
+            if (widthSet && width == 0) {
                 if (lbits <= VL_QUADSIZE) {
-                    ld = _VL_VA_ARG_Q(ap, lbits);
-                    VL_SET_WQ(qlwp, ld);
-                    lwp = qlwp;
+                    while (lsb && !VL_BITISSET_Q(ld, lsb)) --lsb;
                 } else {
-                    lwp = va_arg(ap, WDataInP);
-                    ld = lwp[0];
-                }
-                int lsb = lbits - 1;
-                if (widthSet && width == 0) {
                     while (lsb && !VL_BITISSET_W(lwp, lsb)) --lsb;
                 }
-                switch (fmt) {
-                case 'c': {
-                    IData charval = ld & 0xff;
-                    output += static_cast<char>(charval);
-                    break;
-                }
-                case 's': {
-                    std::string field;
-                    for (; lsb >= 0; --lsb) {
-                        lsb = (lsb / 8) * 8;  // Next digit
-                        IData charval = VL_BITRSHIFT_W(lwp, lsb) & 0xff;
-                        field += (charval == 0) ? ' ' : charval;
-                    }
-                    std::string padding;
-                    if (width > field.size()) padding.append(width - field.size(), ' ');
-                    output += left ? (field + padding) : (padding + field);
-                    break;
+            }
+            switch (fmt) {
+            case 'c': {
+                IData charval = ld & 0xff;
+                output += static_cast<char>(charval);
+                break;
+            }
+            case 's': {
+                std::string field;
+                for (; lsb >= 0; --lsb) {
+                    lsb = (lsb / 8) * 8;  // Next digit
+                    IData charval = VL_BITRSHIFT_W(lwp, lsb) & 0xff;
+                    field += (charval == 0) ? ' ' : charval;
                 }
-                case 'd': {  // Signed decimal
-                    int digits = 0;
-                    std::string append;
-                    if (lbits <= VL_QUADSIZE) {
-                        digits = sprintf(t_tmp, "%" VL_PRI64 "d",
-                                         static_cast<vlsint64_t>(VL_EXTENDS_QQ(lbits, lbits, ld)));
-                        append = t_tmp;
+                _vl_vsformat_pad(output, field.data(), field.size(), width, left, ' ');
+                break;
+            }
+            case 'd':  // Signed decimal
+            case '#': {  // Unsigned decimal
+                const char padChar = (flags & VL_FMTPROG_ZERO) ? '0' : ' ';
+                if (lbits <= VL_QUADSIZE) {
+                    char* const endp = t_tmp + 24;
+                    char* digitp;
+                    const vlsint64_t sd = VL_EXTENDS_QQ(lbits, lbits, ld);
+                    if (fmt == 'd' && sd < 0) {
+                        digitp = _vl_vsformat_udec(endp, -static_cast<vluint64_t>(sd));
+                        *--digitp = '-';
                     } else {
-                        if (VL_SIGN_E(lbits, lwp[VL_WORDS_I(lbits) - 1])) {
-                            WData neg[VL_VALUE_STRING_MAX_WIDTH / 4 + 2];
-                            VL_NEGATE_W(VL_WORDS_I(lbits), neg, lwp);
-                            append = std::string("-") + VL_DECIMAL_NW(lbits, neg);
-                        } else {
-                            append = VL_DECIMAL_NW(lbits, lwp);
-                        }
-                        digits = append.length();
+                        digitp = _vl_vsformat_udec(endp, ld);
                     }
-                    int needmore = width - digits;
-                    std::string padding;
-                    if (needmore > 0) {
-                        if (pctp && pctp[0] && pctp[1] == '0') {  // %0
-                            padding.append(needmore, '0');  // Pre-pad zero
-                        } else {
-                            padding.append(needmore, ' ');  // Pre-pad spaces
-                        }
-                    }
-                    output += left ? (append + padding) : (padding + append);
-                    break;
-                }
-                case '#': {  // Unsigned decimal
-                    int digits = 0;
+                    _vl_vsformat_pad(output, digitp, endp - digitp, width, left, padChar);
+                } else {
                     std::string append;
-                    if (lbits <= VL_QUADSIZE) {
-                        digits = sprintf(t_tmp, "%" VL_PRI64 "u", ld);
-                        append = t_tmp;
+                    if (fmt == 'd' && VL_SIGN_E(lbits, lwp[VL_WORDS_I(lbits) - 1])) {
+                        WData neg[VL_VALUE_STRING_MAX_WIDTH / 4 + 2];
+                        VL_NEGATE_W(VL_WORDS_I(lbits), neg, lwp);
+                        append = std::string("-") + VL_DECIMAL_NW(lbits, neg);
                     } else {
                         append = VL_DECIMAL_NW(lbits, lwp);
-                        digits = append.length();
-                    }
-                    int needmore = width - digits;
-                    std::string padding;
-                    if (needmore > 0) {
-                        if (pctp && pctp[0] && pctp[1] == '0') {  // %0
-                            padding.append(needmore, '0');  // Pre-pad zero
-                        } else {
-                            padding.append(needmore, ' ');  // Pre-pad spaces
-                        }
                     }
-                    output += left ? (append + padding) : (padding + append);
-                    break;
+                    _vl_vsformat_pad(output, append.data(), append.size(), width, left, padChar);
                 }
-                case 't': {  // Time
-                    if (!widthSet) width = VerilatedImp::timeFormatWidth();
-                    output += _vl_vsformat_time(t_tmp, static_cast<double>(ld), left, width);
-                    break;
-                }
-                case 'b':
+                break;
+            }
+            case 't': {  // Time
+                if (!widthSet) width = VerilatedImp::timeFormatWidth();
+                output += _vl_vsformat_time(t_tmp, static_cast<double>(ld), left, width);
+                break;
+            }
+            case 'b':
+                if (lbits <= VL_QUADSIZE) {
+                    const size_t start = output.size();
+                    output.resize(start + lsb + 1);
+                    char* digitp = &output[start];
+                    for (; lsb >= 0; --lsb) *digitp++ = '0' + ((ld >> lsb) & 1);
+                } else {
                     for (; lsb >= 0; --lsb) output += (VL_BITRSHIFT_W(lwp, lsb) & 1) + '0';
-                    break;
-                case 'o':
-                    for (; lsb >= 0; --lsb) {
-                        lsb = (lsb / 3) * 3;  // Next digit
-                        // Octal numbers may span more than one wide word,
-                        // so we need to grab each bit separately and check for overrun
-                        // Octal is rare, so we'll do it a slow simple way
-                        output += static_cast<char>(
-                            '0' + ((VL_BITISSETLIMIT_W(lwp, lbits, lsb + 0)) ? 1 : 0)
-                            + ((VL_BITISSETLIMIT_W(lwp, lbits, lsb + 1)) ? 2 : 0)
-                            + ((VL_BITISSETLIMIT_W(lwp, lbits, lsb + 2)) ? 4 : 0));
-                    }
-                    break;
-                case 'u':
-                case 'z': {  // Packed 4-state
-                    const bool is_4_state = (fmt == 'z');
-                    output.reserve(output.size() + ((is_4_state ? 2 : 1) * VL_WORDS_I(lbits)));
-                    int bytes_to_go = VL_BYTES_I(lbits);
-                    int bit = 0;
-                    while (bytes_to_go > 0) {
-                        const int wr_bytes = std::min(4, bytes_to_go);
-                        for (int byte = 0; byte < wr_bytes; byte++, bit += 8)
-                            output += static_cast<char>(VL_BITRSHIFT_W(lwp, bit) & 0xff);
-                        output.append(4 - wr_bytes, static_cast<char>(0));
-                        if (is_4_state) output.append(4, static_cast<char>(0));
-                        bytes_to_go -= wr_bytes;
+                }
+                break;
+            case 'o':
+                for (; lsb >= 0; --lsb) {
+                    lsb = (lsb / 3) * 3;  // Next digit
+                    // Octal numbers may span more than one wide word,
+                    // so we need to grab each bit separately and check for overrun
+                    // Octal is rare, so we'll do it a slow simple way
+                    const int digit = ((VL_BITISSETLIMIT_W(lwp, lbits, lsb + 0)) ? 1 : 0)
+                                      + ((VL_BITISSETLIMIT_W(lwp, lbits, lsb + 1)) ? 2 : 0)
+                                      + ((VL_BITISSETLIMIT_W(lwp, lbits, lsb + 2)) ? 4 : 0);
+                    output += static_cast<char>('0' + digit);
+                }
+                break;
+            case 'u':
+            case 'z': {  // Packed 4-state
+                const bool is_4_state = (fmt == 'z');
+                output.reserve(output.size() + ((is_4_state ? 2 : 1) * VL_WORDS_I(lbits)));
+                int bytes_to_go = VL_BYTES_I(lbits);
+                int bit = 0;
+                while (bytes_to_go > 0) {
+                    const int wr_bytes = std::min(4, bytes_to_go);
+                    for (int byte = 0; byte < wr_bytes; byte++, bit += 8)
+                        output += static_cast<char>(VL_BITRSHIFT_W(lwp, bit) & 0xff);
+                    output.append(4 - wr_bytes, static_cast<char>(0));
+                    if (is_4_state) output.append(4, static_cast<char>(0));
+                    bytes_to_go -= wr_bytes;
+                }
+                break;
+            }
+            case 'v':  // Strength; assume always strong
+                for (lsb = lbits - 1; lsb >= 0; --lsb) {
+                    if (VL_BITRSHIFT_W(lwp, lsb) & 1) {
+                        output += "St1 ";
+                    } else {
+                        output += "St0 ";
                     }
-                    break;
                 }
-                case 'v':  // Strength; assume always strong
-                    for (lsb = lbits - 1; lsb >= 0; --lsb) {
-                        if (VL_BITRSHIFT_W(lwp, lsb) & 1) {
-                            output += "St1 ";
-                        } else {
-                            output += "St0 ";
-                        }
+                break;
+            case 'x':
+                if (lbits <= VL_QUADSIZE) {
+                    const int digits = lsb / 4 + 1;
+                    const size_t start = output.size();
+                    output.resize(start + digits);
+                    char* digitp = &output[start];
+                    for (int nibble = digits - 1; nibble >= 0; --nibble) {
+                        *digitp++ = "0123456789abcdef"[(ld >> (nibble * 4)) & 0xf];
                     }
-                    break;
-                case 'x':
+                } else {
                     for (; lsb >= 0; --lsb) {
                         lsb = (lsb / 4) * 4;  // Next digit
                         IData charval = VL_BITRSHIFT_W(lwp, lsb) & 0xf;
                         output += "0123456789abcdef"[charval];
                     }
-                    break;
-                default: {  // LCOV_EXCL_START
-                    std::string msg = std::string("Unknown _vl_vsformat code: ") + pos[0];
-                    VL_FATAL_MT(__FILE__, __LINE__, "", msg.c_str());
-                    break;
-                }  // LCOV_EXCL_STOP
-                }  // switch
-            }
+                }
+                break;
+            default: {  // LCOV_EXCL_START
+                std::string msg = std::string("Unknown _vl_vsformat code: ") + fmt;
+                VL_FATAL_MT(__FILE__, __LINE__, "", msg.c_str());
+                break;
+            }  // LCOV_EXCL_STOP
             }  // switch
         }
+        }  // switch
     }
 }
 
+void _vl_vsformat(std::string& output, const char* formatp, va_list ap) VL_MT_SAFE {
+    // Format a Verilog $write style format into the output list
+    // The format must be pre-processed (and lower cased) by Verilator
+    // Constant formats are instead compiled by Verilator, see VerilatedFmtProg
+    static VL_THREAD_LOCAL std::string t_prog;
+    VerilatedFmtProg::compile(t_prog, formatp);
+    _vl_vsformat_run(output, t_prog.c_str(), ap);
+}
+
 static inline bool _vl_vsss_eof(FILE* fp, int floc) VL_MT_SAFE {
     if (fp) {
         return feof(fp) ? true : false;  // true : false to prevent MSVC++ warning
@@ -1342,63 +1972,69 @@ void VL_FCLOSE_I(IData fdi) VL_MT_SAFE {
     VerilatedImp::fdClose(fdi);
 }
 
-void VL_FFLUSH_ALL() VL_MT_SAFE { fflush(stdout); }
+void VL_FFLUSH_ALL() VL_MT_SAFE {
+#ifdef VL_THREADED
+    VerilatedLogAsync::flush();
+#endif
+    fflush(stdout);
+}
 
-void VL_SFORMAT_X(int obits, CData& destr, const char* formatp, ...) VL_MT_SAFE {
+static const std::string& _vl_vsformat_tmp(bool isProg, const char* formatp,
+                                           va_list ap) VL_MT_SAFE {
+    // Format into this thread's scratch string; formatp is a program if isProg
     static VL_THREAD_LOCAL std::string t_output;  // static only for speed
     t_output = "";
+    if (isProg) {
+        _vl_vsformat_run(t_output, formatp, ap);
+    } else {
+        _vl_vsformat(t_output, formatp, ap);
+    }
+    return t_output;
+}
+static void _vl_vsformat_vint(int obits, void* destp, bool isProg, const char* formatp,
+                              va_list ap) VL_MT_SAFE {
+    const std::string& output = _vl_vsformat_tmp(isProg, formatp, ap);
+    _VL_STRING_TO_VINT(obits, destp, output.length(), output.c_str());
+}
+static void _vl_vsformat_write(bool isProg, const char* formatp, va_list ap) VL_MT_SAFE {
+    const std::string& output = _vl_vsformat_tmp(isProg, formatp, ap);
+#ifdef VL_THREADED
+    VerilatedThreadMsgQueue::postText(output);
+#else
+    VL_PRINTF("%s", output.c_str());
+#endif
+}
+
+void VL_SFORMAT_X(int obits, CData& destr, const char* formatp, ...) VL_MT_SAFE {
     va_list ap;
     va_start(ap, formatp);
-    _vl_vsformat(t_output, formatp, ap);
+    _vl_vsformat_vint(obits, &destr, false, formatp, ap);
     va_end(ap);
-
-    _VL_STRING_TO_VINT(obits, &destr, t_output.length(), t_output.c_str());
 }
-
 void VL_SFORMAT_X(int obits, SData& destr, const char* formatp, ...) VL_MT_SAFE {
-    static VL_THREAD_LOCAL std::string t_output;  // static only for speed
-    t_output = "";
     va_list ap;
     va_start(ap, formatp);
-    _vl_vsformat(t_output, formatp, ap);
+    _vl_vsformat_vint(obits, &destr, false, formatp, ap);
     va_end(ap);
-
-    _VL_STRING_TO_VINT(obits, &destr, t_output.length(), t_output.c_str());
 }
-
 void VL_SFORMAT_X(int obits, IData& destr, const char* formatp, ...) VL_MT_SAFE {
-    static VL_THREAD_LOCAL std::string t_output;  // static only for speed
-    t_output = "";
     va_list ap;
     va_start(ap, formatp);
-    _vl_vsformat(t_output, formatp, ap);
+    _vl_vsformat_vint(obits, &destr, false, formatp, ap);
     va_end(ap);
-
-    _VL_STRING_TO_VINT(obits, &destr, t_output.length(), t_output.c_str());
 }
-
 void VL_SFORMAT_X(int obits, QData& destr, const char* formatp, ...) VL_MT_SAFE {
-    static VL_THREAD_LOCAL std::string t_output;  // static only for speed
-    t_output = "";
     va_list ap;
     va_start(ap, formatp);
-    _vl_vsformat(t_output, formatp, ap);
+    _vl_vsformat_vint(obits, &destr, false, formatp, ap);
     va_end(ap);
-
-    _VL_STRING_TO_VINT(obits, &destr, t_output.length(), t_output.c_str());
 }
-
 void VL_SFORMAT_X(int obits, void* destp, const char* formatp, ...) VL_MT_SAFE {
-    static VL_THREAD_LOCAL std::string t_output;  // static only for speed
-    t_output = "";
     va_list ap;
     va_start(ap, formatp);
-    _vl_vsformat(t_output, formatp, ap);
+    _vl_vsformat_vint(obits, destp, false, formatp, ap);
     va_end(ap);
-
-    _VL_STRING_TO_VINT(obits, destp, t_output.length(), t_output.c_str());
 }
-
 void VL_SFORMAT_X(int obits_ignored, std::string& output, const char* formatp, ...) VL_MT_SAFE {
     if (obits_ignored) {}
     output = "";
@@ -1409,38 +2045,94 @@ void VL_SFORMAT_X(int obits_ignored, std::string& output, const char* formatp, .
 }
 
 std::string VL_SFORMATF_NX(const char* formatp, ...) VL_MT_SAFE {
-    static VL_THREAD_LOCAL std::string t_output;  // static only for speed
-    t_output = "";
     va_list ap;
     va_start(ap, formatp);
-    _vl_vsformat(t_output, formatp, ap);
+    std::string output = _vl_vsformat_tmp(false, formatp, ap);
     va_end(ap);
-
-    return t_output;
+    return output;
 }
 
 void VL_WRITEF(const char* formatp, ...) VL_MT_SAFE {
-    static VL_THREAD_LOCAL std::string t_output;  // static only for speed
-    t_output = "";
     va_list ap;
     va_start(ap, formatp);
-    _vl_vsformat(t_output, formatp, ap);
+    _vl_vsformat_write(false, formatp, ap);
     va_end(ap);
-
-    VL_PRINTF_MT("%s", t_output.c_str());
 }
 
 void VL_FWRITEF(IData fpi, const char* formatp, ...) VL_MT_SAFE {
     // While threadsafe, each thread can only access different file handles
-    static VL_THREAD_LOCAL std::string t_output;  // static only for speed
-    t_output = "";
-
     va_list ap;
     va_start(ap, formatp);
-    _vl_vsformat(t_output, formatp, ap);
+    const std::string& output = _vl_vsformat_tmp(false, formatp, ap);
     va_end(ap);
 
-    VerilatedImp::fdWrite(fpi, t_output);
+    VerilatedImp::fdWrite(fpi, output);
+}
+
+// Format program versions, see VerilatedFmtProg
+
+void VL_SFORMAT_P(int obits, CData& destr, const char* progp, ...) VL_MT_SAFE {
+    va_list ap;
+    va_start(ap, progp);
+    _vl_vsformat_vint(obits, &destr, true, progp, ap);
+    va_end(ap);
+}
+void VL_SFORMAT_P(int obits, SData& destr, const char* progp, ...) VL_MT_SAFE {
+    va_list ap;
+    va_start(ap, progp);
+    _vl_vsformat_vint(obits, &destr, true, progp, ap);
+    va_end(ap);
+}
+void VL_SFORMAT_P(int obits, IData& destr, const char* progp, ...) VL_MT_SAFE {
+    va_list ap;
+    va_start(ap, progp);
+    _vl_vsformat_vint(obits, &destr, true, progp, ap);
+    va_end(ap);
+}
+void VL_SFORMAT_P(int obits, QData& destr, const char* progp, ...) VL_MT_SAFE {
+    va_list ap;
+    va_start(ap, progp);
+    _vl_vsformat_vint(obits, &destr, true, progp, ap);
+    va_end(ap);
+}
+void VL_SFORMAT_P(int obits, void* destp, const char* progp, ...) VL_MT_SAFE {
+    va_list ap;
+    va_start(ap, progp);
+    _vl_vsformat_vint(obits, destp, true, progp, ap);
+    va_end(ap);
+}
+void VL_SFORMAT_P(int obits_ignored, std::string& output, const char* progp, ...) VL_MT_SAFE {
+    if (obits_ignored) {}
+    output = "";
+    va_list ap;
+    va_start(ap, progp);
+    _vl_vsformat_run(output, progp, ap);
+    va_end(ap);
+}
+
+std::string VL_SFORMATF_P(const char* progp, ...) VL_MT_SAFE {
+    va_list ap;
+    va_start(ap, progp);
+    std::string output = _vl_vsformat_tmp(true, progp, ap);
+    va_end(ap);
+    return output;
+}
+
+void VL_WRITEF_P(const char* progp, ...) VL_MT_SAFE {
+    va_list ap;
+    va_start(ap, progp);
+    _vl_vsformat_write(true, progp, ap);
+    va_end(ap);
+}
+
+void VL_FWRITEF_P(IData fpi, const char* progp, ...) VL_MT_SAFE {
+    // While threadsafe, each thread can only access different file handles
+    va_list ap;
+    va_start(ap, progp);
+    const std::string& output = _vl_vsformat_tmp(true, progp, ap);
+    va_end(ap);
+
+    VerilatedImp::fdWrite(fpi, output);
 }
 
 IData VL_FSCANF_IX(IData fpi, const char* formatp, ...) VL_MT_SAFE {
@@ -1768,6 +2460,12 @@ const char* vl_dumpctl_filenamep(bool setit, const std::string& filename) VL_MT_
 
 //===========================================================================
 // Readmem/writemem
+//
+// Memory files are mapped (or read whole) and parsed in place; values are
+// converted straight into the destination without intermediate strings.
+// Large plain files are split on line boundaries and loaded by several
+// threads.  A file starting with VL_READMEM_IMAGE_MAGIC is instead a binary
+// image of rows in Verilator's own layout, loaded with a single copy.
 
 static const char* memhFormat(int nBits) {
     assert((nBits >= 1) && (nBits <= 32));
@@ -1799,6 +2497,140 @@ static const char* formatBinary(int nBits, vluint32_t bits) {
     return t_buf;
 }
 
+#ifndef VL_READMEM_CHUNK_BYTES
+/// Minimum bytes per thread when loading large $readmem files in chunks
+# define VL_READMEM_CHUNK_BYTES (16 * 1024 * 1024)
+#endif
+
+/// First bytes of a $readmem binary image
+static const char VL_READMEM_IMAGE_MAGIC[8] = {'V', 'L', 'M', 'E', 'M', 'I', 'M', 'G'};
+
+/// Header of a $readmem binary image, followed by rows in host byte order
+struct VlReadMemImageHeader final {
+    char m_magic[8];  // VL_READMEM_IMAGE_MAGIC
+    vluint32_t m_version;  // Format version, 1
+    vluint32_t m_bits;  // Width of each row
+    vluint64_t m_addr;  // Address of first row
+    vluint64_t m_rows;  // Number of rows
+};
+
+// Character classes for $readmem parsing
+constexpr vluint8_t VL_READMEM_DIGIT_X = 16;  // x or X digit
+constexpr vluint8_t VL_READMEM_DIGIT_UNDER = 17;  // _ within a number
+constexpr vluint8_t VL_READMEM_DIGIT_NONE = 0xff;  // Not part of a number
+
+static const vluint8_t* _vl_readmem_digits() VL_MT_SAFE {
+    // Value of each hex digit character, else VL_READMEM_DIGIT_*
+    static vluint8_t s_digits[256];
+    static const bool s_init VL_ATTR_UNUSED = []() {
+        for (int c = 0; c < 256; ++c) s_digits[c] = VL_READMEM_DIGIT_NONE;
+        for (int c = '0'; c <= '9'; ++c) s_digits[c] = c - '0';
+        for (int c = 'a'; c <= 'f'; ++c) s_digits[c] = c - 'a' + 10;
+        for (int c = 'A'; c <= 'F'; ++c) s_digits[c] = c - 'A' + 10;
+        s_digits['x'] = s_digits['X'] = VL_READMEM_DIGIT_X;
+        s_digits['_'] = VL_READMEM_DIGIT_UNDER;
+        return true;
+    }();
+    return s_digits;
+}
+
+// Flags of a value's characters, from _vl_readmem_value_end
+constexpr int VL_READMEM_VALUE_NONBIN = 1;  // Has hex digits other than 0 or 1
+constexpr int VL_READMEM_VALUE_X = 2;  // Has x digits
+constexpr int VL_READMEM_VALUE_UNDER = 4;  // Has _ characters
+
+#ifdef VL_HAVE_SSE2
+// Mask of which of 16 characters may be part of a value: hex digits, x or _.
+// Also masks of the hex digits other than 0 or 1, of x digits, and of _.
+static inline int _vl_readmem_sse2_classify(const char* cp, int& nonBinr, int& xr,
+                                            int& underr) VL_PURE {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cp));
+    // Setting bit 5 folds upper case letters to lower case; digits keep their
+    // value, and characters from 0x80 compare as negative so match nothing
+    const __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+    const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)),
+                                        _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+    const __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                         _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+    const __m128i x = _mm_cmpeq_epi8(lower, _mm_set1_epi8('x'));
+    const __m128i under = _mm_cmpeq_epi8(v, _mm_set1_epi8('_'));
+    const __m128i nonbin
+        = _mm_or_si128(letter, _mm_and_si128(digit, _mm_cmpgt_epi8(v, _mm_set1_epi8('1'))));
+    nonBinr = _mm_movemask_epi8(nonbin);
+    xr = _mm_movemask_epi8(x);
+    underr = _mm_movemask_epi8(under);
+    return _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(digit, letter), _mm_or_si128(x, under)));
+}
+
+// Value of the first len (1 to 16) characters at cp, which are hex digits
+// without x or _; reads 16 characters
+static inline QData _vl_readmem_sse2_hex(const char* cp, int len) VL_PURE {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cp));
+    // Letters have bit 6 set, and their low nibble is 9 less than their value
+    const __m128i letter = _mm_srli_epi16(_mm_and_si128(v, _mm_set1_epi8(0x40)), 6);
+    __m128i nibbles = _mm_add_epi8(_mm_and_si128(v, _mm_set1_epi8(0x0f)),
+                                   _mm_add_epi8(_mm_slli_epi16(letter, 3), letter));
+    const __m128i index = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    nibbles = _mm_and_si128(nibbles, _mm_cmplt_epi8(index, _mm_set1_epi8(len)));
+    // Combine each pair of digits into a byte, first digit in the upper nibble
+    const __m128i bytes
+        = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0xff)), 4),
+                       _mm_srli_epi16(nibbles, 8));
+    QData value;
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(&value),
+                     _mm_packus_epi16(bytes, _mm_setzero_si128()));
+    // First digit is most significant, so reverse the bytes
+    return __builtin_bswap64(value) >> (4 * (16 - len));
+}
+#endif
+
+// Return the end of the value starting at cp, the first character that is
+// not a hex digit, x or _, and set flagsr to its VL_READMEM_VALUE_* flags
+static const char* _vl_readmem_value_end(const char* cp, const char* endp,
+                                         int& flagsr) VL_MT_SAFE {
+    int flags = 0;
+#ifdef VL_HAVE_SSE2
+    while (endp - cp >= 16) {
+        int nonBin;
+        int x;
+        int under;
+        const int mask = _vl_readmem_sse2_classify(cp, nonBin /*ref*/, x /*ref*/, under /*ref*/);
+        const int len = mask == 0xffff ? 16 : __builtin_ctz(~mask);
+        const int inValue = (1 << len) - 1;
+        if (nonBin & inValue) flags |= VL_READMEM_VALUE_NONBIN;
+        if (x & inValue) flags |= VL_READMEM_VALUE_X;
+        if (under & inValue) flags |= VL_READMEM_VALUE_UNDER;
+        cp += len;
+        if (len < 16) {
+            flagsr = flags;
+            return cp;
+        }
+    }
+#endif
+    const vluint8_t* const digitsp = _vl_readmem_digits();
+    for (; cp < endp; ++cp) {
+        const vluint8_t digit = digitsp[static_cast<unsigned char>(*cp)];
+        if (digit > VL_READMEM_DIGIT_UNDER) break;
+        if (digit == VL_READMEM_DIGIT_X) {
+            flags |= VL_READMEM_VALUE_X;
+        } else if (digit == VL_READMEM_DIGIT_UNDER) {
+            flags |= VL_READMEM_VALUE_UNDER;
+        } else if (digit > 1) {
+            flags |= VL_READMEM_VALUE_NONBIN;
+        }
+    }
+    flagsr = flags;
+    return cp;
+}
+
+static size_t _vl_readmem_row_bytes(int bits) VL_PURE {
+    if (bits <= 8) return sizeof(CData);
+    if (bits <= 16) return sizeof(SData);
+    if (bits <= VL_IDATASIZE) return sizeof(IData);
+    if (bits <= VL_QUADSIZE) return sizeof(QData);
+    return VL_WORDS_I(bits) * sizeof(EData);
+}
+
 VlReadMem::VlReadMem(bool hex, int bits, const std::string& filename, QData start, QData end)
     : m_hex{hex}
     , m_bits{bits}
@@ -1806,46 +2638,132 @@ VlReadMem::VlReadMem(bool hex, int bits, const std::string& filename, QData star
     , m_end{end}
     , m_addr{start}
     , m_linenum{0} {
-    m_fp = fopen(filename.c_str(), "r");
-    if (VL_UNLIKELY(!m_fp)) {
+    FILE* const fp = fopen(filename.c_str(), "rb");
+    if (VL_UNLIKELY(!fp)) {
         // We don't report the Verilog source filename as it slow to have to pass it down
         VL_FATAL_MT(filename.c_str(), 0, "", "$readmem file not found");
-        // cppcheck-suppress resourceLeak  // m_fp is nullptr - bug in cppcheck
+        // cppcheck-suppress resourceLeak  // fp is nullptr - bug in cppcheck
         return;
     }
+#if !defined(_WIN32) || defined(__CYGWIN__)
+    struct stat st;
+    if (fstat(fileno(fp), &st) == 0 && st.st_size > 0) {
+        m_mapSize = st.st_size;
+        void* const mapp = mmap(nullptr, m_mapSize, PROT_READ, MAP_PRIVATE, fileno(fp), 0);
+        if (mapp != MAP_FAILED) {
+            madvise(mapp, m_mapSize, MADV_SEQUENTIAL);
+            m_mapp = static_cast<char*>(mapp);
+            m_mapped = true;
+        }
+    }
+#endif
+    if (!m_mapped) {
+        // Can't map, so read the whole file instead
+        std::string contents;
+        char buf[64 * 1024];
+        for (size_t got; (got = fread(buf, 1, sizeof(buf), fp)) > 0;) contents.append(buf, got);
+        m_mapSize = contents.size();
+        m_mapp = new char[m_mapSize + 1];
+        memcpy(m_mapp, contents.data(), m_mapSize);
+    }
+    fclose(fp);
+    m_cp = m_mapp;
+    m_endp = m_mapp + m_mapSize;
+
+    VlReadMemImageHeader header;
+    if (m_mapSize >= sizeof(header)
+        && 0 == memcmp(m_mapp, VL_READMEM_IMAGE_MAGIC, sizeof(VL_READMEM_IMAGE_MAGIC))) {
+        memcpy(&header, m_mapp, sizeof(header));
+        m_imageRowBytes = rowBytes();
+        m_cp += sizeof(header);
+        if (VL_UNLIKELY(header.m_version != 1)) {
+            VL_FATAL_MT(filename.c_str(), 0, "", "$readmem binary image has unknown version");
+            m_endp = m_cp;
+        } else if (VL_UNLIKELY(header.m_bits != static_cast<vluint32_t>(m_bits))) {
+            VL_FATAL_MT(filename.c_str(), 0, "",
+                        "$readmem binary image width does not match memory width");
+            m_endp = m_cp;
+        } else if (VL_UNLIKELY(header.m_rows > (m_mapSize - sizeof(header)) / m_imageRowBytes)) {
+            VL_FATAL_MT(filename.c_str(), 0, "", "$readmem binary image is truncated");
+            m_endp = m_cp;
+        } else if (VL_UNLIKELY(header.m_rows
+                               && (header.m_addr < start
+                                   || header.m_addr + (header.m_rows - 1) > end))) {
+            // The image address acts as an @ address in the file, so must be
+            // within the start and end addresses given to $readmem
+            VL_FATAL_MT(filename.c_str(), 0, "",
+                        "$readmem binary image address outside specified address range"
+                        " (IEEE 2017 21.4)");
+            m_endp = m_cp;
+        } else {
+            m_endp = m_cp + header.m_rows * m_imageRowBytes;
+            if (header.m_rows) m_addr = header.m_addr;
+        }
+    }
 }
+VlReadMem::VlReadMem(const VlReadMem& parent, const char* beginp, const char* endp, QData addr,
+                     int linenum)
+    : m_hex{parent.m_hex}
+    , m_bits{parent.m_bits}
+    , m_filename(parent.m_filename)  // Need () or GCC 4.8 false warning
+    , m_end{~0ULL}
+    , m_addr{addr}
+    , m_linenum{linenum}
+    , m_cp{beginp}
+    , m_endp{endp} {}
 VlReadMem::~VlReadMem() {
-    if (m_fp) {
-        fclose(m_fp);
-        m_fp = nullptr;
+#if !defined(_WIN32) || defined(__CYGWIN__)
+    if (m_mapped) munmap(m_mapp, m_mapSize);
+#endif
+    if (!m_mapped) delete[] m_mapp;
+    m_mapp = nullptr;
+}
+size_t VlReadMem::rowBytes() const { return _vl_readmem_row_bytes(m_bits); }
+void VlReadMem::maskRow(void* valuep) const {
+    // Binary image rows may have bits set above the width, which must read as zero
+    if (m_bits <= 8) {
+        *reinterpret_cast<CData*>(valuep) &= VL_MASK_I(m_bits);
+    } else if (m_bits <= 16) {
+        *reinterpret_cast<SData*>(valuep) &= VL_MASK_I(m_bits);
+    } else if (m_bits <= VL_IDATASIZE) {
+        *reinterpret_cast<IData*>(valuep) &= VL_MASK_I(m_bits);
+    } else if (m_bits <= VL_QUADSIZE) {
+        *reinterpret_cast<QData*>(valuep) &= VL_MASK_Q(m_bits);
+    } else {
+        reinterpret_cast<WDataOutP>(valuep)[VL_WORDS_I(m_bits) - 1] &= VL_MASK_E(m_bits);
+    }
+}
+void VlReadMem::checkEnd() {
+    if (VL_UNLIKELY(m_end != ~0ULL && m_addr <= m_end)) {
+        VL_FATAL_MT(m_filename.c_str(), m_linenum, "",
+                    "$readmem file ended before specified final address (IEEE 2017 21.4)");
     }
 }
-bool VlReadMem::get(QData& addrr, std::string& valuer) {
-    if (VL_UNLIKELY(!m_fp)) return false;
-    valuer = "";
+bool VlReadMem::next(QData& addrr) {
+    if (VL_UNLIKELY(!m_cp)) return false;
+    if (m_imageRowBytes) {
+        if (m_cp >= m_endp) {
+            checkEnd();
+            return false;
+        }
+        m_valuep = m_cp;
+        m_cp += m_imageRowBytes;
+        addrr = m_addr;
+        ++m_addr;
+        return true;
+    }
+    const vluint8_t* const digitsp = _vl_readmem_digits();
     // Prep for reading
-    bool indata = false;
     bool ignore_to_eol = false;
     bool ignore_to_cmt = false;
     bool reading_addr = false;
     int lastc = ' ';
-    // Read the data
-    // We process a character at a time, as then we don't need to deal
-    // with changing buffer sizes dynamically, etc.
-    while (true) {
-        int c = fgetc(m_fp);
-        if (VL_UNLIKELY(c == EOF)) break;
-        // printf("%d: Got '%c' Addr%lx IN%d IgE%d IgC%d\n",
-        //        m_linenum, c, m_addr, indata, ignore_to_eol, ignore_to_cmt);
-        // See if previous data value has completed, and if so return
-        if (c == '_') continue;  // Ignore _ e.g. inside a number
-        if (indata && !isxdigit(c) && c != 'x' && c != 'X') {
-            // printf("Got data @%lx = %s\n", m_addr, valuer.c_str());
-            ungetc(c, m_fp);
-            addrr = m_addr;
-            ++m_addr;
-            return true;
-        }
+    const char* cp = m_cp;
+    const char* const endp = m_endp;
+    while (cp < endp) {
+        const int c = static_cast<unsigned char>(*cp++);
+        const vluint8_t digit = digitsp[c];
+        if (digit == VL_READMEM_DIGIT_UNDER) continue;  // Ignore _ e.g. inside a number
         // Parse line
         if (c == '\n') {
             ++m_linenum;
@@ -1871,94 +2789,345 @@ bool VlReadMem::get(QData& addrr, std::string& valuer) {
                 m_addr = 0;
             }
             // Check for hex or binary digits as file format requests
-            else if (isxdigit(c) || (!reading_addr && (c == 'x' || c == 'X'))) {
-                c = tolower(c);
-                int value
-                    = (c >= 'a' ? (c == 'x' ? VL_RAND_RESET_I(4) : (c - 'a' + 10)) : (c - '0'));
-                if (reading_addr) {
-                    // Decode @ addresses
-                    m_addr = (m_addr << 4) + value;
-                } else {
-                    indata = true;
-                    valuer += static_cast<char>(c);
-                    // printf(" Value width=%d  @%x = %c\n", width, m_addr, c);
-                    if (VL_UNLIKELY(value > 1 && !m_hex)) {
-                        VL_FATAL_MT(m_filename.c_str(), m_linenum, "",
-                                    "$readmemb (binary) file contains hex characters");
-                    }
+            else if (digit < 16 && reading_addr) {
+                // Decode @ addresses
+                m_addr = (m_addr << 4) + digit;
+            } else if (digit <= VL_READMEM_DIGIT_X && !reading_addr) {
+                // Value continues until a non-digit, which is parsed on the next call
+                m_valuep = cp - 1;
+                int flags;
+                cp = _vl_readmem_value_end(m_valuep, endp, flags /*ref*/);
+                if (VL_UNLIKELY((flags & VL_READMEM_VALUE_NONBIN) && !m_hex)) {
+                    VL_FATAL_MT(m_filename.c_str(), m_linenum, "",
+                                "$readmemb (binary) file contains hex characters");
                 }
+                m_valuePlain = !(flags & (VL_READMEM_VALUE_X | VL_READMEM_VALUE_UNDER));
+                m_valueEndp = cp;
+                m_cp = cp;
+                addrr = m_addr;
+                ++m_addr;
+                return true;
             } else {
                 VL_FATAL_MT(m_filename.c_str(), m_linenum, "", "$readmem file syntax error");
             }
         }
         lastc = c;
     }
-
-    if (VL_UNLIKELY(m_end != ~0ULL && m_addr <= m_end)) {
-        VL_FATAL_MT(m_filename.c_str(), m_linenum, "",
-                    "$readmem file ended before specified final address (IEEE 2017 21.4)");
-    }
-
+    m_cp = cp;
+    checkEnd();
     return false;  // EOF
 }
-void VlReadMem::setData(void* valuep, const std::string& rhs) {
-    QData shift = m_hex ? 4ULL : 1ULL;
-    bool innum = false;
-    // Shift value in
-    for (const auto& i : rhs) {
-        char c = tolower(i);
-        int value = (c >= 'a' ? (c == 'x' ? VL_RAND_RESET_I(4) : (c - 'a' + 10)) : (c - '0'));
+void VlReadMem::setNext(void* valuep) {
+    if (m_imageRowBytes) {
+        memcpy(valuep, m_valuep, m_imageRowBytes);
+        maskRow(valuep);
+        return;
+    }
+    const vluint8_t* const digitsp = _vl_readmem_digits();
+    const int shift = m_hex ? 4 : 1;
+#ifdef VL_HAVE_SSE2
+    // Plain hex digits convert 16 at a time, when 16 characters may be read
+    const bool simd = m_hex && m_valuePlain && m_endp - m_valuep >= 16;
+#endif
+    if (m_bits <= VL_QUADSIZE) {
+        // Shift value in; bits beyond the width fall off the top
+        QData value = 0;
+        const char* cp = m_valuep;
+#ifdef VL_HAVE_SSE2
+        if (simd) {
+            const int len = static_cast<int>(m_valueEndp - m_valuep);
+            // Only the last 16 digits can be within the width
+            cp = len > 16 ? m_valueEndp - 16 : m_valueEndp;
+            value = _vl_readmem_sse2_hex(len > 16 ? cp : m_valuep, std::min(len, 16));
+        }
+#endif
+        for (; cp < m_valueEndp; ++cp) {
+            const vluint8_t digit = digitsp[static_cast<unsigned char>(*cp)];
+            if (VL_UNLIKELY(digit >= VL_READMEM_DIGIT_X)) {
+                if (digit == VL_READMEM_DIGIT_UNDER) continue;
+                value = (value << shift) | VL_RAND_RESET_I(shift);
+            } else {
+                value = (value << shift) | digit;
+            }
+        }
         if (m_bits <= 8) {
-            CData* datap = reinterpret_cast<CData*>(valuep);
-            if (!innum) { *datap = 0; }
-            *datap = ((*datap << shift) + value) & VL_MASK_I(m_bits);
+            *reinterpret_cast<CData*>(valuep) = value & VL_MASK_I(m_bits);
         } else if (m_bits <= 16) {
-            SData* datap = reinterpret_cast<SData*>(valuep);
-            if (!innum) { *datap = 0; }
-            *datap = ((*datap << shift) + value) & VL_MASK_I(m_bits);
+            *reinterpret_cast<SData*>(valuep) = value & VL_MASK_I(m_bits);
         } else if (m_bits <= VL_IDATASIZE) {
-            IData* datap = reinterpret_cast<IData*>(valuep);
-            if (!innum) { *datap = 0; }
-            *datap = ((*datap << shift) + value) & VL_MASK_I(m_bits);
-        } else if (m_bits <= VL_QUADSIZE) {
-            QData* datap = reinterpret_cast<QData*>(valuep);
-            if (!innum) { *datap = 0; }
-            *datap = ((*datap << static_cast<QData>(shift)) + static_cast<QData>(value))
-                     & VL_MASK_Q(m_bits);
+            *reinterpret_cast<IData*>(valuep) = value & VL_MASK_I(m_bits);
+        } else {
+            *reinterpret_cast<QData*>(valuep) = value & VL_MASK_Q(m_bits);
+        }
+    } else {
+        // Place digits from the least significant end; digits never straddle words
+        WDataOutP datap = reinterpret_cast<WDataOutP>(valuep);
+        VL_ZERO_RESET_W(m_bits, datap);
+        const int words = VL_WORDS_I(m_bits);
+        int lsb = 0;
+        const char* cp = m_valueEndp;
+#ifdef VL_HAVE_SSE2
+        // Each 16 digits fill two words
+        for (; simd && cp > m_valuep && lsb < words * VL_EDATASIZE; lsb += VL_QUADSIZE) {
+            const int len = static_cast<int>(std::min<ptrdiff_t>(cp - m_valuep, 16));
+            cp -= len;
+            const QData value = _vl_readmem_sse2_hex(cp, len);
+            datap[VL_BITWORD_E(lsb)] = static_cast<EData>(value);
+            if (VL_BITWORD_E(lsb) + 1 < words) {
+                datap[VL_BITWORD_E(lsb) + 1] = static_cast<EData>(value >> VL_EDATASIZE);
+            }
+        }
+#endif
+        while (cp > m_valuep && lsb < words * VL_EDATASIZE) {
+            const vluint8_t digit = digitsp[static_cast<unsigned char>(*--cp)];
+            if (digit == VL_READMEM_DIGIT_UNDER) continue;
+            const EData value = digit == VL_READMEM_DIGIT_X ? VL_RAND_RESET_I(shift) : digit;
+            datap[VL_BITWORD_E(lsb)] |= value << VL_BITBIT_E(lsb);
+            lsb += shift;
+        }
+        datap[words - 1] &= VL_MASK_E(m_bits);
+    }
+}
+void VlReadMem::fill(QData depth, int array_lsb, void* memp) {
+    const QData lo = static_cast<QData>(array_lsb);
+    const QData hi = lo + depth;
+    const size_t rowbytes = rowBytes();
+    if (m_imageRowBytes) {
+        // Binary image: rows are already in memory layout
+        const QData rows = (m_endp - m_cp) / rowbytes;
+        if (rows) {
+            if (VL_UNLIKELY(m_addr < lo || m_addr >= hi || rows > hi - m_addr)) {
+                VL_FATAL_MT(m_filename.c_str(), m_linenum, "",
+                            "$readmem file address beyond bounds of array");
+                return;
+            }
+            char* const rowsp = static_cast<char*>(memp) + (m_addr - lo) * rowbytes;
+            memcpy(rowsp, m_cp, rows * rowbytes);
+            for (QData row = 0; row < rows; ++row) maskRow(rowsp + row * rowbytes);
+        }
+        m_cp = m_endp;
+        m_addr += rows;
+        checkEnd();
+        return;
+    }
+#ifdef VL_THREADED
+    if (fillChunked(depth, array_lsb, memp)) return;
+#endif
+    QData addr = 0;
+    while (next(addr /*ref*/)) {
+        if (VL_UNLIKELY(addr < lo || addr >= hi)) {
+            VL_FATAL_MT(m_filename.c_str(), m_linenum, "",
+                        "$readmem file address beyond bounds of array");
         } else {
-            WDataOutP datap = reinterpret_cast<WDataOutP>(valuep);
-            if (!innum) VL_ZERO_RESET_W(m_bits, datap);
-            _VL_SHIFTL_INPLACE_W(m_bits, datap, static_cast<IData>(shift));
-            datap[0] |= value;
+            setNext(static_cast<char*>(memp) + (addr - lo) * rowbytes);
+        }
+    }
+}
+
+#ifdef VL_THREADED
+/// Summary of a chunk of a $readmem file, from _vl_readmem_scan
+struct VlReadMemChunk final {
+    bool m_simple = true;  // Only values, whitespace, // comments and addresses
+    bool m_hasAddr = false;  // Contains an @ address
+    QData m_values = 0;  // Values before first @ address
+    QData m_endAddr = 0;  // If m_hasAddr, address after last value
+    QData m_minAddr = ~0ULL;  // Lowest address of values after an @ address
+    QData m_maxAddr = 0;  // Highest address of values after an @ address
+    int m_lines = 0;  // Newlines in chunk
+};
+
+static VlReadMemChunk _vl_readmem_scan(const char* cp, const char* endp, bool hex) VL_MT_SAFE {
+    // Count the values and addresses in a chunk without storing them.  Anything
+    // unusual (/* comments, x digits, errors) is left for the serial parse.
+    const vluint8_t* const digitsp = _vl_readmem_digits();
+    VlReadMemChunk chunk;
+    bool reading_addr = false;
+    QData addr = 0;
+    QData values = 0;
+    const auto endAddrs = [&]() {
+        if (!chunk.m_hasAddr) {
+            chunk.m_values = values;
+        } else if (values) {
+            chunk.m_minAddr = std::min(chunk.m_minAddr, addr);
+            chunk.m_maxAddr = std::max(chunk.m_maxAddr, addr + values - 1);
+        }
+    };
+    while (cp < endp) {
+        const int c = static_cast<unsigned char>(*cp++);
+        const vluint8_t digit = digitsp[c];
+        if (digit < 16) {
+            if (reading_addr) {
+                addr = (addr << 4) + digit;
+                continue;
+            }
+            int flags;
+            cp = _vl_readmem_value_end(cp - 1, endp, flags /*ref*/);
+            if (VL_UNLIKELY((flags & VL_READMEM_VALUE_X)
+                            || ((flags & VL_READMEM_VALUE_NONBIN) && !hex))) {
+                chunk.m_simple = false;
+                return chunk;
+            }
+            ++values;
+        } else if (digit == VL_READMEM_DIGIT_UNDER) {
+        } else if (c == '\n') {
+            ++chunk.m_lines;
+            reading_addr = false;
+        } else if (c == '\t' || c == ' ' || c == '\r' || c == '\f') {
+            reading_addr = false;
+        } else if (c == '@') {
+            endAddrs();
+            chunk.m_hasAddr = true;
+            reading_addr = true;
+            addr = 0;
+            values = 0;
+        } else if (c == '#' || (c == '/' && cp < endp && *cp == '/')) {
+            const void* const eolp = memchr(cp, '\n', endp - cp);
+            cp = eolp ? static_cast<const char*>(eolp) : endp;
+        } else {
+            chunk.m_simple = false;
+            return chunk;
+        }
+    }
+    endAddrs();
+    chunk.m_endAddr = addr + values;
+    return chunk;
+}
+
+bool VlReadMem::fillChunked(QData depth, int array_lsb, void* memp) {
+    // Split large files on line boundaries, count each chunk's values in
+    // parallel, then with each chunk's starting address known parse in parallel.
+    const size_t size = m_endp - m_cp;
+    const size_t threads = std::min<size_t>(std::thread::hardware_concurrency(),
+                                            size / VL_READMEM_CHUNK_BYTES);
+    if (threads < 2) return false;
+    std::vector<const char*> bounds;
+    bounds.push_back(m_cp);
+    for (size_t i = 1; i < threads; ++i) {
+        const char* cp = std::max(bounds.back(), m_cp + size / threads * i);
+        const void* const eolp = memchr(cp, '\n', m_endp - cp);
+        bounds.push_back(eolp ? static_cast<const char*>(eolp) + 1 : m_endp);
+    }
+    bounds.push_back(m_endp);
+    const auto runChunks = [threads](const std::function<void(size_t)>& func) {
+        std::vector<std::thread> workers;
+        for (size_t i = 1; i < threads; ++i) workers.emplace_back(func, i);
+        func(0);
+        for (auto& worker : workers) worker.join();
+    };
+
+    std::vector<VlReadMemChunk> chunks(threads);
+    runChunks([&](size_t i) { chunks[i] = _vl_readmem_scan(bounds[i], bounds[i + 1], m_hex); });
+    std::vector<QData> addrs(threads);
+    std::vector<int> linenums(threads);
+    QData addr = m_addr;
+    int linenum = m_linenum;
+    for (size_t i = 0; i < threads; ++i) {
+        if (!chunks[i].m_simple) return false;
+        addrs[i] = addr;
+        linenums[i] = linenum;
+        if (chunks[i].m_values) {
+            chunks[i].m_minAddr = std::min(chunks[i].m_minAddr, addr);
+            chunks[i].m_maxAddr = std::max(chunks[i].m_maxAddr, addr + chunks[i].m_values - 1);
+        }
+        addr = chunks[i].m_hasAddr ? chunks[i].m_endAddr : addr + chunks[i].m_values;
+        linenum += chunks[i].m_lines;
+    }
+    // Chunks writing the same rows must be loaded in order, so serially
+    for (size_t i = 0; i < threads; ++i) {
+        for (size_t j = i + 1; j < threads; ++j) {
+            if (chunks[i].m_minAddr <= chunks[j].m_maxAddr
+                && chunks[j].m_minAddr <= chunks[i].m_maxAddr) {
+                return false;
+            }
         }
-        innum = true;
     }
+
+    const QData lo = static_cast<QData>(array_lsb);
+    const QData hi = lo + depth;
+    const size_t rowbytes = rowBytes();
+    std::atomic<bool> outOfBounds{false};
+    runChunks([&](size_t i) {
+        VlReadMem view{*this, bounds[i], bounds[i + 1], addrs[i], linenums[i]};
+        QData vaddr = 0;
+        while (view.next(vaddr /*ref*/)) {
+            if (VL_UNLIKELY(vaddr < lo || vaddr >= hi)) {
+                outOfBounds = true;
+                break;
+            }
+            view.setNext(static_cast<char*>(memp) + (vaddr - lo) * rowbytes);
+        }
+    });
+    // Reparse serially to report the error with its line number
+    if (VL_UNLIKELY(outOfBounds)) return false;
+    m_cp = m_endp;
+    m_addr = addr;
+    m_linenum = linenum;
+    checkEnd();
+    return true;
 }
+#endif
 
 VlWriteMem::VlWriteMem(bool hex, int bits, const std::string& filename, QData start, QData end)
     : m_hex{hex}
     , m_bits{bits}
-    , m_addr{0} {
+    , m_fp{nullptr}
+    , m_addr{0}
+    , m_filename{filename} {
     if (VL_UNLIKELY(start > end)) {
         VL_FATAL_MT(filename.c_str(), 0, "", "$writemem invalid address range");
         return;
     }
 
-    m_fp = fopen(filename.c_str(), "w");
+    // Filenames ending in .vlmem get a binary image that $readmem loads by copying
+    static const std::string imageSuffix = ".vlmem";
+    if (filename.size() > imageSuffix.size()
+        && 0 == filename.compare(filename.size() - imageSuffix.size(), imageSuffix.size(),
+                                 imageSuffix)) {
+        m_imageRowBytes = _vl_readmem_row_bytes(bits);
+    }
+    m_fp = fopen(filename.c_str(), m_imageRowBytes ? "wb" : "w");
     if (VL_UNLIKELY(!m_fp)) {
         VL_FATAL_MT(filename.c_str(), 0, "", "$writemem file not found");
         // cppcheck-suppress resourceLeak  // m_fp is nullptr - bug in cppcheck
         return;
     }
+    if (m_imageRowBytes) {
+        // Header is rewritten with the row count when closing
+        const VlReadMemImageHeader header{};
+        fwrite(&header, sizeof(header), 1, m_fp);
+    }
 }
 VlWriteMem::~VlWriteMem() {
     if (m_fp) {
+        if (m_imageRowBytes) {
+            VlReadMemImageHeader header;
+            memcpy(header.m_magic, VL_READMEM_IMAGE_MAGIC, sizeof(header.m_magic));
+            header.m_version = 1;
+            header.m_bits = m_bits;
+            header.m_addr = m_imageAddr;
+            header.m_rows = m_imageRows;
+            fseek(m_fp, 0, SEEK_SET);
+            fwrite(&header, sizeof(header), 1, m_fp);
+        }
         fclose(m_fp);
         m_fp = nullptr;
     }
 }
 void VlWriteMem::print(QData addr, bool addrstamp, const void* valuep) {
     if (VL_UNLIKELY(!m_fp)) return;
+    if (m_imageRowBytes) {
+        if (!m_imageRows) {
+            m_imageAddr = addr;
+        } else if (VL_UNLIKELY(addr != m_addr)) {
+            VL_FATAL_MT(m_filename.c_str(), 0, "",
+                        "$writemem binary image requires contiguous addresses");
+            return;
+        }
+        m_addr = addr + 1;
+        ++m_imageRows;
+        fwrite(valuep, m_imageRowBytes, 1, m_fp);
+        return;
+    }
     if (addr != m_addr && addrstamp) {  // Only assoc has time stamps
         fprintf(m_fp, "@%" VL_PRI64 "x\n", addr);
     }
@@ -2044,38 +3213,7 @@ void VL_READMEM_N(bool hex,  // Hex format, else binary
 
     VlReadMem rmem(hex, bits, filename, start, end);
     if (VL_UNLIKELY(!rmem.isOpen())) return;
-    while (true) {
-        QData addr = 0;
-        std::string value;
-        if (rmem.get(addr /*ref*/, value /*ref*/)) {
-            if (VL_UNLIKELY(addr < static_cast<QData>(array_lsb)
-                            || addr >= static_cast<QData>(array_lsb + depth))) {
-                VL_FATAL_MT(filename.c_str(), rmem.linenum(), "",
-                            "$readmem file address beyond bounds of array");
-            } else {
-                QData entry = addr - array_lsb;
-                if (bits <= 8) {
-                    CData* datap = &(reinterpret_cast<CData*>(memp))[entry];
-                    rmem.setData(datap, value);
-                } else if (bits <= 16) {
-                    SData* datap = &(reinterpret_cast<SData*>(memp))[entry];
-                    rmem.setData(datap, value);
-                } else if (bits <= VL_IDATASIZE) {
-                    IData* datap = &(reinterpret_cast<IData*>(memp))[entry];
-                    rmem.setData(datap, value);
-                } else if (bits <= VL_QUADSIZE) {
-                    QData* datap = &(reinterpret_cast<QData*>(memp))[entry];
-                    rmem.setData(datap, value);
-                } else {
-                    WDataOutP datap
-                        = &(reinterpret_cast<WDataOutP>(memp))[entry * VL_WORDS_I(bits)];
-                    rmem.setData(datap, value);
-                }
-            }
-        } else {
-            break;
-        }
-    }
+    rmem.fill(depth, array_lsb, memp);
 }
 
 void VL_WRITEMEM_N(bool hex,  // Hex format, else binary
@@ -2318,6 +3456,20 @@ void Verilated::timeprecision(int value) VL_MT_SAFE {
     }
 #endif
 }
+void Verilated::logAsync(bool flag) VL_MT_UNSAFE {
+#ifdef VL_THREADED
+    if (flag == s_ns.s_logAsync) return;
+    if (flag) {
+        s_ns.s_logAsync = true;
+        VerilatedLogAsync::start();
+    } else {
+        VerilatedLogAsync::stop();
+        s_ns.s_logAsync = false;
+    }
+#else
+    if (flag) {}  // Requires a writer thread
+#endif
+}
 void Verilated::profThreadsStart(vluint64_t flag) VL_MT_SAFE {
     const VerilatedLockGuard lock(s_mutex);
     s_ns.s_profThreadsStart = flag;
@@ -2331,6 +3483,31 @@ void Verilated::profThreadsFilenamep(const char* flagp) VL_MT_SAFE {
     if (s_ns.s_profThreadsFilenamep) free(const_cast<char*>(s_ns.s_profThreadsFilenamep));
     s_ns.s_profThreadsFilenamep = strdup(flagp);
 }
+void Verilated::profThreadsCounters(bool flag) VL_MT_SAFE {
+    const VerilatedLockGuard lock(s_mutex);
+    s_ns.s_profThreadsCounters = flag;
+}
+void Verilated::profThreadsJsonFilenamep(const char* flagp) VL_MT_SAFE {
+    const VerilatedLockGuard lock(s_mutex);
+    if (s_ns.s_profThreadsJsonFilenamep) {
+        free(const_cast<char*>(s_ns.s_profThreadsJsonFilenamep));
+    }
+    s_ns.s_profThreadsJsonFilenamep = (flagp && flagp[0]) ? strdup(flagp) : nullptr;
+}
+void Verilated::profSampleRate(vluint32_t flag) VL_MT_SAFE {
+    const VerilatedLockGuard lock(s_mutex);
+    s_ns.s_profSampleRate = flag;
+}
+void Verilated::profSampleFilenamep(const char* flagp) VL_MT_SAFE {
+    const VerilatedLockGuard lock(s_mutex);
+    if (s_ns.s_profSampleFilenamep) free(const_cast<char*>(s_ns.s_profSampleFilenamep));
+    s_ns.s_profSampleFilenamep = strdup(flagp);
+}
+void Verilated::profCostFilenamep(const char* flagp) VL_MT_SAFE {
+    const VerilatedLockGuard lock(s_mutex);
+    if (s_ns.s_profCostFilenamep) free(const_cast<char*>(s_ns.s_profCostFilenamep));
+    s_ns.s_profCostFilenamep = strdup(flagp);
+}
 
 const char* Verilated::catName(const char* n1, const char* n2, const char* delimiter) VL_MT_SAFE {
     // Returns new'ed data
@@ -2380,6 +3557,9 @@ void Verilated::removeFlushCb(VoidPCb cb, void* datap) VL_MT_SAFE {
     removeCb(cb, datap, s_flushCbs);
 }
 void Verilated::runFlushCallbacks() VL_MT_SAFE {
+#ifdef VL_THREADED
+    VerilatedLogAsync::flush();
+#endif
     const VerilatedLockGuard lock(s_mutex);
     runCallbacks(s_flushCbs);
     fflush(stderr);
@@ -2476,6 +3656,7 @@ void Verilated::endOfThreadMTaskGuts(VerilatedEvalMsgQueue* evalMsgQp) VL_MT_SAF
 void Verilated::endOfEvalGuts(VerilatedEvalMsgQueue* evalMsgQp) VL_MT_SAFE {
     VL_DEBUG_IF(VL_DBG_MSGF("End-of-eval cleanup\n"););
     evalMsgQp->process();
+    if (VL_UNLIKELY(logAsync())) VerilatedLogAsync::nextEpoch();
 }
 #endif
 
@@ -2561,6 +3742,18 @@ void VerilatedImp::commandArgVl(const std::string& arg) {
             VL_PRINTF_MT("For help, please see 'verilator --help'\n");
             VL_FATAL_MT("COMMAND_LINE", 0, "",
                         "Exiting due to command line argument (not an error)");
+        } else if (arg == "+verilator+log+async") {
+            Verilated::logAsync(true);
+        } else if (commandArgVlValue(arg, "+verilator+prof+cost+file+", value /*ref*/)) {
+            Verilated::profCostFilenamep(value.c_str());
+        } else if (commandArgVlValue(arg, "+verilator+prof+sample+file+", value /*ref*/)) {
+            Verilated::profSampleFilenamep(value.c_str());
+        } else if (commandArgVlValue(arg, "+verilator+prof+sample+rate+", value /*ref*/)) {
+            Verilated::profSampleRate(atol(value.c_str()));
+        } else if (arg == "+verilator+prof+threads+counters") {
+            Verilated::profThreadsCounters(true);
+        } else if (commandArgVlValue(arg, "+verilator+prof+threads+json+", value /*ref*/)) {
+            Verilated::profThreadsJsonFilenamep(value.c_str());
         } else if (commandArgVlValue(arg, "+verilator+prof+threads+start+", value /*ref*/)) {
             Verilated::profThreadsStart(atoll(value.c_str()));
         } else if (commandArgVlValue(arg, "+verilator+prof+threads+window+", value /*ref*/)) {
@@ -25,6 +25,7 @@
 
 // clang-format off
 #include "verilatedos.h"
+#include "verilated_intrinsics.h"
 #if VM_SC
 # include "verilated_sc.h"  // Get SYSTEMC_VERSION and time declarations
 #endif
@@ -398,8 +399,14 @@ class Verilated final {
         // Fast path
         vluint64_t s_profThreadsStart = 1;  ///< +prof+threads starting time
         vluint32_t s_profThreadsWindow = 2;  ///< +prof+threads window size
+        bool s_profThreadsCounters = false;  ///< +prof+threads hardware counters
+        vluint32_t s_profSampleRate = 1000;  ///< +prof+sample samples per second
+        bool s_logAsync = false;  ///< $display output via writer thread
         // Slow path
         const char* s_profThreadsFilenamep;  ///< +prof+threads filename
+        const char* s_profThreadsJsonFilenamep = nullptr;  ///< +prof+threads trace filename
+        const char* s_profSampleFilenamep;  ///< +prof+sample filename
+        const char* s_profCostFilenamep;  ///< +prof+cost filename
         void setup();
         void teardown();
     } s_ns;
@@ -418,6 +425,7 @@ class Verilated final {
     static VL_THREAD_LOCAL struct ThreadLocal {
 #ifdef VL_THREADED
         vluint32_t t_mtaskId = 0;  ///< Current mtask# executing on this thread
+        vluint32_t t_threadIndex = 0;  ///< Thread pool worker# + 1, or 0 if not a worker
         vluint32_t t_endOfEvalReqd
             = 0;  ///< Messages may be pending, thread needs endOf-eval calls
 #endif
@@ -501,6 +509,25 @@ public:
     static vluint32_t profThreadsWindow() VL_MT_SAFE { return s_ns.s_profThreadsWindow; }
     static void profThreadsFilenamep(const char* flagp) VL_MT_SAFE;
     static const char* profThreadsFilenamep() VL_MT_SAFE { return s_ns.s_profThreadsFilenamep; }
+    /// Also sample hardware counters per mtask (Linux perf_event)
+    static void profThreadsCounters(bool flag) VL_MT_SAFE;
+    static bool profThreadsCounters() VL_MT_SAFE { return s_ns.s_profThreadsCounters; }
+    /// Also write a Chrome trace-event JSON timeline; nullptr for none
+    static void profThreadsJsonFilenamep(const char* flagp) VL_MT_SAFE;
+    static const char* profThreadsJsonFilenamep() VL_MT_SAFE {
+        return s_ns.s_profThreadsJsonFilenamep;
+    }
+    /// --prof-sample related settings
+    static void profSampleRate(vluint32_t flag) VL_MT_SAFE;
+    static vluint32_t profSampleRate() VL_MT_SAFE { return s_ns.s_profSampleRate; }
+    static void profSampleFilenamep(const char* flagp) VL_MT_SAFE;
+    static const char* profSampleFilenamep() VL_MT_SAFE { return s_ns.s_profSampleFilenamep; }
+    /// --prof-cost related settings
+    static void profCostFilenamep(const char* flagp) VL_MT_SAFE;
+    static const char* profCostFilenamep() VL_MT_SAFE { return s_ns.s_profCostFilenamep; }
+    /// Print $display output from a separate writer thread, when VL_THREADED
+    static void logAsync(bool flag) VL_MT_UNSAFE;
+    static bool logAsync() VL_MT_SAFE { return s_ns.s_logAsync; }
 
     typedef void (*VoidPCb)(void*);  // Callback type for below
     /// Callbacks to run on global flush
@@ -583,6 +610,9 @@ public:
     /// Set the mtaskId, called when an mtask starts
     static void mtaskId(vluint32_t id) VL_MT_SAFE { t_s.t_mtaskId = id; }
     static vluint32_t mtaskId() VL_MT_SAFE { return t_s.t_mtaskId; }
+    /// Set the thread index, called when a thread pool worker starts
+    static void threadIndex(vluint32_t index) VL_MT_SAFE { t_s.t_threadIndex = index; }
+    static vluint32_t threadIndex() VL_MT_SAFE { return t_s.t_threadIndex; }
     static void endOfEvalReqdInc() VL_MT_SAFE { ++t_s.t_endOfEvalReqd; }
     static void endOfEvalReqdDec() VL_MT_SAFE { --t_s.t_endOfEvalReqd; }
 
@@ -657,8 +687,35 @@ inline IData VL_RANDOM_I(int obits) VL_MT_SAFE { return vl_rand64() & VL_MASK_I(
 inline QData VL_RANDOM_Q(int obits) VL_MT_SAFE { return vl_rand64() & VL_MASK_Q(obits); }
 extern WDataOutP VL_RANDOM_W(int obits, WDataOutP outwp);  ///< Randomize a signal
 extern IData VL_RANDOM_SEEDED_II(int obits, IData seed) VL_MT_SAFE;
-inline IData VL_URANDOM_RANGE_I(IData hi, IData lo) {
-    vluint64_t rnd = vl_rand64();
+/// Counter-based random streams (--rand-streams).  Each value depends only on
+/// the seed, the stream and the value's index in the stream, not on which
+/// thread draws it.  State is 128 bits, initialized by VL_RAND_STREAM_INIT.
+extern void VL_RAND_STREAM_INIT(WDataOutP statep, const char* scopep,
+                                vluint64_t site) VL_MT_SAFE;
+/// Initialize a class object's stream, keyed by the class and by the stream of
+/// the call site that constructed the object (see VlRandStreamParent)
+extern void VL_RAND_STREAM_INIT_OBJ(WDataOutP statep, const char* classp,
+                                    vluint64_t site) VL_MT_SAFE;
+/// For its lifetime, objects constructed on this thread key their streams on
+/// the next value of the given call site stream
+class VlRandStreamParent final {
+    vluint64_t m_prevParent;  ///< Parent of enclosing construction, restored on destruction
+public:
+    explicit VlRandStreamParent(WDataOutP statep) VL_MT_SAFE;
+    ~VlRandStreamParent();
+    VL_UNCOPYABLE(VlRandStreamParent);
+};
+extern vluint64_t vl_rand_stream64(WDataOutP statep) VL_MT_SAFE;
+/// Next count values of a stream, faster than count vl_rand_stream64 calls
+extern void vl_rand_stream_fill(WDataOutP statep, vluint64_t* outp, size_t count) VL_MT_SAFE;
+inline IData VL_RANDOM_STREAM_I(int obits, WDataOutP statep) VL_MT_SAFE {
+    return vl_rand_stream64(statep) & VL_MASK_I(obits);
+}
+inline QData VL_RANDOM_STREAM_Q(int obits, WDataOutP statep) VL_MT_SAFE {
+    return vl_rand_stream64(statep) & VL_MASK_Q(obits);
+}
+extern WDataOutP VL_RANDOM_STREAM_W(int obits, WDataOutP outwp, WDataOutP statep) VL_MT_SAFE;
+inline IData vl_urandom_range(vluint64_t rnd, IData hi, IData lo) VL_PURE {
     if (VL_LIKELY(hi > lo)) {
         // Modulus isn't very fast but it's common that hi-low is power-of-two
         return (rnd % (hi - lo + 1)) + lo;
@@ -666,11 +723,26 @@ inline IData VL_URANDOM_RANGE_I(IData hi, IData lo) {
         return (rnd % (lo - hi + 1)) + hi;
     }
 }
+inline IData VL_URANDOM_RANGE_I(IData hi, IData lo) {
+    return vl_urandom_range(vl_rand64(), hi, lo);
+}
+inline IData VL_URANDOM_RANGE_STREAM_I(IData hi, IData lo, WDataOutP statep) VL_MT_SAFE {
+    return vl_urandom_range(vl_rand_stream64(statep), hi, lo);
+}
 
 /// Init time only, so slow is fine
 extern IData VL_RAND_RESET_I(int obits);  ///< Random reset a signal
 extern QData VL_RAND_RESET_Q(int obits);  ///< Random reset a signal
 extern WDataOutP VL_RAND_RESET_W(int obits, WDataOutP outwp);  ///< Random reset a signal
+/// Random reset a contiguous array of elements, reproducibly keyed by scope and name
+extern void VL_RAND_RESET_ARRAY(int obits, vluint64_t elements, void* datap, const char* scopep,
+                                const char* namep);
+/// Key used by VL_RAND_RESET_ARRAY for the given scope and name
+extern vluint64_t VL_RAND_RESET_ARRAY_KEY(const char* scopep, const char* namep);
+/// Random reset part of an array starting at element firstElement, giving the same values
+/// VL_RAND_RESET_ARRAY would; firstElement must be a multiple of 8
+extern void VL_RAND_RESET_ARRAY_PAGE(int obits, vluint64_t elements, void* datap,
+                                     vluint64_t key, vluint64_t firstElement);
 /// Zero reset a signal (slow - else use VL_ZERO_W)
 extern WDataOutP VL_ZERO_RESET_W(int obits, WDataOutP outwp);
 
@@ -688,6 +760,7 @@ extern void VL_PRINTTIMESCALE(const char* namep, const char* timeunitp) VL_MT_SA
 /// Math
 extern WDataOutP _vl_moddiv_w(int lbits, WDataOutP owp, WDataInP lwp, WDataInP rwp,
                               bool is_modulus);
+extern WDataOutP _vl_mul_w(int words, WDataOutP owp, WDataInP lwp, WDataInP rwp);
 
 /// File I/O
 extern IData VL_FGETS_IXI(int obits, void* destp, IData fpi);
@@ -714,6 +787,17 @@ extern void VL_SFORMAT_X(int obits, IData& destr, const char* formatp, ...);
 extern void VL_SFORMAT_X(int obits, QData& destr, const char* formatp, ...);
 extern void VL_SFORMAT_X(int obits, void* destp, const char* formatp, ...);
 
+// Format programs; a constant $display-like format pre-parsed by Verilator
+// so that no format parsing happens at runtime, see verilated_fmtprog.h
+
+extern void VL_WRITEF_P(const char* progp, ...);
+extern void VL_FWRITEF_P(IData fpi, const char* progp, ...);
+extern void VL_SFORMAT_P(int obits, CData& destr, const char* progp, ...);
+extern void VL_SFORMAT_P(int obits, SData& destr, const char* progp, ...);
+extern void VL_SFORMAT_P(int obits, IData& destr, const char* progp, ...);
+extern void VL_SFORMAT_P(int obits, QData& destr, const char* progp, ...);
+extern void VL_SFORMAT_P(int obits, void* destp, const char* progp, ...);
+
 extern IData VL_SYSTEM_IW(int lhswords, WDataInP lhsp);
 extern IData VL_SYSTEM_IQ(QData lhs);
 inline IData VL_SYSTEM_II(IData lhs) VL_MT_SAFE { return VL_SYSTEM_IQ(lhs); }
@@ -905,6 +989,145 @@ double vl_time_multiplier(int scale);
 // The bits indicate the bit width of the output and each operand.
 // If wide output, a temporary storage location is specified.
 
+//===================================================================
+// VECTORIZED KERNELS
+// Wide operations of VL_SIMD_WORDS or more words use these when the
+// model is compiled with AVX2 (and optionally AVX-512F) enabled, e.g.
+// -CFLAGS -mavx2.  Define VL_PORTABLE_ONLY to use only portable code.
+
+#ifdef VL_HAVE_AVX2
+#define VL_SIMD_WORDS 8  ///< Minimum words (256 bits) for vectorized operations
+
+// clang-format off
+#ifdef VL_HAVE_AVX512
+# define _VL_SIMD_LOOP512(stmt) for (; i + 16 <= words; i += 16) { stmt; }
+#else
+# define _VL_SIMD_LOOP512(stmt)
+#endif
+// clang-format on
+
+#define _VL_LD256(p) _mm256_loadu_si256(reinterpret_cast<const __m256i*>((p) + i))
+#define _VL_ST256(p, v) _mm256_storeu_si256(reinterpret_cast<__m256i*>((p) + i), (v))
+#define _VL_LD512(p) _mm512_loadu_si512(reinterpret_cast<const void*>((p) + i))
+#define _VL_ST512(p, v) _mm512_storeu_si512(reinterpret_cast<void*>((p) + i), (v))
+
+#define _VL_SIMD_BINOP_W(name, op) \
+    static inline void name(int words, WDataOutP owp, WDataInP lwp, WDataInP rwp) VL_MT_SAFE { \
+        int i = 0; \
+        _VL_SIMD_LOOP512(_VL_ST512(owp, _mm512_##op##_si512(_VL_LD512(lwp), _VL_LD512(rwp)))); \
+        for (; i + 8 <= words; i += 8) { \
+            _VL_ST256(owp, _mm256_##op##_si256(_VL_LD256(lwp), _VL_LD256(rwp))); \
+        } \
+        for (; i < words; ++i) owp[i] = _vl_simd_##op##_e(lwp[i], rwp[i]); \
+    }
+static inline EData _vl_simd_and_e(EData l, EData r) VL_PURE { return l & r; }
+static inline EData _vl_simd_or_e(EData l, EData r) VL_PURE { return l | r; }
+static inline EData _vl_simd_xor_e(EData l, EData r) VL_PURE { return l ^ r; }
+_VL_SIMD_BINOP_W(_vl_simd_and_w, and)
+_VL_SIMD_BINOP_W(_vl_simd_or_w, or)
+_VL_SIMD_BINOP_W(_vl_simd_xor_w, xor)
+#undef _VL_SIMD_BINOP_W
+
+static inline void _vl_simd_not_w(int words, WDataOutP owp, WDataInP lwp) VL_MT_SAFE {
+    int i = 0;
+    _VL_SIMD_LOOP512(_VL_ST512(owp, _mm512_xor_si512(_VL_LD512(lwp), _mm512_set1_epi32(-1))));
+    const __m256i ones = _mm256_set1_epi32(-1);
+    for (; i + 8 <= words; i += 8) _VL_ST256(owp, _mm256_xor_si256(_VL_LD256(lwp), ones));
+    for (; i < words; ++i) owp[i] = ~lwp[i];
+}
+static inline void _vl_simd_copy_w(int words, WDataOutP owp, WDataInP lwp) VL_MT_SAFE {
+    int i = 0;
+    _VL_SIMD_LOOP512(_VL_ST512(owp, _VL_LD512(lwp)));
+    for (; i + 8 <= words; i += 8) _VL_ST256(owp, _VL_LD256(lwp));
+    for (; i < words; ++i) owp[i] = lwp[i];
+}
+
+// Reduce a vector accumulator to one word using the given bitwise operation
+#define _VL_SIMD_FOLD(op, acc512, acc256) \
+    do { \
+        _VL_SIMD_FOLD512(op, acc512, acc256); \
+        __m128i acc128 = _mm_##op##_si128(_mm256_castsi256_si128(acc256), \
+                                          _mm256_extracti128_si256(acc256, 1)); \
+        acc128 = _mm_##op##_si128(acc128, _mm_srli_si128(acc128, 8)); \
+        acc128 = _mm_##op##_si128(acc128, _mm_srli_si128(acc128, 4)); \
+        r = _vl_simd_##op##_e(r, static_cast<EData>(_mm_cvtsi128_si32(acc128))); \
+    } while (false)
+// clang-format off
+#ifdef VL_HAVE_AVX512
+# define _VL_SIMD_FOLD512(op, acc512, acc256) \
+    acc256 = _mm256_##op##_si256(acc256, _mm256_##op##_si256( \
+        _mm512_castsi512_si256(acc512), _mm512_extracti64x4_epi64(acc512, 1)))
+# define _VL_SIMD_ACC512(init) __m512i acc512 = _mm512_set1_epi32(init)
+#else
+# define _VL_SIMD_FOLD512(op, acc512, acc256)
+# define _VL_SIMD_ACC512(init)
+#endif
+// clang-format on
+
+// Bitwise AND/OR/XOR of all words
+#define _VL_SIMD_REDUCE_W(name, op, init) \
+    static inline EData name(int words, WDataInP lwp) VL_MT_SAFE { \
+        int i = 0; \
+        _VL_SIMD_ACC512(init); \
+        _VL_SIMD_LOOP512(acc512 = _mm512_##op##_si512(acc512, _VL_LD512(lwp))); \
+        __m256i acc256 = _mm256_set1_epi32(init); \
+        for (; i + 8 <= words; i += 8) acc256 = _mm256_##op##_si256(acc256, _VL_LD256(lwp)); \
+        EData r = static_cast<EData>(init); \
+        for (; i < words; ++i) r = _vl_simd_##op##_e(r, lwp[i]); \
+        _VL_SIMD_FOLD(op, acc512, acc256); \
+        return r; \
+    }
+_VL_SIMD_REDUCE_W(_vl_simd_redand_w, and, -1)
+_VL_SIMD_REDUCE_W(_vl_simd_redor_w, or, 0)
+_VL_SIMD_REDUCE_W(_vl_simd_redxor_w, xor, 0)
+#undef _VL_SIMD_REDUCE_W
+
+// Returns nonzero if any word differs
+static inline EData _vl_simd_neq_w(int words, WDataInP lwp, WDataInP rwp) VL_MT_SAFE {
+    int i = 0;
+    _VL_SIMD_ACC512(0);
+    _VL_SIMD_LOOP512(acc512 = _mm512_or_si512(
+                         acc512, _mm512_xor_si512(_VL_LD512(lwp), _VL_LD512(rwp))));
+    __m256i acc256 = _mm256_setzero_si256();
+    for (; i + 8 <= words; i += 8) {
+        acc256 = _mm256_or_si256(acc256, _mm256_xor_si256(_VL_LD256(lwp), _VL_LD256(rwp)));
+    }
+    EData r = 0;
+    for (; i < words; ++i) r |= lwp[i] ^ rwp[i];
+    _VL_SIMD_FOLD(or, acc512, acc256);
+    return r;
+}
+
+// Unsigned compare scanning from the most significant word; -1, 0 or 1
+static inline int _vl_simd_cmp_w(int words, WDataInP lwp, WDataInP rwp) VL_MT_SAFE {
+    int i = words;
+    while (i >= 8) {
+        i -= 8;
+        const __m256i eq = _mm256_cmpeq_epi32(_VL_LD256(lwp), _VL_LD256(rwp));
+        const int neqmask = ~_mm256_movemask_ps(_mm256_castsi256_ps(eq)) & 0xff;
+        if (neqmask) {
+            int lane = 7;
+            while (!((neqmask >> lane) & 1)) --lane;
+            return (lwp[i + lane] > rwp[i + lane]) ? 1 : -1;
+        }
+    }
+    for (--i; i >= 0; --i) {
+        if (lwp[i] > rwp[i]) return 1;
+        if (lwp[i] < rwp[i]) return -1;
+    }
+    return 0;  // ==
+}
+
+#undef _VL_SIMD_ACC512
+#undef _VL_SIMD_FOLD
+#undef _VL_SIMD_FOLD512
+#undef _VL_SIMD_LOOP512
+#undef _VL_LD256
+#undef _VL_ST256
+#undef _VL_LD512
+#undef _VL_ST512
+#endif  // VL_HAVE_AVX2
+
 //===================================================================
 // SETTING OPERATORS
 
@@ -943,6 +1166,12 @@ static inline WDataOutP VL_ALLONES_W(int obits, WDataOutP owp) VL_MT_SAFE {
 // Note: If a ASSIGN isn't clean, use VL_ASSIGNCLEAN instead to do the same thing.
 static inline WDataOutP VL_ASSIGN_W(int obits, WDataOutP owp, WDataInP lwp) VL_MT_SAFE {
     int words = VL_WORDS_I(obits);
+#ifdef VL_HAVE_AVX2
+    if (words >= VL_SIMD_WORDS) {
+        _vl_simd_copy_w(words, owp, lwp);
+        return owp;
+    }
+#endif
     for (int i = 0; i < words; ++i) owp[i] = lwp[i];
     return owp;
 }
@@ -1143,6 +1372,13 @@ static inline WDataOutP VL_EXTENDS_WW(int obits, int lbits, WDataOutP owp,
 #define VL_REDAND_IQ(obits, lbits, lhs) ((lhs) == VL_MASK_Q(lbits))
 static inline IData VL_REDAND_IW(int, int lbits, WDataInP lwp) VL_MT_SAFE {
     int words = VL_WORDS_I(lbits);
+#ifdef VL_HAVE_AVX2
+    if (words >= VL_SIMD_WORDS) {
+        EData combine = _vl_simd_redand_w(words - 1, lwp);
+        combine &= ~VL_MASK_E(lbits) | lwp[words - 1];
+        return ((~combine) == 0);
+    }
+#endif
     EData combine = lwp[0];
     for (int i = 1; i < words - 1; ++i) combine &= lwp[i];
     combine &= ~VL_MASK_E(lbits) | lwp[words - 1];
@@ -1157,6 +1393,17 @@ static inline IData VL_REDOR_W(int words, WDataInP lwp) VL_MT_SAFE {
     for (int i = 0; i < words; ++i) equal |= lwp[i];
     return (equal != 0);
 }
+// Width-specialized forms of the wide operations.  V3EmitC calls these as
+// VL_*_W<words>(words, ...) so loop trip counts are compile-time constants
+// the C++ compiler can fully unroll or vectorize.
+template <int T_Words> static inline IData VL_REDOR_W(int, WDataInP lwp) VL_MT_SAFE {
+#ifdef VL_HAVE_AVX2
+    if (T_Words >= VL_SIMD_WORDS) return (_vl_simd_redor_w(T_Words, lwp) != 0);
+#endif
+    EData equal = 0;
+    for (int i = 0; i < T_Words; ++i) equal |= lwp[i];
+    return (equal != 0);
+}
 
 // EMIT_RULE: VL_REDXOR:  oclean=dirty; obits=1;
 static inline IData VL_REDXOR_2(IData r) VL_PURE {
@@ -1224,6 +1471,14 @@ static inline IData VL_REDXOR_W(int words, WDataInP lwp) VL_MT_SAFE {
     for (int i = 1; i < words; ++i) r ^= lwp[i];
     return VL_REDXOR_32(r);
 }
+template <int T_Words> static inline IData VL_REDXOR_W(int, WDataInP lwp) VL_MT_SAFE {
+#ifdef VL_HAVE_AVX2
+    if (T_Words >= VL_SIMD_WORDS) return VL_REDXOR_32(_vl_simd_redxor_w(T_Words, lwp));
+#endif
+    EData r = lwp[0];
+    for (int i = 1; i < T_Words; ++i) r ^= lwp[i];
+    return VL_REDXOR_32(r);
+}
 
 // EMIT_RULE: VL_COUNTONES_II:  oclean = false; lhs clean
 static inline IData VL_COUNTONES_I(IData lhs) VL_PURE {
@@ -1357,11 +1612,33 @@ static inline WDataOutP VL_AND_W(int words, WDataOutP owp, WDataInP lwp, WDataIn
     for (int i = 0; (i < words); ++i) owp[i] = (lwp[i] & rwp[i]);
     return owp;
 }
+template <int T_Words>
+static inline WDataOutP VL_AND_W(int, WDataOutP owp, WDataInP lwp, WDataInP rwp) VL_MT_SAFE {
+#ifdef VL_HAVE_AVX2
+    if (T_Words >= VL_SIMD_WORDS) {
+        _vl_simd_and_w(T_Words, owp, lwp, rwp);
+        return owp;
+    }
+#endif
+    for (int i = 0; i < T_Words; ++i) owp[i] = (lwp[i] & rwp[i]);
+    return owp;
+}
 // EMIT_RULE: VL_OR:   oclean=lclean&&rclean; obits=lbits; lbits==rbits;
 static inline WDataOutP VL_OR_W(int words, WDataOutP owp, WDataInP lwp, WDataInP rwp) VL_MT_SAFE {
     for (int i = 0; (i < words); ++i) owp[i] = (lwp[i] | rwp[i]);
     return owp;
 }
+template <int T_Words>
+static inline WDataOutP VL_OR_W(int, WDataOutP owp, WDataInP lwp, WDataInP rwp) VL_MT_SAFE {
+#ifdef VL_HAVE_AVX2
+    if (T_Words >= VL_SIMD_WORDS) {
+        _vl_simd_or_w(T_Words, owp, lwp, rwp);
+        return owp;
+    }
+#endif
+    for (int i = 0; i < T_Words; ++i) owp[i] = (lwp[i] | rwp[i]);
+    return owp;
+}
 // EMIT_RULE: VL_CHANGEXOR:  oclean=1; obits=32; lbits==rbits;
 static inline IData VL_CHANGEXOR_W(int words, WDataInP lwp, WDataInP rwp) VL_MT_SAFE {
     IData od = 0;
@@ -1373,11 +1650,33 @@ static inline WDataOutP VL_XOR_W(int words, WDataOutP owp, WDataInP lwp, WDataIn
     for (int i = 0; (i < words); ++i) owp[i] = (lwp[i] ^ rwp[i]);
     return owp;
 }
+template <int T_Words>
+static inline WDataOutP VL_XOR_W(int, WDataOutP owp, WDataInP lwp, WDataInP rwp) VL_MT_SAFE {
+#ifdef VL_HAVE_AVX2
+    if (T_Words >= VL_SIMD_WORDS) {
+        _vl_simd_xor_w(T_Words, owp, lwp, rwp);
+        return owp;
+    }
+#endif
+    for (int i = 0; i < T_Words; ++i) owp[i] = (lwp[i] ^ rwp[i]);
+    return owp;
+}
 // EMIT_RULE: VL_NOT:  oclean=dirty; obits=lbits;
 static inline WDataOutP VL_NOT_W(int words, WDataOutP owp, WDataInP lwp) VL_MT_SAFE {
     for (int i = 0; i < words; ++i) owp[i] = ~(lwp[i]);
     return owp;
 }
+template <int T_Words>
+static inline WDataOutP VL_NOT_W(int, WDataOutP owp, WDataInP lwp) VL_MT_SAFE {
+#ifdef VL_HAVE_AVX2
+    if (T_Words >= VL_SIMD_WORDS) {
+        _vl_simd_not_w(T_Words, owp, lwp);
+        return owp;
+    }
+#endif
+    for (int i = 0; i < T_Words; ++i) owp[i] = ~(lwp[i]);
+    return owp;
+}
 
 //=========================================================================
 // Logical comparisons
@@ -1400,9 +1699,20 @@ static inline IData VL_EQ_W(int words, WDataInP lwp, WDataInP rwp) VL_MT_SAFE {
     for (int i = 0; (i < words); ++i) nequal |= (lwp[i] ^ rwp[i]);
     return (nequal == 0);
 }
+template <int T_Words> static inline IData VL_EQ_W(int, WDataInP lwp, WDataInP rwp) VL_MT_SAFE {
+#ifdef VL_HAVE_AVX2
+    if (T_Words >= VL_SIMD_WORDS) return (_vl_simd_neq_w(T_Words, lwp, rwp) == 0);
+#endif
+    EData nequal = 0;
+    for (int i = 0; i < T_Words; ++i) nequal |= (lwp[i] ^ rwp[i]);
+    return (nequal == 0);
+}
 
 // Internal usage
 static inline int _VL_CMP_W(int words, WDataInP lwp, WDataInP rwp) VL_MT_SAFE {
+#ifdef VL_HAVE_AVX2
+    if (words >= VL_SIMD_WORDS) return _vl_simd_cmp_w(words, lwp, rwp);
+#endif
     for (int i = words - 1; i >= 0; --i) {
         if (lwp[i] > rwp[i]) return 1;
         if (lwp[i] < rwp[i]) return -1;
@@ -1488,6 +1798,15 @@ static inline WDataOutP VL_NEGATE_W(int words, WDataOutP owp, WDataInP lwp) VL_M
     }
     return owp;
 }
+template <int T_Words>
+static inline WDataOutP VL_NEGATE_W(int, WDataOutP owp, WDataInP lwp) VL_MT_SAFE {
+    EData carry = 1;
+    for (int i = 0; i < T_Words; ++i) {
+        owp[i] = ~lwp[i] + carry;
+        carry = (owp[i] < ~lwp[i]);
+    }
+    return owp;
+}
 static void VL_NEGATE_INPLACE_W(int words, WDataOutP owp_lwp) VL_MT_SAFE {
     EData carry = 1;
     for (int i = 0; i < words; ++i) {
@@ -1517,6 +1836,17 @@ static inline WDataOutP VL_ADD_W(int words, WDataOutP owp, WDataInP lwp, WDataIn
     // Last output word is dirty
     return owp;
 }
+template <int T_Words>
+static inline WDataOutP VL_ADD_W(int, WDataOutP owp, WDataInP lwp, WDataInP rwp) VL_MT_SAFE {
+    QData carry = 0;
+    for (int i = 0; i < T_Words; ++i) {
+        carry = carry + static_cast<QData>(lwp[i]) + static_cast<QData>(rwp[i]);
+        owp[i] = (carry & 0xffffffffULL);
+        carry = (carry >> 32ULL) & 0xffffffffULL;
+    }
+    // Last output word is dirty
+    return owp;
+}
 
 static inline WDataOutP VL_SUB_W(int words, WDataOutP owp, WDataInP lwp, WDataInP rwp) VL_MT_SAFE {
     QData carry = 0;
@@ -1530,8 +1860,26 @@ static inline WDataOutP VL_SUB_W(int words, WDataOutP owp, WDataInP lwp, WDataIn
     // Last output word is dirty
     return owp;
 }
+template <int T_Words>
+static inline WDataOutP VL_SUB_W(int, WDataOutP owp, WDataInP lwp, WDataInP rwp) VL_MT_SAFE {
+    QData carry = 1;  // Negation of rwp
+    for (int i = 0; i < T_Words; ++i) {
+        carry = (carry + static_cast<QData>(lwp[i])
+                 + static_cast<QData>(static_cast<IData>(~rwp[i])));
+        owp[i] = (carry & 0xffffffffULL);
+        carry = (carry >> 32ULL) & 0xffffffffULL;
+    }
+    // Last output word is dirty
+    return owp;
+}
+
+// Multiplies from VL_MUL_LIMB_WORDS words use the 64-bit limb version in verilated.cpp
+#define VL_MUL_LIMB_WORDS 8
 
 static inline WDataOutP VL_MUL_W(int words, WDataOutP owp, WDataInP lwp, WDataInP rwp) VL_MT_SAFE {
+    if (words >= VL_MUL_LIMB_WORDS && words <= VL_MULS_MAX_WORDS) {
+        return _vl_mul_w(words, owp, lwp, rwp);
+    }
     for (int i = 0; i < words; ++i) owp[i] = 0;
     for (int lword = 0; lword < words; ++lword) {
         for (int rword = 0; rword < words; ++rword) {
@@ -1546,6 +1894,26 @@ static inline WDataOutP VL_MUL_W(int words, WDataOutP owp, WDataInP lwp, WDataIn
     // Last output word is dirty
     return owp;
 }
+template <int T_Words>
+static inline WDataOutP VL_MUL_W(int, WDataOutP owp, WDataInP lwp, WDataInP rwp) VL_MT_SAFE {
+    if (T_Words >= VL_MUL_LIMB_WORDS && T_Words <= VL_MULS_MAX_WORDS) {
+        return _vl_mul_w(T_Words, owp, lwp, rwp);
+    }
+    // Product words at or above T_Words are discarded, so only the lower
+    // triangle of partial products is formed
+    for (int i = 0; i < T_Words; ++i) owp[i] = 0;
+    for (int lword = 0; lword < T_Words; ++lword) {
+        QData carry = 0;
+        for (int rword = 0; rword < T_Words - lword; ++rword) {
+            carry += static_cast<QData>(lwp[lword]) * static_cast<QData>(rwp[rword])
+                     + static_cast<QData>(owp[lword + rword]);
+            owp[lword + rword] = (carry & 0xffffffffULL);
+            carry = (carry >> 32ULL) & 0xffffffffULL;
+        }
+    }
+    // Last output word is dirty
+    return owp;
+}
 
 static inline IData VL_MULS_III(int, int lbits, int, IData lhs, IData rhs) VL_PURE {
     vlsint32_t lhs_signed = VL_EXTENDS_II(32, lbits, lhs);
@@ -2136,6 +2504,22 @@ static inline WDataOutP VL_SHIFTL_WWI(int obits, int, int, WDataOutP owp, WDataI
     }
     return owp;
 }
+template <int T_OWords>
+static inline WDataOutP VL_SHIFTL_WWI(int obits, int, int, WDataOutP owp, WDataInP lwp,
+                                      IData rd) VL_MT_SAFE {
+    int word_shift = VL_BITWORD_E(rd);
+    int bit_shift = VL_BITBIT_E(rd);
+    if (rd >= static_cast<IData>(obits)) {  // rd may be huge with MSB set
+        for (int i = 0; i < T_OWords; ++i) owp[i] = 0;
+    } else if (bit_shift == 0) {  // Aligned word shift (<<0,<<32,<<64 etc)
+        for (int i = 0; i < word_shift; ++i) owp[i] = 0;
+        for (int i = word_shift; i < T_OWords; ++i) owp[i] = lwp[i - word_shift];
+    } else {
+        for (int i = 0; i < T_OWords; ++i) owp[i] = 0;
+        _VL_INSERT_WW(obits, owp, lwp, obits - 1, rd);
+    }
+    return owp;
+}
 static inline WDataOutP VL_SHIFTL_WWW(int obits, int lbits, int rbits, WDataOutP owp, WDataInP lwp,
                                       WDataInP rwp) VL_MT_SAFE {
     for (int i = 1; i < VL_WORDS_I(rbits); ++i) {
@@ -2145,6 +2529,16 @@ static inline WDataOutP VL_SHIFTL_WWW(int obits, int lbits, int rbits, WDataOutP
     }
     return VL_SHIFTL_WWI(obits, lbits, 32, owp, lwp, rwp[0]);
 }
+template <int T_OWords>
+static inline WDataOutP VL_SHIFTL_WWW(int obits, int lbits, int rbits, WDataOutP owp, WDataInP lwp,
+                                      WDataInP rwp) VL_MT_SAFE {
+    for (int i = 1; i < VL_WORDS_I(rbits); ++i) {
+        if (VL_UNLIKELY(rwp[i])) {  // Huge shift 1>>32 or more
+            return VL_ZERO_W(obits, owp);
+        }
+    }
+    return VL_SHIFTL_WWI<T_OWords>(obits, lbits, 32, owp, lwp, rwp[0]);
+}
 static inline IData VL_SHIFTL_IIW(int obits, int, int rbits, IData lhs, WDataInP rwp) VL_MT_SAFE {
     for (int i = 1; i < VL_WORDS_I(rbits); ++i) {
         if (VL_UNLIKELY(rwp[i])) {  // Huge shift 1>>32 or more
@@ -2190,6 +2584,31 @@ static inline WDataOutP VL_SHIFTR_WWI(int obits, int, int, WDataOutP owp, WDataI
     }
     return owp;
 }
+template <int T_OWords>
+static inline WDataOutP VL_SHIFTR_WWI(int obits, int, int, WDataOutP owp, WDataInP lwp,
+                                      IData rd) VL_MT_SAFE {
+    int word_shift = VL_BITWORD_E(rd);  // Maybe 0
+    int bit_shift = VL_BITBIT_E(rd);
+    if (rd >= static_cast<IData>(obits)) {  // rd may be huge with MSB set
+        for (int i = 0; i < T_OWords; ++i) owp[i] = 0;
+    } else if (bit_shift == 0) {  // Aligned word shift (>>0,>>32,>>64 etc)
+        int copy_words = (T_OWords - word_shift);
+        for (int i = 0; i < copy_words; ++i) owp[i] = lwp[i + word_shift];
+        for (int i = copy_words; i < T_OWords; ++i) owp[i] = 0;
+    } else {
+        int loffset = rd & VL_SIZEBITS_E;
+        int nbitsonright = VL_EDATASIZE - loffset;  // bits that end up in lword (know loffset!=0)
+        // Middle words
+        int words = VL_WORDS_I(obits - rd);
+        for (int i = 0; i < words; ++i) {
+            owp[i] = lwp[i + word_shift] >> loffset;
+            int upperword = i + word_shift + 1;
+            if (upperword < T_OWords) owp[i] |= lwp[upperword] << nbitsonright;
+        }
+        for (int i = words; i < T_OWords; ++i) owp[i] = 0;
+    }
+    return owp;
+}
 static inline WDataOutP VL_SHIFTR_WWW(int obits, int lbits, int rbits, WDataOutP owp, WDataInP lwp,
                                       WDataInP rwp) VL_MT_SAFE {
     for (int i = 1; i < VL_WORDS_I(rbits); ++i) {
@@ -2199,12 +2618,29 @@ static inline WDataOutP VL_SHIFTR_WWW(int obits, int lbits, int rbits, WDataOutP
     }
     return VL_SHIFTR_WWI(obits, lbits, 32, owp, lwp, rwp[0]);
 }
+template <int T_OWords>
+static inline WDataOutP VL_SHIFTR_WWW(int obits, int lbits, int rbits, WDataOutP owp, WDataInP lwp,
+                                      WDataInP rwp) VL_MT_SAFE {
+    for (int i = 1; i < VL_WORDS_I(rbits); ++i) {
+        if (VL_UNLIKELY(rwp[i])) {  // Huge shift 1>>32 or more
+            return VL_ZERO_W(obits, owp);
+        }
+    }
+    return VL_SHIFTR_WWI<T_OWords>(obits, lbits, 32, owp, lwp, rwp[0]);
+}
 static inline WDataOutP VL_SHIFTR_WWQ(int obits, int lbits, int rbits, WDataOutP owp, WDataInP lwp,
                                       QData rd) VL_MT_SAFE {
     WData rwp[VL_WQ_WORDS_E];
     VL_SET_WQ(rwp, rd);
     return VL_SHIFTR_WWW(obits, lbits, rbits, owp, lwp, rwp);
 }
+template <int T_OWords>
+static inline WDataOutP VL_SHIFTR_WWQ(int obits, int lbits, int rbits, WDataOutP owp, WDataInP lwp,
+                                      QData rd) VL_MT_SAFE {
+    WData rwp[VL_WQ_WORDS_E];
+    VL_SET_WQ(rwp, rd);
+    return VL_SHIFTR_WWW<T_OWords>(obits, lbits, rbits, owp, lwp, rwp);
+}
 
 static inline IData VL_SHIFTR_IIW(int obits, int, int rbits, IData lhs, WDataInP rwp) VL_MT_SAFE {
     for (int i = 1; i < VL_WORDS_I(rbits); ++i) {
@@ -2496,6 +2932,12 @@ static inline void VL_ASSIGNSEL_WIIW(int obits, int lsb, WDataOutP owp, WDataInP
 static inline WDataOutP VL_COND_WIWW(int obits, int, int, int, WDataOutP owp, int cond,
                                      WDataInP w1p, WDataInP w2p) VL_MT_SAFE {
     int words = VL_WORDS_I(obits);
+#ifdef VL_HAVE_AVX2
+    if (words >= VL_SIMD_WORDS) {
+        _vl_simd_copy_w(words, owp, cond ? w1p : w2p);
+        return owp;
+    }
+#endif
     for (int i = 0; i < words; ++i) owp[i] = cond ? w1p[i] : w2p[i];
     return owp;
 }
@@ -81,6 +81,39 @@ public:
     virtual ~VerilatedCoverItemSpec() override = default;
 };
 
+//=============================================================================
+/// VerilatedCoverItemShards templated for a specific class
+/// Coverage item whose count is the saturating sum of per-thread shards.
+
+template <class T> class VerilatedCoverItemShards final : public VerilatedCovImpItem {
+private:
+    // MEMBERS
+    T* m_countp;  ///< Count value in shard 0
+    std::size_t m_stride;  ///< Distance between shards, in counts
+    std::size_t m_shards;  ///< Number of shards
+public:
+    // METHODS
+    virtual vluint64_t count() const override {
+        vluint64_t sum = 0;
+        for (std::size_t i = 0; i < m_shards; ++i) {
+            const vluint64_t add = m_countp[i * m_stride];
+            sum = (sum + add < sum) ? ~0ULL : (sum + add);
+        }
+        return sum;
+    }
+    virtual void zero() const override {
+        for (std::size_t i = 0; i < m_shards; ++i) m_countp[i * m_stride] = 0;
+    }
+    // CONSTRUCTORS
+    VerilatedCoverItemShards(T* countp, std::size_t stride, std::size_t shards)
+        : m_countp{countp}
+        , m_stride{stride}
+        , m_shards{shards} {
+        zero();
+    }
+    virtual ~VerilatedCoverItemShards() override = default;
+};
+
 //=============================================================================
 // VerilatedCovImp
 /// Implementation class for VerilatedCov.  See that class for public method information.
@@ -93,6 +126,8 @@ private:
     typedef std::map<const std::string, int> ValueIndexMap;
     typedef std::map<int, std::string> IndexValueMap;
     typedef std::deque<VerilatedCovImpItem*> ItemList;
+    typedef std::map<const std::string, std::pair<std::string, vluint64_t>>
+        EventMap;  ///< Event name to hierarchy and count
 
     // MEMBERS
     VerilatedMutex m_mutex;  ///< Protects all members
@@ -237,6 +272,70 @@ private:
         m_valueIndexes.clear();
         m_nextIndex = KEY_UNDEF + 1;
     }
+    void buildEvents(EventMap& eventCounts) VL_REQUIRES(m_mutex) {
+        // Build list of events; totalize if collapsing hierarchy
+        for (const auto& itemp : m_items) {
+            std::string name;
+            std::string hier;
+            bool per_instance = false;
+
+            for (int i = 0; i < MAX_KEYS; ++i) {
+                if (itemp->m_keys[i] != KEY_UNDEF) {
+                    std::string key = VerilatedCovKey::shortKey(m_indexValues[itemp->m_keys[i]]);
+                    std::string val = m_indexValues[itemp->m_vals[i]];
+                    if (key == VL_CIK_PER_INSTANCE) {
+                        if (val != "0") per_instance = true;
+                    }
+                    if (key == VL_CIK_HIER) {
+                        hier = val;
+                    } else {
+                        // Print it
+                        name += keyValueFormatter(key, val);
+                    }
+                }
+            }
+            if (per_instance) {  // Not collapsing hierarchies
+                name += keyValueFormatter(VL_CIK_HIER, hier);
+                hier = "";
+            }
+
+            // Group versus point labels don't matter here, downstream
+            // deals with it.  Seems bad for sizing though and doesn't
+            // allow easy addition of new group codes (would be
+            // inefficient)
+
+            // Find or insert the named event
+            const auto cit = eventCounts.find(name);
+            if (cit != eventCounts.end()) {
+                const std::string& oldhier = cit->second.first;
+                cit->second.second += itemp->count();
+                cit->second.first = combineHier(oldhier, hier);
+            } else {
+                eventCounts.emplace(name, make_pair(hier, itemp->count()));
+            }
+        }
+    }
+    static std::string eventName(const EventMap::value_type& event) VL_PURE {
+        std::string name = event.first;
+        if (!event.second.first.empty()) {
+            name += keyValueFormatter(VL_CIK_HIER, event.second.first);
+        }
+        return name;
+    }
+    static void writeTextBody(std::ofstream& os, const EventMap& eventCounts) {
+        os << "# SystemC::Coverage-3\n";
+        for (const auto& i : eventCounts) {
+            os << "C '" << std::dec;
+            os << eventName(i);
+            os << "' " << i.second.second;
+            os << '\n';
+        }
+    }
+    static void writeBinaryBody(std::ofstream& os, const EventMap& eventCounts) {
+        VerilatedCovBinaryWriter writer;
+        for (const auto& i : eventCounts) writer.add(eventName(i), i.second.second);
+        writer.write(os);
+    }
 
 public:
     // PUBLIC METHODS
@@ -334,7 +433,7 @@ public:
         m_insertp = nullptr;
     }
 
-    void write(const char* filename) VL_EXCLUDES(m_mutex) {
+    void write(const char* filename, bool binary) VL_EXCLUDES(m_mutex) {
         Verilated::quiesce();
         const VerilatedLockGuard lock(m_mutex);
 #ifndef VM_COVERAGE
@@ -342,65 +441,19 @@ public:
 #endif
         selftest();
 
-        std::ofstream os(filename);
+        std::ofstream os(filename, binary ? (std::ios::out | std::ios::binary) : std::ios::out);
         if (os.fail()) {
             std::string msg = std::string("%Error: Can't write '") + filename + "'";
             VL_FATAL_MT("", 0, "", msg.c_str());
             return;
         }
-        os << "# SystemC::Coverage-3\n";
 
-        // Build list of events; totalize if collapsing hierarchy
-        typedef std::map<const std::string, std::pair<std::string, vluint64_t>> EventMap;
         EventMap eventCounts;
-        for (const auto& itemp : m_items) {
-            std::string name;
-            std::string hier;
-            bool per_instance = false;
-
-            for (int i = 0; i < MAX_KEYS; ++i) {
-                if (itemp->m_keys[i] != KEY_UNDEF) {
-                    std::string key = VerilatedCovKey::shortKey(m_indexValues[itemp->m_keys[i]]);
-                    std::string val = m_indexValues[itemp->m_vals[i]];
-                    if (key == VL_CIK_PER_INSTANCE) {
-                        if (val != "0") per_instance = true;
-                    }
-                    if (key == VL_CIK_HIER) {
-                        hier = val;
-                    } else {
-                        // Print it
-                        name += keyValueFormatter(key, val);
-                    }
-                }
-            }
-            if (per_instance) {  // Not collapsing hierarchies
-                name += keyValueFormatter(VL_CIK_HIER, hier);
-                hier = "";
-            }
-
-            // Group versus point labels don't matter here, downstream
-            // deals with it.  Seems bad for sizing though and doesn't
-            // allow easy addition of new group codes (would be
-            // inefficient)
-
-            // Find or insert the named event
-            const auto cit = eventCounts.find(name);
-            if (cit != eventCounts.end()) {
-                const std::string& oldhier = cit->second.first;
-                cit->second.second += itemp->count();
-                cit->second.first = combineHier(oldhier, hier);
-            } else {
-                eventCounts.emplace(name, make_pair(hier, itemp->count()));
-            }
-        }
-
-        // Output body
-        for (const auto& i : eventCounts) {
-            os << "C '" << std::dec;
-            os << i.first;
-            if (!i.second.first.empty()) os << keyValueFormatter(VL_CIK_HIER, i.second.first);
-            os << "' " << i.second.second;
-            os << '\n';
+        buildEvents(eventCounts);
+        if (binary) {
+            writeBinaryBody(os, eventCounts);
+        } else {
+            writeTextBody(os, eventCounts);
         }
     }
 };
@@ -414,7 +467,10 @@ void VerilatedCov::clearNonMatch(const char* matchp) VL_MT_SAFE {
 }
 void VerilatedCov::zero() VL_MT_SAFE { VerilatedCovImp::imp().zero(); }
 void VerilatedCov::write(const char* filenamep) VL_MT_SAFE {
-    VerilatedCovImp::imp().write(filenamep);
+    VerilatedCovImp::imp().write(filenamep, false);
+}
+void VerilatedCov::writeBinary(const char* filenamep) VL_MT_SAFE {
+    VerilatedCovImp::imp().write(filenamep, true);
 }
 void VerilatedCov::_inserti(vluint32_t* itemp) VL_MT_SAFE {
     VerilatedCovImp::imp().inserti(new VerilatedCoverItemSpec<vluint32_t>(itemp));
@@ -422,6 +478,16 @@ void VerilatedCov::_inserti(vluint32_t* itemp) VL_MT_SAFE {
 void VerilatedCov::_inserti(vluint64_t* itemp) VL_MT_SAFE {
     VerilatedCovImp::imp().inserti(new VerilatedCoverItemSpec<vluint64_t>(itemp));
 }
+void VerilatedCov::_inserti(vluint32_t* itemp, std::size_t stride,
+                            std::size_t shards) VL_MT_SAFE {
+    VerilatedCovImp::imp().inserti(
+        new VerilatedCoverItemShards<vluint32_t>(itemp, stride, shards));
+}
+void VerilatedCov::_inserti(vluint64_t* itemp, std::size_t stride,
+                            std::size_t shards) VL_MT_SAFE {
+    VerilatedCovImp::imp().inserti(
+        new VerilatedCoverItemShards<vluint64_t>(itemp, stride, shards));
+}
 void VerilatedCov::_insertf(const char* filename, int lineno) VL_MT_SAFE {
     VerilatedCovImp::imp().insertf(filename, lineno);
 }
@@ -20,6 +20,7 @@
 #define _VERILATED_COV_H_ 1
 
 #include "verilatedos.h"
+#include "verilated.h"
 
 #include <iostream>
 #include <sstream>
@@ -72,6 +73,13 @@
     VL_IF_COVER(VerilatedCov::_inserti(countp); VerilatedCov::_insertf(__FILE__, __LINE__); \
                 VerilatedCov::_insertp("hier", name(), __VA_ARGS__))
 
+/// Insert an item whose count is split across per-thread shards.
+/// The count of shard N is at countp[N * stride]; see VlCoverShards.
+#define VL_COVER_INSERT_SHARDS(countp, stride, shards, ...) \
+    VL_IF_COVER(VerilatedCov::_inserti(countp, stride, shards); \
+                VerilatedCov::_insertf(__FILE__, __LINE__); \
+                VerilatedCov::_insertp("hier", name(), __VA_ARGS__))
+
 //=============================================================================
 /// Convert VL_COVER_INSERT value arguments to strings
 
@@ -81,6 +89,54 @@ template <class T> std::string vlCovCvtToStr(const T& t) VL_PURE {
     return os.str();
 }
 
+//=============================================================================
+/// Increment a coverage count, saturating rather than wrapping.
+/// Used by Verilated models with --coverage-counter-width 64.
+
+template <class T> inline void vlCoverSatInc(T& count) VL_MT_UNSAFE {
+    if (VL_LIKELY(count != ~T{0})) ++count;
+}
+#ifdef VL_THREADED
+template <class T> inline void vlCoverSatInc(std::atomic<T>& count) VL_MT_SAFE {
+    T old = count.load(std::memory_order_relaxed);
+    while (VL_LIKELY(old != ~T{0})
+           && !count.compare_exchange_weak(old, old + 1, std::memory_order_relaxed)) {}
+}
+
+//=============================================================================
+/// Per-thread coverage counts, used by Verilated models with --coverage-shards.
+/// Each thread of the model's thread pool increments its own copy of the
+/// counts, selected by Verilated::threadIndex(), without atomics and without
+/// sharing cache lines with the other threads.  The shards are summed when
+/// coverage is written.  Counts saturate rather than wrap.
+
+template <class T_Count, std::size_t T_Bins, std::size_t T_Shards> class VlCoverShards final {
+    // Counts per shard, rounded up to whole cache lines
+    static constexpr std::size_t s_stride
+        = ((T_Bins * sizeof(T_Count) + VL_CACHE_LINE_BYTES - 1) / VL_CACHE_LINE_BYTES)
+          * VL_CACHE_LINE_BYTES / sizeof(T_Count);
+    // MEMBERS
+    alignas(VL_CACHE_LINE_BYTES) T_Count m_counts[T_Shards * s_stride];
+
+public:
+    // CONSTRUCTORS
+    VlCoverShards() {
+        for (std::size_t i = 0; i < T_Shards * s_stride; ++i) m_counts[i] = 0;
+    }
+    ~VlCoverShards() = default;
+    VL_UNCOPYABLE(VlCoverShards);
+    // METHODS
+    static constexpr std::size_t stride() { return s_stride; }
+    static constexpr std::size_t shards() { return T_Shards; }
+    /// Count of bin in shard 0, for VL_COVER_INSERT_SHARDS
+    T_Count* binp(std::size_t bin) { return &m_counts[bin]; }
+    /// Increment bin in the calling thread's shard
+    void inc(std::size_t bin) VL_MT_SAFE {
+        vlCoverSatInc(m_counts[Verilated::threadIndex() * s_stride + bin]);
+    }
+};
+#endif
+
 //=============================================================================
 //  VerilatedCov
 ///  Verilator coverage global class
@@ -97,6 +153,9 @@ public:
     static const char* defaultFilename() VL_PURE { return "coverage.dat"; }
     /// Write all coverage data to a file
     static void write(const char* filenamep = defaultFilename()) VL_MT_SAFE;
+    /// Write all coverage data to a file in the binary format, which
+    /// verilator_coverage reads much faster
+    static void writeBinary(const char* filenamep = defaultFilename()) VL_MT_SAFE;
     /// Insert a coverage item
     /// We accept from 1-30 key/value pairs, all as strings.
     /// Call _insert1, followed by _insert2 and _insert3
@@ -104,6 +163,9 @@ public:
     // _insert1: Remember item pointer with count.  (Not const, as may add zeroing function)
     static void _inserti(vluint32_t* itemp) VL_MT_SAFE;
     static void _inserti(vluint64_t* itemp) VL_MT_SAFE;
+    // _insert1 for counts split into shards, each 'stride' counts apart
+    static void _inserti(vluint32_t* itemp, std::size_t stride, std::size_t shards) VL_MT_SAFE;
+    static void _inserti(vluint64_t* itemp, std::size_t stride, std::size_t shards) VL_MT_SAFE;
     // _insert2: Set default filename and line number
     static void _insertf(const char* filename, int lineno) VL_MT_SAFE;
     // _insert3: Set parameters
@@ -21,7 +21,9 @@
 
 #include "verilatedos.h"
 
+#include <ostream>
 #include <string>
+#include <vector>
 
 //=============================================================================
 // Data used to edit below file, using vlcovgen
@@ -79,4 +81,53 @@ public:
     }
 };
 
+//=============================================================================
+// Binary coverage data format, written by VerilatedCov::writeBinary and
+// verilator_coverage --write-binary.  Integers are in host byte order; the
+// endian marker lets readers reject files from another byte order.
+//
+//     char[8]     VL_COV_BINARY_MAGIC (not NUL terminated)
+//     vluint32_t  VL_COV_BINARY_ENDIAN
+//     vluint32_t  Reserved, zero
+//     vluint64_t  Number of points
+//     vluint64_t  Bytes in name table, a multiple of 8
+//     char[]      Name table, each point's name NUL terminated, zero padded
+//     vluint64_t  Count of each point, in name table order
+//
+// Runs of the same model write identical name tables, so readers may
+// resolve a table once and reuse the result for later files.
+
+#define VL_COV_BINARY_MAGIC "VLCOVDB1"
+#define VL_COV_BINARY_ENDIAN 0x01020304
+
+//=============================================================================
+// VerilatedCovBinaryWriter - Binary coverage data encoder, shared by the
+// runtime and verilator_coverage so the two always agree
+
+class VerilatedCovBinaryWriter final {
+    std::string m_names;  ///< Name table
+    std::vector<vluint64_t> m_counts;  ///< Count of each point
+
+public:
+    /// Add a point; points are written in the order added
+    void add(const std::string& name, vluint64_t count) {
+        m_names += name;
+        m_names += '\0';
+        m_counts.push_back(count);
+    }
+    /// Write the points added
+    void write(std::ostream& os) const {
+        std::string names = m_names;
+        while (names.size() % 8) names += '\0';
+        const vluint32_t header[2] = {VL_COV_BINARY_ENDIAN, 0};
+        const vluint64_t sizes[2] = {m_counts.size(), names.size()};
+        os.write(VL_COV_BINARY_MAGIC, 8);
+        os.write(reinterpret_cast<const char*>(header), sizeof(header));
+        os.write(reinterpret_cast<const char*>(sizes), sizeof(sizes));
+        os.write(names.data(), names.size());
+        os.write(reinterpret_cast<const char*>(m_counts.data()),
+                 m_counts.size() * sizeof(vluint64_t));
+    }
+};
+
 #endif  // guard
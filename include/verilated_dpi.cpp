@@ -34,6 +34,14 @@
 
 #include "vltstd/svdpi.h"
 
+#include <algorithm>
+#include <cstring>
+#ifdef VL_THREADED
+# include <condition_variable>
+# include <deque>
+# include <thread>
+#endif
+
 //======================================================================
 // Internal macros
 
@@ -715,6 +723,293 @@ void svPutLogicArrElem3(const svOpenArrayHandle d, svLogic value, int indx1, int
     svPutBitArrElem3(d, value, indx1, indx2, indx3);
 }
 
+//======================================================================
+// Open array spans (Verilator extension)
+//
+// Access a run of first-dimension indices with one handle check and one
+// index computation, instead of one per element.  Elements of an open array
+// are stored in ascending index order, so a span is contiguous memory.
+
+/// Return pointer to index indx1 of first dimension, or nullptr if outside range.
+/// Sets indicesr to indices in span (count clipped to array end), elemsr to packed elements.
+static void* _vl_sv_span_datap(const VerilatedDpiOpenVar* varp, int indx1, int count,
+                               int& indicesr, size_t& elemsr) VL_MT_SAFE {
+    indicesr = 0;
+    elemsr = 0;
+    if (VL_UNLIKELY(varp->udims() < 1)) {
+        _VL_SVDPI_WARN("%%Warning: DPI svOpenArrayHandle span function called on"
+                       " array without unpacked dimensions.\n");
+        return nullptr;
+    }
+    void* datap = varp->datapAdjustIndex(varp->datap(), 1, indx1);
+    if (VL_UNLIKELY(!datap)) {
+        _VL_SVDPI_WARN("%%Warning: DPI svOpenArrayHandle span function index 1 "
+                       "out of bounds; %d outside [%d:%d].\n",
+                       indx1, varp->left(1), varp->right(1));
+        return nullptr;
+    }
+    indicesr = std::max(0, std::min(count, varp->high(1) - indx1 + 1));
+    elemsr = static_cast<size_t>(indicesr);
+    for (int d = 2; d <= varp->udims(); ++d) elemsr *= varp->elements(d);
+    return datap;
+}
+
+void* vl_sv_arr_span(const svOpenArrayHandle h, int indx1, int* countp,
+                     int* bytesp) VL_MT_SAFE {
+    const VerilatedDpiOpenVar* varp = _vl_openhandle_varp(h);
+    int indices;
+    size_t elems;
+    void* datap = _vl_sv_span_datap(varp, indx1, varp->elements(1), indices, elems);
+    if (countp) *countp = indices;
+    if (bytesp) *bytesp = datap ? static_cast<int>(varp->totalSize() / varp->elements(1)) : 0;
+    return datap;
+}
+
+template <class T_Data>
+static inline void _vl_sv_span_get(svBitVecVal* d, const void* datap, size_t elems) VL_PURE {
+    const T_Data* sp = static_cast<const T_Data*>(datap);
+    for (size_t i = 0; i < elems; ++i) d[i] = sp[i];
+}
+template <class T_Data>
+static inline void _vl_sv_span_put(void* datap, const svBitVecVal* s, size_t elems) VL_PURE {
+    T_Data* dp = static_cast<T_Data*>(datap);
+    for (size_t i = 0; i < elems; ++i) dp[i] = static_cast<T_Data>(s[i]);
+}
+
+int vl_sv_get_bit_arr_elems(svBitVecVal* d, const svOpenArrayHandle s, int indx1,
+                            int count) VL_MT_SAFE {
+    const VerilatedDpiOpenVar* varp = _vl_openhandle_varp(s);
+    int indices;
+    size_t elems;
+    const void* datap = _vl_sv_span_datap(varp, indx1, count, indices, elems);
+    if (VL_UNLIKELY(!datap)) return 0;
+    switch (varp->vltype()) {  // LCOV_EXCL_BR_LINE
+    case VLVT_UINT8: _vl_sv_span_get<CData>(d, datap, elems); break;
+    case VLVT_UINT16: _vl_sv_span_get<SData>(d, datap, elems); break;
+    case VLVT_UINT32: std::memcpy(d, datap, elems * sizeof(IData)); break;
+    case VLVT_UINT64: {
+        const QData* sp = static_cast<const QData*>(datap);
+        for (size_t i = 0; i < elems; ++i) VL_SET_WQ(d + 2 * i, sp[i]);
+        break;
+    }
+    case VLVT_WDATA:
+        std::memcpy(d, datap, elems * VL_WORDS_I(varp->packed().elements()) * sizeof(EData));
+        break;
+    default:  // LCOV_EXCL_START  // Errored earlier
+        _VL_SVDPI_WARN("%%Warning: DPI svOpenArrayHandle function unsupported datatype (%d).\n",
+                       varp->vltype());
+        return 0;  // LCOV_EXCL_STOP
+    }
+    return indices;
+}
+int vl_sv_put_bit_arr_elems(const svOpenArrayHandle d, const svBitVecVal* s, int indx1,
+                            int count) VL_MT_SAFE {
+    const VerilatedDpiOpenVar* varp = _vl_openhandle_varp(d);
+    int indices;
+    size_t elems;
+    void* datap = _vl_sv_span_datap(varp, indx1, count, indices, elems);
+    if (VL_UNLIKELY(!datap)) return 0;
+    switch (varp->vltype()) {  // LCOV_EXCL_BR_LINE
+    case VLVT_UINT8: _vl_sv_span_put<CData>(datap, s, elems); break;
+    case VLVT_UINT16: _vl_sv_span_put<SData>(datap, s, elems); break;
+    case VLVT_UINT32: std::memcpy(datap, s, elems * sizeof(IData)); break;
+    case VLVT_UINT64: {
+        QData* dp = static_cast<QData*>(datap);
+        for (size_t i = 0; i < elems; ++i) dp[i] = _VL_SET_QII(s[2 * i + 1], s[2 * i]);
+        break;
+    }
+    case VLVT_WDATA:
+        std::memcpy(datap, s, elems * VL_WORDS_I(varp->packed().elements()) * sizeof(EData));
+        break;
+    default:  // LCOV_EXCL_START  // Errored earlier
+        _VL_SVDPI_WARN("%%Warning: DPI svOpenArrayHandle function unsupported datatype (%d).\n",
+                       varp->vltype());
+        return 0;  // LCOV_EXCL_STOP
+    }
+    return indices;
+}
+int vl_sv_get_logic_arr_elems(svLogicVecVal* d, const svOpenArrayHandle s, int indx1,
+                              int count) VL_MT_SAFE {
+    const VerilatedDpiOpenVar* varp = _vl_openhandle_varp(s);
+    int indices;
+    size_t elems;
+    const void* datap = _vl_sv_span_datap(varp, indx1, count, indices, elems);
+    if (VL_UNLIKELY(!datap)) return 0;
+    // Verilator doesn't support X/Z so only aval
+    const size_t words = elems * (varp->vltype() == VLVT_WDATA
+                                      ? VL_WORDS_I(varp->packed().elements())
+                                      : varp->vltype() == VLVT_UINT64 ? 2 : 1);
+    switch (varp->vltype()) {  // LCOV_EXCL_BR_LINE
+    case VLVT_UINT8: {
+        const CData* sp = static_cast<const CData*>(datap);
+        for (size_t i = 0; i < words; ++i) d[i].aval = sp[i];
+        break;
+    }
+    case VLVT_UINT16: {
+        const SData* sp = static_cast<const SData*>(datap);
+        for (size_t i = 0; i < words; ++i) d[i].aval = sp[i];
+        break;
+    }
+    case VLVT_UINT32:
+    case VLVT_WDATA: {
+        const EData* sp = static_cast<const EData*>(datap);
+        for (size_t i = 0; i < words; ++i) d[i].aval = sp[i];
+        break;
+    }
+    case VLVT_UINT64: {
+        const QData* sp = static_cast<const QData*>(datap);
+        for (size_t i = 0; i < elems; ++i) {
+            d[2 * i].aval = static_cast<EData>(sp[i]);
+            d[2 * i + 1].aval = static_cast<EData>(sp[i] >> 32ULL);
+        }
+        break;
+    }
+    default:  // LCOV_EXCL_START  // Errored earlier
+        _VL_SVDPI_WARN("%%Warning: DPI svOpenArrayHandle function unsupported datatype (%d).\n",
+                       varp->vltype());
+        return 0;  // LCOV_EXCL_STOP
+    }
+    for (size_t i = 0; i < words; ++i) d[i].bval = 0;
+    return indices;
+}
+int vl_sv_put_logic_arr_elems(const svOpenArrayHandle d, const svLogicVecVal* s, int indx1,
+                              int count) VL_MT_SAFE {
+    const VerilatedDpiOpenVar* varp = _vl_openhandle_varp(d);
+    int indices;
+    size_t elems;
+    void* datap = _vl_sv_span_datap(varp, indx1, count, indices, elems);
+    if (VL_UNLIKELY(!datap)) return 0;
+    // Verilator doesn't support X/Z so only aval
+    switch (varp->vltype()) {  // LCOV_EXCL_BR_LINE
+    case VLVT_UINT8: {
+        CData* dp = static_cast<CData*>(datap);
+        for (size_t i = 0; i < elems; ++i) dp[i] = static_cast<CData>(s[i].aval);
+        break;
+    }
+    case VLVT_UINT16: {
+        SData* dp = static_cast<SData*>(datap);
+        for (size_t i = 0; i < elems; ++i) dp[i] = static_cast<SData>(s[i].aval);
+        break;
+    }
+    case VLVT_UINT32:
+    case VLVT_WDATA: {
+        const size_t words = elems * VL_WORDS_I(varp->packed().elements());
+        EData* dp = static_cast<EData*>(datap);
+        for (size_t i = 0; i < words; ++i) dp[i] = s[i].aval;
+        break;
+    }
+    case VLVT_UINT64: {
+        QData* dp = static_cast<QData*>(datap);
+        for (size_t i = 0; i < elems; ++i) dp[i] = _VL_SET_QII(s[2 * i + 1].aval, s[2 * i].aval);
+        break;
+    }
+    default:  // LCOV_EXCL_START  // Errored earlier
+        _VL_SVDPI_WARN("%%Warning: DPI svOpenArrayHandle function unsupported datatype (%d).\n",
+                       varp->vltype());
+        return 0;  // LCOV_EXCL_STOP
+    }
+    return indices;
+}
+
+//======================================================================
+// Asynchronous DPI import calls
+
+#ifdef VL_THREADED
+class VerilatedDpiAsyncImp final {
+    // MEMBERS
+    VerilatedMutex m_mutex;
+    std::condition_variable_any m_cv;  ///< Call posted, call returned, or closing
+    std::deque<std::function<void()>> m_calls VL_GUARDED_BY(m_mutex);  ///< Calls to run
+    vluint64_t m_posted VL_GUARDED_BY(m_mutex) = 0;  ///< Calls ever posted
+    vluint64_t m_returned VL_GUARDED_BY(m_mutex) = 0;  ///< Calls ever returned
+    bool m_closing VL_GUARDED_BY(m_mutex) = false;  ///< Worker should exit when idle
+    std::thread m_thread;  ///< Worker thread, started by first post
+    static VL_THREAD_LOCAL bool t_isWorker;  ///< This thread is the worker
+
+    // METHODS
+    void workerLoop() {
+        t_isWorker = true;
+        while (true) {
+            std::function<void()> call;
+            {
+                VerilatedLockGuard lock(m_mutex);
+                while (m_calls.empty() && !m_closing) m_cv.wait(lock);
+                if (m_calls.empty()) break;
+                call = std::move(m_calls.front());
+                m_calls.pop_front();
+            }
+            call();
+            {
+                VerilatedLockGuard lock(m_mutex);
+                ++m_returned;
+            }
+            m_cv.notify_all();
+        }
+    }
+    static void flushCb(void* impp) { static_cast<VerilatedDpiAsyncImp*>(impp)->flush(); }
+
+public:
+    // CONSTRUCTORS
+    VerilatedDpiAsyncImp() = default;
+    ~VerilatedDpiAsyncImp() {
+        if (!m_thread.joinable()) return;
+        {
+            VerilatedLockGuard lock(m_mutex);
+            m_closing = true;
+        }
+        m_cv.notify_all();
+        m_thread.join();
+    }
+    /// The queue and worker are shared by all models
+    static VerilatedDpiAsyncImp& s() VL_MT_SAFE {
+        static VerilatedDpiAsyncImp s_s;
+        return s_s;
+    }
+    // METHODS
+    void post(std::function<void()>&& call) VL_MT_SAFE {
+        bool start = false;
+        {
+            VerilatedLockGuard lock(m_mutex);
+            m_calls.push_back(std::move(call));
+            start = (m_posted++ == 0);
+            if (start) m_thread = std::thread(&VerilatedDpiAsyncImp::workerLoop, this);
+        }
+        if (VL_UNLIKELY(start)) Verilated::addFlushCb(&flushCb, this);
+        m_cv.notify_all();
+    }
+    void flush() VL_MT_SAFE {
+        if (t_isWorker) return;  // A posted call flushing would wait on itself
+        VerilatedLockGuard lock(m_mutex);
+        const vluint64_t posted = m_posted;
+        while (m_returned < posted) m_cv.wait(lock);
+    }
+};
+VL_THREAD_LOCAL bool VerilatedDpiAsyncImp::t_isWorker = false;
+#endif
+
+void VerilatedDpiAsync::post(std::function<void()>&& call) VL_MT_SAFE {
+#ifdef VL_THREADED
+    if (Verilated::mtaskId()) {
+        // Calls from an mtask reach the worker at the end of the eval, ordered
+        // by mtask then by posting order, as for $display messages.  So calls
+        // of independent mtasks run in the same order on every run.
+        VerilatedThreadMsgQueue::post(VerilatedMsg([call]() {  //
+            VerilatedDpiAsyncImp::s().post(std::function<void()>{call});
+        }));
+        return;
+    }
+    VerilatedDpiAsyncImp::s().post(std::move(call));
+#else
+    call();
+#endif
+}
+
+void VerilatedDpiAsync::flush() VL_MT_SAFE {
+#ifdef VL_THREADED
+    VerilatedDpiAsyncImp::s().flush();
+#endif
+}
+
 //======================================================================
 // Functions for working with DPI context
 
@@ -29,6 +29,8 @@
 
 #include "svdpi.h"
 
+#include <functional>
+
 //===================================================================
 // SETTING OPERATORS
 
@@ -87,6 +89,51 @@ static inline void VL_SET_SVLV_Q(int, svLogicVecVal* owp, QData ld) VL_MT_SAFE {
     owp[1].bval = 0;
 }
 
+//======================================================================
+// Open array spans (Verilator extension, not in IEEE svdpi.h)
+// These access indices [indx1, indx1 + count) of the first unpacked
+// dimension, checking the handle once per call rather than once per element.
+// Elements of inner dimensions are included in order, as if flattened.
+
+/// Return pointer to simulator storage of index indx1 of the first dimension,
+/// with *countp set to the number of indices from there to the end of the
+/// array, and *bytesp to the bytes per index; nullptr if outside range.
+/// Elements use Verilator's storage (CData/SData/IData/QData/EData[]),
+/// which is IEEE C layout only if svGetArrayPtr is non-null.
+extern void* vl_sv_arr_span(const svOpenArrayHandle h, int indx1, int* countp,
+                            int* bytesp) VL_MT_SAFE;
+
+/// Copy count indices to user canonical arrays from simulator open array,
+/// each element occupying SV_PACKED_DATA_NELEMS(width) words.
+/// Return the number of indices copied, less than count at the array end.
+extern int vl_sv_get_bit_arr_elems(svBitVecVal* d, const svOpenArrayHandle s, int indx1,
+                                   int count) VL_MT_SAFE;
+extern int vl_sv_get_logic_arr_elems(svLogicVecVal* d, const svOpenArrayHandle s, int indx1,
+                                     int count) VL_MT_SAFE;
+/// Copy count indices to simulator open array from user canonical arrays.
+/// Return the number of indices copied, less than count at the array end.
+extern int vl_sv_put_bit_arr_elems(const svOpenArrayHandle d, const svBitVecVal* s, int indx1,
+                                   int count) VL_MT_SAFE;
+extern int vl_sv_put_logic_arr_elems(const svOpenArrayHandle d, const svLogicVecVal* s,
+                                     int indx1, int count) VL_MT_SAFE;
+
+//======================================================================
+/// Calls to DPI imports marked /*verilator dpi_async*/.  Verilated code
+/// posts each call, with copies of its arguments, to a worker thread shared
+/// by all models.  Calls from mtasks reach the worker at the end of the
+/// eval, ordered by mtask and then by posting order, so the order is the
+/// same on every run.  Without VL_THREADED calls run immediately.
+
+class VerilatedDpiAsync final {
+public:
+    /// Run call on the worker thread, after calls this thread posted earlier
+    static void post(std::function<void()>&& call) VL_MT_SAFE;
+    /// Wait until all calls posted so far have returned.  Within an mtask
+    /// only calls of earlier evals are waited for.  Also done by
+    /// Verilated::runFlushCallbacks, so before $finish/$stop and at exit.
+    static void flush() VL_MT_SAFE;
+};
+
 //======================================================================
 
 #endif  // Guard
@@ -0,0 +1,112 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//=============================================================================
+//
+// THIS MODULE IS PUBLICLY LICENSED
+//
+// Copyright 2020 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//=============================================================================
+///
+/// \file
+/// \brief Verilator: $display format programs
+///
+/// Used both by Verilator, to pre-parse constant formats, and by the
+/// runtime, to parse other formats, so the two always agree.
+///
+//=============================================================================
+
+#ifndef _VERILATED_FMTPROG_H_
+#define _VERILATED_FMTPROG_H_ 1  ///< Header Guard
+
+#include "verilatedos.h"
+
+#include <string>
+
+// Format programs; a $display-like format pre-parsed so that no format
+// parsing happens when it is printed.  A program is a sequence of:
+//   VL_FMTPROG_TEXT, length, characters    Literal text
+//   format letter, flags, width            One argument, flags are VL_FMTPROG_*
+//     then for %e/%f/%g: length, characters of the printf format
+// ending with a zero byte.  Numbers are 7 bits per byte, least significant
+// first, with the top bit set when more bytes follow.
+#define VL_FMTPROG_TEXT 'T'
+#define VL_FMTPROG_WIDTHSET 0x1  ///< Width was given, %0x is minimum width
+#define VL_FMTPROG_LEFT 0x2  ///< Left justify
+#define VL_FMTPROG_ZERO 0x4  ///< Pad with zeros
+
+//=============================================================================
+// VerilatedFmtProg - Format program encoding
+
+class VerilatedFmtProg final {
+public:
+    /// Append a number to a program
+    static void appendNum(std::string& prog, size_t value) VL_PURE {
+        while (value >= 0x80) {
+            prog += static_cast<char>((value & 0x7f) | 0x80);
+            value >>= 7;
+        }
+        prog += static_cast<char>(value);
+    }
+    /// Read a number from a program, advancing posr past it
+    static size_t readNum(const char*& posr) VL_PURE {
+        size_t value = 0;
+        for (int shift = 0;; shift += 7) {
+            const unsigned char c = *posr++;
+            value |= static_cast<size_t>(c & 0x7f) << shift;
+            if (!(c & 0x80)) return value;
+        }
+    }
+    /// Compile a $write style format into prog
+    static void compile(std::string& prog, const char* formatp) VL_PURE {
+        prog.clear();
+        const char* pctp = nullptr;  // Most recent %##.##g format
+        bool inPct = false;
+        bool widthSet = false;
+        bool left = false;
+        size_t width = 0;
+        for (const char* pos = formatp; *pos; ++pos) {
+            if (!inPct && pos[0] == '%') {
+                pctp = pos;
+                inPct = true;
+                widthSet = false;
+                width = 0;
+            } else if (!inPct) {  // Normal text
+                const char* ep = pos;
+                while (ep[0] && ep[0] != '%') ep++;
+                prog += VL_FMTPROG_TEXT;
+                appendNum(prog, ep - pos);
+                prog.append(pos, ep - pos);
+                pos = ep - 1;
+            } else if (pos[0] >= '0' && pos[0] <= '9') {
+                widthSet = true;
+                width = width * 10 + (pos[0] - '0');
+            } else if (pos[0] == '-') {
+                left = true;
+            } else if (pos[0] == '.') {
+            } else {
+                inPct = false;
+                if (pos[0] == '%') {
+                    prog += VL_FMTPROG_TEXT;
+                    appendNum(prog, 1);
+                    prog += '%';
+                    continue;
+                }
+                prog += pos[0];
+                prog += static_cast<char>((widthSet ? VL_FMTPROG_WIDTHSET : 0)
+                                          | (left ? VL_FMTPROG_LEFT : 0)
+                                          | (pctp[1] == '0' ? VL_FMTPROG_ZERO : 0));
+                appendNum(prog, width);
+                if (pos[0] == 'e' || pos[0] == 'f' || pos[0] == 'g') {
+                    appendNum(prog, pos - pctp + 1);
+                    prog.append(pctp, pos - pctp + 1);
+                }
+            }
+        }
+    }
+};
+
+#endif  // Guard
@@ -28,11 +28,15 @@
 
 #include <algorithm>
 #include <deque>
+#include <functional>
+#include <iterator>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <type_traits>
 #include <unordered_set>
+#include <vector>
 
 //===================================================================
 // String formatters (required by below containers)
@@ -48,11 +52,28 @@ extern std::string VL_TO_STRING_W(int words, WDataInP obj);
 // Shuffle RNG
 
 class VlURNG final {
+    // MEMBERS
+    WDataOutP m_statep = nullptr;  // Random stream (--rand-streams), else nullptr
+    vluint64_t m_values[8];  // Values drawn in a batch from m_statep
+    int m_next = 8;  // Next unused entry in m_values
+
 public:
     typedef size_t result_type;
+    // CONSTRUCTORS
+    VlURNG() = default;
+    explicit VlURNG(WDataOutP statep)
+        : m_statep{statep} {}
+    // METHODS
     static constexpr size_t min() { return 0; }
     static constexpr size_t max() { return 1ULL << 31; }
-    size_t operator()() { return VL_MASK_I(31) & VL_RANDOM_I(32); }
+    size_t operator()() {
+        if (!m_statep) return VL_MASK_I(31) & VL_RANDOM_I(32);
+        if (VL_UNLIKELY(m_next == 8)) {
+            vl_rand_stream_fill(m_statep, m_values, 8);
+            m_next = 0;
+        }
+        return VL_MASK_I(31) & m_values[m_next++];
+    }
 };
 
 //===================================================================
@@ -63,16 +84,36 @@ class VlReadMem final {
     int m_bits;  // Bit width of values
     const std::string& m_filename;  // Filename
     QData m_end;  // End address (as specified by user)
-    FILE* m_fp;  // File handle for filename
     QData m_addr;  // Next address to read
     int m_linenum;  // Line number last read from file
+    char* m_mapp = nullptr;  // File contents, mapped or read into memory
+    size_t m_mapSize = 0;  // Size of m_mapp
+    bool m_mapped = false;  // m_mapp is mmapped, else heap allocated
+    const char* m_cp = nullptr;  // Current parse position
+    const char* m_endp = nullptr;  // End of contents to parse
+    const char* m_valuep = nullptr;  // Start of value found by next()
+    const char* m_valueEndp = nullptr;  // End of value found by next()
+    bool m_valuePlain = false;  // Value found by next() has no x or _ characters
+    size_t m_imageRowBytes = 0;  // Bytes per row when binary image, else 0 for text
+    // View parsing [beginp, endp) of parent's contents, for chunked loading
+    VlReadMem(const VlReadMem& parent, const char* beginp, const char* endp, QData addr,
+              int linenum);
+    size_t rowBytes() const;
+    void maskRow(void* valuep) const;
+    void checkEnd();
+    bool fillChunked(QData depth, int array_lsb, void* memp);
+
 public:
     VlReadMem(bool hex, int bits, const std::string& filename, QData start, QData end);
     ~VlReadMem();
-    bool isOpen() const { return m_fp != nullptr; }
+    bool isOpen() const { return m_cp != nullptr; }
     int linenum() const { return m_linenum; }
-    bool get(QData& addrr, std::string& valuer);
-    void setData(void* valuep, const std::string& rhs);
+    // Find next value, returning its address; false at end of file
+    bool next(QData& addrr);
+    // Store value found by last next() into valuep, which has m_bits width
+    void setNext(void* valuep);
+    // Load whole file into flat array memp with given depth and first address
+    void fill(QData depth, int array_lsb, void* memp);
 };
 
 class VlWriteMem final {
@@ -80,6 +121,10 @@ class VlWriteMem final {
     int m_bits;  // Bit width of values
     FILE* m_fp;  // File handle for filename
     QData m_addr;  // Next address to write
+    std::string m_filename;  // Filename
+    size_t m_imageRowBytes = 0;  // Bytes per row when writing binary image, else 0 for text
+    QData m_imageAddr = 0;  // First address in binary image
+    QData m_imageRows = 0;  // Rows written to binary image
 public:
     VlWriteMem(bool hex, int bits, const std::string& filename, QData start, QData end);
     ~VlWriteMem();
@@ -132,6 +177,260 @@ template <std::size_t T_Words> std::string VL_TO_STRING(const VlWide<T_Words>& o
     return VL_TO_STRING_W(T_Words, obj.data());
 }
 
+//===================================================================
+// Ring buffer backing VlQueue
+// Elements are contiguous and wrap at the capacity, so a small
+// push_back/pop_front FIFO stays within one block. The first s_inline
+// elements are held inside the object; a bounded queue whose bound fits
+// is entirely inline and never allocates.
+
+template <class T_Value, size_t T_MaxSize = 0> class VlQueueRing final {
+public:
+    // Elements held within the object
+    static constexpr size_t s_inline
+        = (T_MaxSize != 0 && T_MaxSize * sizeof(T_Value) <= 4096)
+              ? T_MaxSize
+              : (sizeof(T_Value) >= 64 ? 1 : 64 / sizeof(T_Value));
+
+    template <bool T_Const> class Iter final {
+        friend class VlQueueRing;
+        template <bool> friend class Iter;
+        typedef typename std::conditional<T_Const, const VlQueueRing, VlQueueRing>::type RingT;
+        RingT* m_ringp = nullptr;
+        std::ptrdiff_t m_index = 0;
+        Iter(RingT* ringp, std::ptrdiff_t index)
+            : m_ringp{ringp}
+            , m_index{index} {}
+
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef T_Value value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::conditional<T_Const, const T_Value, T_Value>::type& reference;
+        typedef typename std::conditional<T_Const, const T_Value, T_Value>::type* pointer;
+        Iter() = default;
+        operator Iter<true>() const { return Iter<true>(m_ringp, m_index); }
+        reference operator*() const { return (*m_ringp)[m_index]; }
+        pointer operator->() const { return &(*m_ringp)[m_index]; }
+        reference operator[](difference_type n) const { return (*m_ringp)[m_index + n]; }
+        Iter& operator++() {
+            ++m_index;
+            return *this;
+        }
+        Iter& operator--() {
+            --m_index;
+            return *this;
+        }
+        Iter operator++(int) { return Iter(m_ringp, m_index++); }
+        Iter operator--(int) { return Iter(m_ringp, m_index--); }
+        Iter& operator+=(difference_type n) {
+            m_index += n;
+            return *this;
+        }
+        Iter& operator-=(difference_type n) {
+            m_index -= n;
+            return *this;
+        }
+        Iter operator+(difference_type n) const { return Iter(m_ringp, m_index + n); }
+        Iter operator-(difference_type n) const { return Iter(m_ringp, m_index - n); }
+        friend Iter operator+(difference_type n, const Iter& it) { return it + n; }
+        difference_type operator-(const Iter& rhs) const { return m_index - rhs.m_index; }
+        bool operator==(const Iter& rhs) const { return m_index == rhs.m_index; }
+        bool operator!=(const Iter& rhs) const { return m_index != rhs.m_index; }
+        bool operator<(const Iter& rhs) const { return m_index < rhs.m_index; }
+        bool operator>(const Iter& rhs) const { return m_index > rhs.m_index; }
+        bool operator<=(const Iter& rhs) const { return m_index <= rhs.m_index; }
+        bool operator>=(const Iter& rhs) const { return m_index >= rhs.m_index; }
+    };
+    typedef Iter<false> iterator;
+    typedef Iter<true> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+private:
+    // MEMBERS
+    T_Value* m_datap;  // Element storage, m_inline or m_heapp
+    size_t m_cap = s_inline;  // Elements m_datap can hold
+    size_t m_head = 0;  // Slot of front()
+    size_t m_size = 0;  // Elements in use
+    std::unique_ptr<T_Value[]> m_heapp;  // Storage once grown beyond m_inline
+    T_Value m_inline[s_inline];  // Storage for small queues
+
+    size_t slot(size_t index) const {
+        const size_t pos = m_head + index;
+        return pos >= m_cap ? pos - m_cap : pos;
+    }
+    static void release(T_Value& value) {
+        // Drop what a vacated slot holds, e.g. string storage
+        if (!std::is_trivially_destructible<T_Value>::value) value = T_Value();
+    }
+    void grow(size_t want) {
+        size_t cap = m_cap * 2;
+        if (cap < want) cap = want;
+        if (T_MaxSize != 0 && cap > T_MaxSize) cap = T_MaxSize;
+        std::unique_ptr<T_Value[]> heapp{new T_Value[cap]};
+        for (size_t i = 0; i < m_size; ++i) {
+            T_Value& from = (*this)[i];
+            heapp[i] = std::move(from);
+            release(from);
+        }
+        m_heapp = std::move(heapp);
+        m_datap = m_heapp.get();
+        m_cap = cap;
+        m_head = 0;
+    }
+    void resetInline() {
+        m_heapp.reset();
+        m_datap = m_inline;
+        m_cap = s_inline;
+        m_head = 0;
+        m_size = 0;
+    }
+    void moveFrom(VlQueueRing& rhs) {
+        // Requires this be empty
+        if (rhs.m_heapp) {
+            m_heapp = std::move(rhs.m_heapp);
+            m_datap = m_heapp.get();
+            m_cap = rhs.m_cap;
+            m_head = rhs.m_head;
+            m_size = rhs.m_size;
+        } else {
+            reserve(rhs.m_size);
+            for (size_t i = 0; i < rhs.m_size; ++i) {
+                T_Value& from = rhs[i];
+                m_datap[i] = std::move(from);
+                release(from);
+            }
+            m_size = rhs.m_size;
+        }
+        rhs.resetInline();
+    }
+
+public:
+    // CONSTRUCTORS
+    VlQueueRing()
+        : m_datap{m_inline} {}
+    ~VlQueueRing() = default;
+    VlQueueRing(const VlQueueRing& rhs)
+        : m_datap{m_inline} {
+        assign(rhs.begin(), rhs.size());
+    }
+    VlQueueRing(VlQueueRing&& rhs)
+        : m_datap{m_inline} {
+        moveFrom(rhs);
+    }
+    VlQueueRing& operator=(const VlQueueRing& rhs) {
+        if (this != &rhs) assign(rhs.begin(), rhs.size());
+        return *this;
+    }
+    VlQueueRing& operator=(VlQueueRing&& rhs) {
+        if (this != &rhs) {
+            clear();
+            m_head = 0;
+            moveFrom(rhs);
+        }
+        return *this;
+    }
+
+    // METHODS
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    T_Value& operator[](size_t index) { return m_datap[slot(index)]; }
+    const T_Value& operator[](size_t index) const { return m_datap[slot(index)]; }
+    T_Value& front() { return m_datap[m_head]; }
+    const T_Value& front() const { return m_datap[m_head]; }
+    T_Value& back() { return (*this)[m_size - 1]; }
+    const T_Value& back() const { return (*this)[m_size - 1]; }
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, m_size); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, m_size); }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    void reserve(size_t want) {
+        if (want > m_cap) grow(want);
+    }
+    void clear() {
+        for (size_t i = 0; i < m_size; ++i) release((*this)[i]);
+        m_size = 0;
+    }
+    // Replace contents with count elements starting at first
+    template <class T_Iter> void assign(T_Iter first, size_t count) {
+        clear();
+        m_head = 0;
+        if (T_MaxSize != 0 && count > T_MaxSize) count = T_MaxSize;
+        reserve(count);
+        for (size_t i = 0; i < count; ++i, ++first) m_datap[i] = *first;
+        m_size = count;
+    }
+    void resize(size_t count, const T_Value& value = T_Value()) {
+        if (T_MaxSize != 0 && count > T_MaxSize) count = T_MaxSize;
+        while (m_size > count) pop_back();
+        if (m_size < count) {
+            const T_Value fill = value;  // value may be an element that moves
+            reserve(count);
+            while (m_size < count) (*this)[m_size++] = fill;
+        }
+    }
+    void push_back(const T_Value& value) {
+        if (VL_UNLIKELY(m_size == m_cap)) {
+            const T_Value fill = value;
+            grow(m_size + 1);
+            (*this)[m_size++] = fill;
+        } else {
+            (*this)[m_size++] = value;
+        }
+    }
+    void push_front(const T_Value& value) {
+        if (VL_UNLIKELY(m_size == m_cap)) {
+            const T_Value fill = value;
+            grow(m_size + 1);
+            m_head = m_cap - 1;
+            m_datap[m_head] = fill;
+        } else {
+            m_head = m_head ? m_head - 1 : m_cap - 1;
+            m_datap[m_head] = value;
+        }
+        ++m_size;
+    }
+    void pop_front() {
+        release(m_datap[m_head]);
+        if (++m_head == m_cap) m_head = 0;
+        --m_size;
+    }
+    void pop_back() {
+        release(back());
+        --m_size;
+    }
+    // Insert before element index, shifting whichever side is shorter
+    void insert(size_t index, const T_Value& value) {
+        const T_Value fill = value;
+        if (index < m_size / 2) {
+            push_front(fill);
+            for (size_t i = 0; i < index; ++i) (*this)[i] = std::move((*this)[i + 1]);
+        } else {
+            push_back(fill);
+            for (size_t i = m_size - 1; i > index; --i) (*this)[i] = std::move((*this)[i - 1]);
+        }
+        (*this)[index] = fill;
+    }
+    // Remove element index, shifting whichever side is shorter
+    void erase(size_t index) {
+        if (index < m_size / 2) {
+            for (size_t i = index; i > 0; --i) (*this)[i] = std::move((*this)[i - 1]);
+            pop_front();
+        } else {
+            for (size_t i = index; i + 1 < m_size; ++i) (*this)[i] = std::move((*this)[i + 1]);
+            pop_back();
+        }
+    }
+};
+template <class T_Value, size_t T_MaxSize>
+constexpr size_t VlQueueRing<T_Value, T_MaxSize>::s_inline;
+
 //===================================================================
 // Verilog queue and dynamic array container
 // There are no multithreaded locks on this; the base variable must
@@ -142,14 +441,14 @@ template <std::size_t T_Words> std::string VL_TO_STRING(const VlWide<T_Words>& o
 template <class T_Value, size_t T_MaxSize = 0> class VlQueue final {
 private:
     // TYPES
-    typedef std::deque<T_Value> Deque;
+    typedef VlQueueRing<T_Value, T_MaxSize> Deque;
 
 public:
     typedef typename Deque::const_iterator const_iterator;
 
 private:
     // MEMBERS
-    Deque m_deque;  // State of the assoc array
+    Deque m_deque;  // State of the queue
     T_Value m_defaultValue;  // Default value
 
 public:
@@ -165,8 +464,9 @@ public:
     // Standard copy constructor works. Verilog: assoca = assocb
     // Also must allow conversion from a different T_MaxSize queue
     template <size_t U_MaxSize = 0> VlQueue operator=(const VlQueue<T_Value, U_MaxSize>& rhs) {
-        m_deque = rhs.privateDeque();
-        if (VL_UNLIKELY(T_MaxSize && T_MaxSize < m_deque.size())) m_deque.resize(T_MaxSize - 1);
+        size_t count = rhs.privateDeque().size();
+        if (VL_UNLIKELY(T_MaxSize && T_MaxSize < count)) count = T_MaxSize - 1;
+        m_deque.assign(rhs.privateDeque().begin(), count);
         return *this;
     }
 
@@ -208,7 +508,7 @@ public:
     void clear() { m_deque.clear(); }
     void erase(vlsint32_t index) {
         if (VL_LIKELY(index >= 0 && index < m_deque.size()))
-            m_deque.erase(m_deque.begin() + index);
+            m_deque.erase(index);
     }
 
     // Dynamic array new[] becomes a renew()
@@ -228,8 +528,13 @@ public:
 
     // function void q.push_front(value)
     void push_front(const T_Value& value) {
-        m_deque.push_front(value);
-        if (VL_UNLIKELY(T_MaxSize != 0 && m_deque.size() > T_MaxSize)) m_deque.pop_back();
+        if (VL_UNLIKELY(T_MaxSize != 0 && m_deque.size() >= T_MaxSize)) {
+            const T_Value keep = value;  // May be the element dropped
+            m_deque.pop_back();
+            m_deque.push_front(keep);
+        } else {
+            m_deque.push_front(value);
+        }
     }
     // function void q.push_back(value)
     void push_back(const T_Value& value) {
@@ -276,7 +581,13 @@ public:
     // function void q.insert(index, value);
     void insert(vlsint32_t index, const T_Value& value) {
         if (VL_UNLIKELY(index < 0 || index >= m_deque.size())) return;
-        m_deque.insert(m_deque.begin() + index, value);
+        if (VL_UNLIKELY(T_MaxSize != 0 && m_deque.size() >= T_MaxSize)) {
+            const T_Value keep = value;  // May be the element dropped
+            m_deque.pop_back();
+            m_deque.insert(index, keep);
+        } else {
+            m_deque.insert(index, value);
+        }
     }
 
     // Return slice q[lsb:msb]
@@ -312,6 +623,9 @@ public:
     }
     void reverse() { std::reverse(m_deque.begin(), m_deque.end()); }
     void shuffle() { std::shuffle(m_deque.begin(), m_deque.end(), VlURNG()); }
+    void shuffle(WDataOutP statep) {
+        std::shuffle(m_deque.begin(), m_deque.end(), VlURNG(statep));
+    }
     VlQueue unique() const {
         VlQueue out;
         std::unordered_set<T_Value> saw;
@@ -489,15 +803,428 @@ template <class T_Value> std::string VL_TO_STRING(const VlQueue<T_Value>& obj) {
     return obj.to_string();
 }
 
+//===================================================================
+// Backing stores for VlAssocArray
+// Each provides the subset of the std::map interface VlAssocArray uses;
+// references to values remain valid until that element is erased.
+// Verilator picks the backing for each array from how the array is used.
+
+/// Ordered backing, for any key type
+struct VlAssocOrdered final {
+    template <class T_Key, class T_Value> using Map = std::map<T_Key, T_Value>;
+};
+
+inline vluint64_t vl_assoc_hash(vluint64_t key) VL_PURE {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    return key;
+}
+inline vluint64_t vl_assoc_hash(const std::string& key) VL_PURE {
+    return std::hash<std::string>()(key);
+}
+
+/// Open-addressing hash map, for arrays never iterated in index order.
+/// Iteration is in an arbitrary order, so first/next/last/prev are not
+/// meaningful and reverse iteration is not provided.
+template <class T_Key, class T_Value> class VlAssocHashMap final {
+public:
+    // TYPES
+    typedef std::pair<T_Key, T_Value> value_type;
+
+private:
+    struct Entry {
+        value_type m_kv;  // Key and value
+        bool m_live;  // Entry is in use, else on m_free list
+    };
+    typedef std::deque<Entry> Entries;  // Deque, so references survive growth
+
+public:
+    template <bool T_Const> class Iter final {
+        friend class VlAssocHashMap;
+        template <bool> friend class Iter;
+        typedef typename std::conditional<T_Const, const Entries, Entries>::type EntriesT;
+        EntriesT* m_entriesp = nullptr;
+        size_t m_index = 0;
+        Iter(EntriesT* entriesp, size_t index)
+            : m_entriesp{entriesp}
+            , m_index{index} {
+            skipDead();
+        }
+        void skipDead() {
+            while (m_index < m_entriesp->size() && !(*m_entriesp)[m_index].m_live) ++m_index;
+        }
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef VlAssocHashMap::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::conditional<T_Const, const value_type, value_type>::type& reference;
+        typedef typename std::conditional<T_Const, const value_type, value_type>::type* pointer;
+        Iter() = default;
+        operator Iter<true>() const { return Iter<true>(m_entriesp, m_index); }
+        reference operator*() const { return (*m_entriesp)[m_index].m_kv; }
+        pointer operator->() const { return &(*m_entriesp)[m_index].m_kv; }
+        Iter& operator++() {
+            ++m_index;
+            skipDead();
+            return *this;
+        }
+        Iter operator++(int) {
+            Iter old = *this;
+            ++*this;
+            return old;
+        }
+        bool operator==(const Iter& rhs) const { return m_index == rhs.m_index; }
+        bool operator!=(const Iter& rhs) const { return m_index != rhs.m_index; }
+    };
+    typedef Iter<false> iterator;
+    typedef Iter<true> const_iterator;
+
+private:
+    // MEMBERS
+    Entries m_entries;  // Elements, in insertion order with erased indices reused
+    std::vector<vluint32_t> m_slots;  // Hash table; entry index + 1, or 0 if empty
+    std::vector<vluint32_t> m_free;  // Indices of dead m_entries
+    size_t m_size = 0;  // Live elements
+
+    size_t slotOf(const T_Key& key) const { return vl_assoc_hash(key) & (m_slots.size() - 1); }
+    size_t findSlot(const T_Key& key) const {
+        // Return slot holding key, or the empty slot ending its probe sequence
+        const size_t mask = m_slots.size() - 1;
+        size_t slot = slotOf(key);
+        while (m_slots[slot] && !(m_entries[m_slots[slot] - 1].m_kv.first == key)) {
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+    void grow() {
+        std::vector<vluint32_t> slots(m_slots.empty() ? 16 : m_slots.size() * 2, 0);
+        m_slots.swap(slots);
+        const size_t mask = m_slots.size() - 1;
+        for (vluint32_t entry : slots) {
+            if (!entry) continue;
+            size_t slot = slotOf(m_entries[entry - 1].m_kv.first);
+            while (m_slots[slot]) slot = (slot + 1) & mask;
+            m_slots[slot] = entry;
+        }
+    }
+
+public:
+    // METHODS
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    void clear() {
+        m_entries.clear();
+        m_slots.clear();
+        m_free.clear();
+        m_size = 0;
+    }
+    iterator begin() { return iterator(&m_entries, 0); }
+    iterator end() { return iterator(&m_entries, m_entries.size()); }
+    const_iterator begin() const { return const_iterator(&m_entries, 0); }
+    const_iterator end() const { return const_iterator(&m_entries, m_entries.size()); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    iterator find(const T_Key& key) {
+        if (m_slots.empty()) return end();
+        const size_t slot = findSlot(key);
+        return m_slots[slot] ? iterator(&m_entries, m_slots[slot] - 1) : end();
+    }
+    const_iterator find(const T_Key& key) const {
+        if (m_slots.empty()) return end();
+        const size_t slot = findSlot(key);
+        return m_slots[slot] ? const_iterator(&m_entries, m_slots[slot] - 1) : end();
+    }
+    std::pair<iterator, bool> emplace(const T_Key& key, const T_Value& value) {
+        if ((m_size + 1) * 2 > m_slots.size()) grow();  // Keep load under 1/2
+        const size_t slot = findSlot(key);
+        if (m_slots[slot]) return std::make_pair(iterator(&m_entries, m_slots[slot] - 1), false);
+        vluint32_t entry;
+        if (m_free.empty()) {
+            entry = m_entries.size();
+            m_entries.push_back(Entry{value_type(key, value), true});
+        } else {
+            entry = m_free.back();
+            m_free.pop_back();
+            m_entries[entry] = Entry{value_type(key, value), true};
+        }
+        m_slots[slot] = entry + 1;
+        ++m_size;
+        return std::make_pair(iterator(&m_entries, entry), true);
+    }
+    size_t erase(const T_Key& key) {
+        if (m_slots.empty()) return 0;
+        size_t slot = findSlot(key);
+        if (!m_slots[slot]) return 0;
+        const vluint32_t entry = m_slots[slot] - 1;
+        m_entries[entry] = Entry{value_type(), false};  // Release value now
+        m_free.push_back(entry);
+        if (--m_size == 0) {
+            clear();
+            return 1;
+        }
+        // Backward shift deletion, so no tombstones are needed
+        const size_t mask = m_slots.size() - 1;
+        size_t next = slot;
+        while (true) {
+            next = (next + 1) & mask;
+            if (!m_slots[next]) break;
+            const size_t home = slotOf(m_entries[m_slots[next] - 1].m_kv.first);
+            // Move up unless home lies cyclically in (slot, next]
+            const bool stays = (slot <= next) ? (slot < home && home <= next)
+                                              : (slot < home || home <= next);
+            if (!stays) {
+                m_slots[slot] = m_slots[next];
+                slot = next;
+            }
+        }
+        m_slots[slot] = 0;
+        return 1;
+    }
+};
+
+/// Hash backing, for arrays never iterated in index order
+struct VlAssocHash final {
+    template <class T_Key, class T_Value> using Map = VlAssocHashMap<T_Key, T_Value>;
+};
+
+/// Sparse paged array, for integral keys, e.g. large sparse memories.
+/// Keys are kept in pages of PAGE_SIZE neighboring keys, so accesses near the
+/// previous one need no tree search, and iteration is in key order.
+template <class T_Key, class T_Value> class VlAssocPagedMap final {
+public:
+    // TYPES
+    typedef std::pair<T_Key, T_Value> value_type;
+
+private:
+    static constexpr int PAGE_BITS = 6;  // One m_used word per page
+    static constexpr int PAGE_SIZE = 1 << PAGE_BITS;
+    struct Page {
+        vluint64_t m_used = 0;  // Bit per slot of m_kvs holding an element
+        value_type m_kvs[PAGE_SIZE];
+    };
+    typedef std::map<T_Key, std::unique_ptr<Page>> Pages;  // Key is key >> PAGE_BITS
+    typedef typename Pages::iterator PagesIt;
+
+    static int lowestBit(vluint64_t bits) {
+#ifdef __GNUC__
+        return __builtin_ctzll(bits);
+#else
+        int bit = 0;
+        while (!(bits & 1ULL)) {
+            bits >>= 1;
+            ++bit;
+        }
+        return bit;
+#endif
+    }
+    static int highestBit(vluint64_t bits) {
+#ifdef __GNUC__
+        return 63 - __builtin_clzll(bits);
+#else
+        int bit = 63;
+        while (!(bits & (1ULL << 63))) {
+            bits <<= 1;
+            --bit;
+        }
+        return bit;
+#endif
+    }
+
+public:
+    template <bool T_Const> class Iter final {
+        friend class VlAssocPagedMap;
+        template <bool> friend class Iter;
+        PagesIt m_it;  // Page
+        PagesIt m_endIt;  // Pages end(), for decrement from end
+        int m_slot = 0;  // Slot in page
+        Iter(PagesIt it, PagesIt endIt, int slot)
+            : m_it{it}
+            , m_endIt{endIt}
+            , m_slot{slot} {}
+
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef VlAssocPagedMap::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::conditional<T_Const, const value_type, value_type>::type& reference;
+        typedef typename std::conditional<T_Const, const value_type, value_type>::type* pointer;
+        Iter() = default;
+        operator Iter<true>() const { return Iter<true>(m_it, m_endIt, m_slot); }
+        reference operator*() const { return m_it->second->m_kvs[m_slot]; }
+        pointer operator->() const { return &m_it->second->m_kvs[m_slot]; }
+        Iter& operator++() {
+            // ~((2 << slot) - 1) is zero for slot 63, as unsigned wraps
+            const vluint64_t above = m_it->second->m_used & ~((2ULL << m_slot) - 1ULL);
+            if (above) {
+                m_slot = lowestBit(above);
+            } else if (++m_it != m_endIt) {
+                m_slot = lowestBit(m_it->second->m_used);
+            } else {
+                m_slot = 0;
+            }
+            return *this;
+        }
+        Iter& operator--() {
+            const vluint64_t below
+                = (m_it == m_endIt) ? 0 : (m_it->second->m_used & ((1ULL << m_slot) - 1ULL));
+            if (below) {
+                m_slot = highestBit(below);
+            } else {
+                --m_it;
+                m_slot = highestBit(m_it->second->m_used);
+            }
+            return *this;
+        }
+        Iter operator++(int) {
+            Iter old = *this;
+            ++*this;
+            return old;
+        }
+        Iter operator--(int) {
+            Iter old = *this;
+            --*this;
+            return old;
+        }
+        bool operator==(const Iter& rhs) const {
+            return m_it == rhs.m_it && m_slot == rhs.m_slot;
+        }
+        bool operator!=(const Iter& rhs) const { return !(*this == rhs); }
+    };
+    typedef Iter<false> iterator;
+    typedef Iter<true> const_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+private:
+    // MEMBERS
+    Pages m_pages;  // Pages holding at least one element, by page number
+    size_t m_size = 0;  // Elements
+    mutable PagesIt m_lastIt;  // Page last found, if m_lastValid
+    mutable bool m_lastValid = false;
+
+    PagesIt pageFind(T_Key pageNum) const {
+        // Pages is logically const here; only m_lastIt is updated
+        Pages& pages = const_cast<Pages&>(m_pages);
+        if (m_lastValid && m_lastIt->first == pageNum) return m_lastIt;
+        const PagesIt it = pages.find(pageNum);
+        if (it != pages.end()) {
+            m_lastIt = it;
+            m_lastValid = true;
+        }
+        return it;
+    }
+    PagesIt pagesEnd() const { return const_cast<Pages&>(m_pages).end(); }
+    PagesIt pagesBegin() const { return const_cast<Pages&>(m_pages).begin(); }
+
+public:
+    // CONSTRUCTORS
+    VlAssocPagedMap() = default;
+    VlAssocPagedMap(const VlAssocPagedMap& rhs) { *this = rhs; }
+    VlAssocPagedMap(VlAssocPagedMap&& rhs)
+        : m_pages(std::move(rhs.m_pages))
+        , m_size{rhs.m_size} {
+        rhs.clear();
+    }
+    VlAssocPagedMap& operator=(const VlAssocPagedMap& rhs) {
+        if (this == &rhs) return *this;
+        clear();
+        for (const auto& it : rhs.m_pages) m_pages.emplace(it.first, new Page(*it.second));
+        m_size = rhs.m_size;
+        return *this;
+    }
+    VlAssocPagedMap& operator=(VlAssocPagedMap&& rhs) {
+        // Last page found is not kept, as m_lastIt may be into our old pages
+        if (this == &rhs) return *this;
+        m_pages = std::move(rhs.m_pages);
+        m_size = rhs.m_size;
+        m_lastValid = false;
+        rhs.clear();
+        return *this;
+    }
+
+    // METHODS
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    void clear() {
+        m_pages.clear();
+        m_size = 0;
+        m_lastValid = false;
+    }
+    const_iterator begin() const {
+        const PagesIt it = pagesBegin();
+        const int slot = (it == pagesEnd()) ? 0 : lowestBit(it->second->m_used);
+        return const_iterator(it, pagesEnd(), slot);
+    }
+    const_iterator end() const { return const_iterator(pagesEnd(), pagesEnd(), 0); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    iterator end() { return iterator(m_pages.end(), m_pages.end(), 0); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const { return rbegin(); }
+    const_reverse_iterator crend() const { return rend(); }
+    const_iterator find(const T_Key& key) const {
+        const PagesIt it = pageFind(key >> PAGE_BITS);
+        const int slot = key & (PAGE_SIZE - 1);
+        if (it == pagesEnd() || !((it->second->m_used >> slot) & 1ULL)) return end();
+        return const_iterator(it, pagesEnd(), slot);
+    }
+    iterator find(const T_Key& key) {
+        const PagesIt it = pageFind(key >> PAGE_BITS);
+        const int slot = key & (PAGE_SIZE - 1);
+        if (it == pagesEnd() || !((it->second->m_used >> slot) & 1ULL)) return end();
+        return iterator(it, pagesEnd(), slot);
+    }
+    std::pair<iterator, bool> emplace(const T_Key& key, const T_Value& value) {
+        const T_Key pageNum = key >> PAGE_BITS;
+        PagesIt it = pageFind(pageNum);
+        if (it == m_pages.end()) {
+            it = m_pages.emplace(pageNum, std::unique_ptr<Page>(new Page)).first;
+            m_lastIt = it;
+            m_lastValid = true;
+        }
+        const int slot = key & (PAGE_SIZE - 1);
+        Page* const pagep = it->second.get();
+        const bool inserted = !((pagep->m_used >> slot) & 1ULL);
+        if (inserted) {
+            pagep->m_used |= 1ULL << slot;
+            pagep->m_kvs[slot] = value_type(key, value);
+            ++m_size;
+        }
+        return std::make_pair(iterator(it, m_pages.end(), slot), inserted);
+    }
+    size_t erase(const T_Key& key) {
+        const PagesIt it = pageFind(key >> PAGE_BITS);
+        const int slot = key & (PAGE_SIZE - 1);
+        if (it == m_pages.end() || !((it->second->m_used >> slot) & 1ULL)) return 0;
+        Page* const pagep = it->second.get();
+        pagep->m_used &= ~(1ULL << slot);
+        pagep->m_kvs[slot] = value_type();  // Release value now
+        --m_size;
+        if (!pagep->m_used) {
+            m_lastValid = false;
+            m_pages.erase(it);
+        }
+        return 1;
+    }
+};
+
+/// Paged backing, for integral keys
+struct VlAssocPaged final {
+    template <class T_Key, class T_Value> using Map = VlAssocPagedMap<T_Key, T_Value>;
+};
+
 //===================================================================
 // Verilog associative array container
 // There are no multithreaded locks on this; the base variable must
 // be protected by other means
 //
-template <class T_Key, class T_Value> class VlAssocArray final {
+template <class T_Key, class T_Value, class T_Backing = VlAssocOrdered>
+class VlAssocArray final {
 private:
     // TYPES
-    typedef std::map<T_Key, T_Value> Map;
+    typedef typename T_Backing::template Map<T_Key, T_Value> Map;
 
 public:
     typedef typename Map::const_iterator const_iterator;
@@ -644,7 +1371,7 @@ public:
             = std::find_if(m_map.begin(), m_map.end(), [=](const std::pair<T_Key, T_Value>& i) {
                   return with_func(i.first, i.second);
               });
-        if (it == m_map.end()) return VlQueue<T_Value>{};
+        if (it == m_map.end()) return VlQueue<T_Key>{};
         return VlQueue<T_Key>::cons(it->first);
     }
     template <typename Func> VlQueue<T_Value> find_last(Func with_func) const {
@@ -660,7 +1387,7 @@ public:
             = std::find_if(m_map.rbegin(), m_map.rend(), [=](const std::pair<T_Key, T_Value>& i) {
                   return with_func(i.first, i.second);
               });
-        if (it == m_map.rend()) return VlQueue<T_Value>{};
+        if (it == m_map.rend()) return VlQueue<T_Key>{};
         return VlQueue<T_Key>::cons(it->first);
     }
 
@@ -761,30 +1488,25 @@ public:
     }
 };
 
-template <class T_Key, class T_Value>
-std::string VL_TO_STRING(const VlAssocArray<T_Key, T_Value>& obj) {
+template <class T_Key, class T_Value, class T_Backing>
+std::string VL_TO_STRING(const VlAssocArray<T_Key, T_Value, T_Backing>& obj) {
     return obj.to_string();
 }
 
-template <class T_Key, class T_Value>
+template <class T_Key, class T_Value, class T_Backing>
 void VL_READMEM_N(bool hex, int bits, const std::string& filename,
-                  VlAssocArray<T_Key, T_Value>& obj, QData start, QData end) VL_MT_SAFE {
+                  VlAssocArray<T_Key, T_Value, T_Backing>& obj, QData start,
+                  QData end) VL_MT_SAFE {
     VlReadMem rmem(hex, bits, filename, start, end);
     if (VL_UNLIKELY(!rmem.isOpen())) return;
-    while (true) {
-        QData addr;
-        std::string data;
-        if (rmem.get(addr /*ref*/, data /*ref*/)) {
-            rmem.setData(&(obj.at(addr)), data);
-        } else {
-            break;
-        }
-    }
+    QData addr;
+    while (rmem.next(addr /*ref*/)) rmem.setNext(&(obj.at(addr)));
 }
 
-template <class T_Key, class T_Value>
+template <class T_Key, class T_Value, class T_Backing>
 void VL_WRITEMEM_N(bool hex, int bits, const std::string& filename,
-                   const VlAssocArray<T_Key, T_Value>& obj, QData start, QData end) VL_MT_SAFE {
+                   const VlAssocArray<T_Key, T_Value, T_Backing>& obj, QData start,
+                   QData end) VL_MT_SAFE {
     VlWriteMem wmem(hex, bits, filename, start, end);
     if (VL_UNLIKELY(!wmem.isOpen())) return;
     for (const auto& i : obj) {
@@ -828,6 +1550,133 @@ public:
     const T_Value& operator[](size_t index) const { return m_array[index]; };
 };
 
+//===================================================================
+// Verilog unpacked array allocated a page at a time on first access
+// For large memories (--lazy-array-size, or lazy_array) where a simulation
+// touches only part of the array.  Resident pages are reached with one
+// table load; untouched pages take no memory.
+
+template <class T_Value, std::size_t T_Depth> class VlPagedUnpacked final {
+private:
+    // TYPES
+    static constexpr int pageBits(std::size_t elements, int bits) {
+        return elements > 1 ? pageBits(elements >> 1, bits + 1) : bits;
+    }
+    // Largest power of two elements within 64KB, but at least 8 elements,
+    // so each page starts 64-bit aligned as VL_RAND_RESET_ARRAY_PAGE needs
+    static constexpr int PAGE_BITS
+        = pageBits(65536 / sizeof(T_Value), 0) < 3 ? 3 : pageBits(65536 / sizeof(T_Value), 0);
+    static constexpr std::size_t PAGE_SIZE = static_cast<std::size_t>(1) << PAGE_BITS;
+    static constexpr std::size_t PAGES = (T_Depth + PAGE_SIZE - 1) >> PAGE_BITS;
+#ifdef VL_THREADED
+    typedef std::atomic<T_Value*> PagePtr;
+#else
+    typedef T_Value* PagePtr;
+#endif
+
+    // MEMBERS
+    std::unique_ptr<PagePtr[]> m_pagesp;  // Page table, nullptr where not yet allocated
+    VerilatedMutex m_mutex;  // Protects page allocation
+    bool m_randomize = false;  // New pages are randomized, else zeroed
+    int m_obits = 0;  // Element width, for randomization
+    vluint64_t m_key = 0;  // VL_RAND_RESET_ARRAY_KEY of this array
+
+    VL_ATTR_COLD T_Value* fault(std::size_t page) VL_MT_SAFE {
+        const VerilatedLockGuard lock(m_mutex);
+        T_Value* pagep = m_pagesp[page];
+        if (pagep) return pagep;  // Another thread allocated it
+        if (m_randomize) {
+            pagep = new T_Value[PAGE_SIZE];
+            VL_RAND_RESET_ARRAY_PAGE(m_obits, PAGE_SIZE, pagep, m_key,
+                                     static_cast<vluint64_t>(page) << PAGE_BITS);
+        } else {
+            pagep = new T_Value[PAGE_SIZE]();
+        }
+        m_pagesp[page] = pagep;
+        return pagep;
+    }
+    void clear() {
+        for (std::size_t page = 0; page < PAGES; ++page) {
+            delete[] static_cast<T_Value*>(m_pagesp[page]);
+            m_pagesp[page] = nullptr;
+        }
+    }
+
+public:
+    // CONSTRUCTORS
+    VlPagedUnpacked()
+        : m_pagesp{new PagePtr[PAGES]()} {}
+    ~VlPagedUnpacked() { clear(); }
+    VL_UNCOPYABLE(VlPagedUnpacked);
+
+    // METHODS
+    // Discard all pages; later accesses see zero, or if randomize, the values
+    // VL_RAND_RESET_ARRAY would have given the whole array
+    void reset(bool randomize, int obits, const char* scopep, const char* namep) {
+        reset(randomize, obits, randomize ? VL_RAND_RESET_ARRAY_KEY(scopep, namep) : 0);
+    }
+    void reset(bool randomize, int obits, vluint64_t key) {
+        clear();
+        m_randomize = randomize;
+        m_obits = obits;
+        m_key = key;
+    }
+    bool randomize() const { return m_randomize; }
+    int obits() const { return m_obits; }
+    vluint64_t key() const { return m_key; }
+    // Page access, e.g. for save/restore
+    static constexpr std::size_t pages() { return PAGES; }
+    static constexpr std::size_t pageSize() { return PAGE_SIZE; }
+    std::size_t residentPages() const {
+        std::size_t count = 0;
+        for (std::size_t page = 0; page < PAGES; ++page) count += (m_pagesp[page] != nullptr);
+        return count;
+    }
+    T_Value* pagep(std::size_t page) const { return m_pagesp[page]; }  // nullptr if absent
+    T_Value* pageAlloc(std::size_t page) { return fault(page); }
+
+    T_Value& operator[](std::size_t index) {
+        T_Value* pagep = m_pagesp[index >> PAGE_BITS];
+        if (VL_UNLIKELY(!pagep)) pagep = fault(index >> PAGE_BITS);
+        return pagep[index & (PAGE_SIZE - 1)];
+    }
+    // Reads allocate too, as a randomized page must read the same each time
+    const T_Value& operator[](std::size_t index) const {
+        return const_cast<VlPagedUnpacked&>(*this)[index];
+    }
+};
+
+template <class T_Value, std::size_t T_Depth>
+void VL_READMEM_N(bool hex, int bits, QData depth, int array_lsb, const std::string& filename,
+                  VlPagedUnpacked<T_Value, T_Depth>& obj, QData start, QData end) VL_MT_SAFE {
+    VlReadMem rmem(hex, bits, filename, start, end);
+    if (VL_UNLIKELY(!rmem.isOpen())) return;
+    const QData lo = static_cast<QData>(array_lsb);
+    QData addr;
+    while (rmem.next(addr /*ref*/)) {
+        if (VL_UNLIKELY(addr < lo || addr >= lo + depth)) {
+            VL_FATAL_MT(filename.c_str(), rmem.linenum(), "",
+                        "$readmem file address beyond bounds of array");
+        } else {
+            rmem.setNext(&(obj[addr - lo]));
+        }
+    }
+}
+
+template <class T_Value, std::size_t T_Depth>
+void VL_WRITEMEM_N(bool hex, int bits, QData depth, int array_lsb, const std::string& filename,
+                   const VlPagedUnpacked<T_Value, T_Depth>& obj, QData start,
+                   QData end) VL_MT_SAFE {
+    const QData addr_max = array_lsb + depth - 1;
+    if (start < static_cast<QData>(array_lsb)) start = array_lsb;
+    if (end > addr_max) end = addr_max;
+    VlWriteMem wmem(hex, bits, filename, start, end);
+    if (VL_UNLIKELY(!wmem.isOpen())) return;
+    for (QData addr = start; addr <= end; ++addr) {
+        wmem.print(addr, false, &(obj[addr - array_lsb]));
+    }
+}
+
 //===================================================================
 // Verilog class reference container
 // There are no multithreaded locks on this; the base variable must
@@ -842,6 +1691,14 @@ inline T VL_NULL_CHECK(T t, const char* filename, int linenum) {
     return t;
 }
 
+/// Construct an object whose random streams (--rand-streams) derive from the
+/// stream of the constructing call site
+template <class T_Class, typename... T_Args>
+inline VlClassRef<T_Class> VL_NEW_RAND_STREAM(WDataOutP statep, T_Args&&... args) {
+    const VlRandStreamParent parent{statep};
+    return std::make_shared<T_Class>(std::forward<T_Args>(args)...);
+}
+
 template <typename T, typename U>
 static inline bool VL_CAST_DYNAMIC(VlClassRef<T> in, VlClassRef<U>& outr) {
     VlClassRef<U> casted = std::dynamic_pointer_cast<U>(in);
@@ -900,6 +1757,9 @@ extern IData VL_SSCANF_INX(int lbits, const std::string& ld, const char* formatp
 extern void VL_SFORMAT_X(int obits_ignored, std::string& output, const char* formatp,
                          ...) VL_MT_SAFE;
 extern std::string VL_SFORMATF_NX(const char* formatp, ...) VL_MT_SAFE;
+extern void VL_SFORMAT_P(int obits_ignored, std::string& output, const char* progp,
+                         ...) VL_MT_SAFE;
+extern std::string VL_SFORMATF_P(const char* progp, ...) VL_MT_SAFE;
 extern void VL_TIMEFORMAT_IINI(int units, int precision, const std::string& suffix,
                                int width) VL_MT_SAFE;
 extern IData VL_VALUEPLUSARGS_INW(int rbits, const std::string& ld, WDataOutP rwp) VL_MT_SAFE;
@@ -129,9 +129,93 @@ public:
     }
 };
 
+/// Asynchronous $display output, enabled with Verilated::logAsync.
+/// Each producing thread appends text to its own lock-free ring, which a
+/// writer thread drains.  Text is printed in the same order the message
+/// queues use: by eval, then by mtask, then in the order produced.
+class VerilatedLogAsync final {
+public:
+    // TYPES
+    /// Point in the text produced, taken by a producer before posting a message
+    struct Mark {
+        vluint64_t m_epoch;  ///< Eval of the producer
+        vluint32_t m_mtaskId;  ///< MTask of the producer
+        size_t m_pos;  ///< Bytes written to the producer's ring
+        bool operator<(const Mark& rhs) const {
+            if (m_epoch != rhs.m_epoch) return m_epoch < rhs.m_epoch;
+            if (m_mtaskId != rhs.m_mtaskId) return m_mtaskId < rhs.m_mtaskId;
+            return m_pos < rhs.m_pos;
+        }
+    };
+    /// Print text up to a mark, and hold back later text until destroyed.
+    /// Used around $finish, $stop and fatal messages, so text the message
+    /// queues would print after the message is not printed before it.
+    class Hold final {
+    public:
+        explicit Hold(const Mark& mark);
+        ~Hold();
+        VL_UNCOPYABLE(Hold);
+    };
+
+private:
+    struct Header {
+        vluint64_t m_epoch;  ///< Eval that produced the text
+        vluint32_t m_mtaskId;  ///< MTask that produced the text
+        vluint32_t m_length;  ///< Bytes of text following header
+    };
+    /// Byte ring with a single producer and a single consumer
+    struct Ring {
+        static constexpr size_t SIZE = 64 * 1024;  ///< Bytes, power of two
+        std::atomic<size_t> m_head{0};  ///< Total bytes written, by producer
+        std::atomic<size_t> m_tail{0};  ///< Total bytes read, by consumer
+        char m_data[SIZE];
+        void put(size_t pos, const void* datap, size_t len);
+        void get(size_t pos, void* datap, size_t len) const;
+    };
+    struct Entry {
+        vluint64_t m_epoch;  ///< Eval that produced the text
+        vluint32_t m_mtaskId;  ///< MTask that produced the text
+        size_t m_pos;  ///< Position of text in its ring
+        std::string m_text;  ///< Text to print
+        Mark mark() const { return Mark{m_epoch, m_mtaskId, m_pos}; }
+    };
+
+    // MEMBERS
+    static VerilatedMutex s_mutex;  ///< Held while draining
+    static std::vector<Ring*> s_rings VL_GUARDED_BY(s_mutex);  ///< Ring of each producer
+    static std::vector<Entry> s_pending VL_GUARDED_BY(s_mutex);  ///< Drained, not printed
+    static std::atomic<vluint64_t> s_epoch;  ///< Number of current eval
+    static std::atomic<bool> s_running;  ///< Writer thread should run
+    static std::thread s_thread;  ///< Writer thread
+    static VL_THREAD_LOCAL Ring* t_ringp;  ///< This thread's ring
+    static bool s_holding VL_GUARDED_BY(s_mutex);  ///< A Hold is in effect
+    static Mark s_hold VL_GUARDED_BY(s_mutex);  ///< Text from here is held back
+
+    // METHODS
+    static Ring* newRing() VL_MT_SAFE;
+    static void drain() VL_REQUIRES(s_mutex);
+    static void write(const Mark& limit) VL_REQUIRES(s_mutex);
+    static void writerLoop() VL_MT_SAFE;
+
+public:
+    /// Start or stop the writer thread
+    static void start() VL_MT_UNSAFE;
+    static void stop() VL_MT_UNSAFE;
+    /// Add text to print, called by producer
+    static void post(const std::string& text) VL_MT_SAFE;
+    /// Called by the eval thread once all mtasks of an eval have completed
+    static void nextEpoch() VL_MT_SAFE { s_epoch.fetch_add(1, std::memory_order_release); }
+    /// Return a mark at the current point in this thread's text
+    static Mark mark() VL_MT_SAFE;
+    /// Print text produced so far, then return.  Within an mtask only text
+    /// of earlier evals is printed, as other mtasks' text may sort earlier.
+    static void flush() VL_MT_SAFE;
+};
+
 /// Each thread has a local queue to build up messages until the end of the eval() call
 class VerilatedThreadMsgQueue final {
     std::queue<VerilatedMsg> m_queue;
+    std::string m_text;  ///< $display text not yet in m_queue, batched into one message
 
 public:
     // CONSTRUCTORS
@@ -149,6 +233,17 @@ private:
         return t_s;
     }
 
+    static void flushText() VL_MT_SAFE {
+        std::string& text = threadton().m_text;
+        if (VL_LIKELY(text.empty())) return;
+        // endOfEvalReqd was incremented when the text started
+        const std::string out = text;
+        text.clear();
+        threadton().m_queue.push(VerilatedMsg([=]() {  //
+            VL_PRINTF("%s", out.c_str());
+        }));
+    }
+
 public:
     /// Add message to queue, called by producer
     static void post(const VerilatedMsg& msg) VL_MT_SAFE {
@@ -158,12 +253,26 @@ public:
             // No queueing, just do the action immediately
             msg.run();
         } else {
+            flushText();  // Keep order with earlier text
             Verilated::endOfEvalReqdInc();
             threadton().m_queue.push(msg);  // Pass by value to copy the message into queue
         }
     }
+    /// Add text to print, called by producer.  Text from one mtask is
+    /// batched into a single message rather than a message per call.
+    static void postText(const std::string& text) VL_MT_SAFE {
+        if (VL_UNLIKELY(Verilated::logAsync())) {
+            VerilatedLogAsync::post(text);
+        } else if (Verilated::mtaskId() == 0) {
+            VL_PRINTF("%s", text.c_str());
+        } else if (!text.empty()) {
+            if (threadton().m_text.empty()) Verilated::endOfEvalReqdInc();
+            threadton().m_text += text;
+        }
+    }
     /// Push all messages to the eval's queue
     static void flush(VerilatedEvalMsgQueue* evalMsgQp) VL_MT_SAFE {
+        flushText();
         while (!threadton().m_queue.empty()) {
             evalMsgQp->post(threadton().m_queue.front());
             threadton().m_queue.pop();
@@ -171,6 +280,7 @@ public:
         }
     }
 };
+
 #endif  // VL_THREADED
 
 // FILE* list constructed from a file-descriptor
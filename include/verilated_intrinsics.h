@@ -34,6 +34,12 @@
 #  define VL_HAVE_AVX2 1
 #  include <immintrin.h>
 # endif
+# if defined(__SIZEOF_INT128__) && !defined(VL_DISABLE_INT128)
+#  define VL_HAVE_INT128 1
+# endif
+# if defined(__AVX512F__) && defined(VL_HAVE_AVX2) && !defined(VL_DISABLE_AVX512)
+#  define VL_HAVE_AVX512 1
+# endif
 #endif
 
 // clang-format on
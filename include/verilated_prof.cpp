@@ -0,0 +1,363 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//=============================================================================
+//
+// THIS MODULE IS PUBLICLY LICENSED
+//
+// Copyright 2020 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//=============================================================================
+///
+/// \file
+/// \brief Verilator: Runtime profiling of verilated models
+///
+//=============================================================================
+
+#include "verilatedos.h"
+#include "verilated_prof.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+// clang-format off
+#if defined(__linux__) || defined(__FreeBSD__)
+# include <ucontext.h>
+#endif
+// Program counter of a signal's ucontext_t, where known
+#if defined(__linux__) && defined(__x86_64__)
+# define VL_PROF_SAMPLE_PC(ucp) ((ucp)->uc_mcontext.gregs[REG_RIP])
+#elif defined(__linux__) && defined(__i386__)
+# define VL_PROF_SAMPLE_PC(ucp) ((ucp)->uc_mcontext.gregs[REG_EIP])
+#elif defined(__linux__) && defined(__aarch64__)
+# define VL_PROF_SAMPLE_PC(ucp) ((ucp)->uc_mcontext.pc)
+#elif defined(__linux__) && defined(__arm__)
+# define VL_PROF_SAMPLE_PC(ucp) ((ucp)->uc_mcontext.arm_pc)
+#elif defined(__linux__) && defined(__riscv)
+# define VL_PROF_SAMPLE_PC(ucp) ((ucp)->uc_mcontext.__gregs[REG_PC])
+#elif defined(__FreeBSD__) && defined(__x86_64__)
+# define VL_PROF_SAMPLE_PC(ucp) ((ucp)->uc_mcontext.mc_rip)
+#endif
+// Without section bounds, samples outside the model would be counted to its functions
+#if defined(VL_PROF_SAMPLE_PC) && defined(VL_PROF_SAMPLE_SECTION)
+# define VL_PROF_SAMPLE_SIGNALS 1
+# include <csignal>
+# include <sys/time.h>
+#endif
+// clang-format on
+
+#ifdef VL_PROF_SAMPLE_SECTION
+// Bounds of the VL_ATTR_PROF_SAMPLE sections, defined by the linker; weak as
+// a program may not have sampled functions of either kind
+extern "C" const char __start_vlprof_sample_text[] __attribute__((weak));
+extern "C" const char __stop_vlprof_sample_text[] __attribute__((weak));
+extern "C" const char __start_vlprof_sample_inline[] __attribute__((weak));
+extern "C" const char __stop_vlprof_sample_inline[] __attribute__((weak));
+#endif
+
+//=============================================================================
+// Function table
+//
+// The signal handler may not allocate or lock, so addFuncs builds each new
+// table aside and publishes it with one atomic store. Replaced tables are
+// never freed, as a handler may still be searching them.
+
+struct VlProfSampleTable {
+    // Start and end of the VL_ATTR_PROF_SAMPLE and VL_ATTR_PROF_SAMPLE_INLINE sections
+    uintptr_t m_ranges[2][2] = {{0, 0}, {0, 0}};
+    std::vector<VlProfSampleFunc*> m_funcps;  // Functions, sorted by address
+    bool inRange(uintptr_t pc) const {
+        return (pc >= m_ranges[0][0] && pc < m_ranges[0][1])
+               || (pc >= m_ranges[1][0] && pc < m_ranges[1][1]);
+    }
+};
+
+static VerilatedMutex s_profMutex;  // Protects adding to s_profTablep
+static std::atomic<const VlProfSampleTable*> s_profTablep{nullptr};
+static std::atomic<vluint64_t> s_profOther{0};  // Samples outside any model function
+static std::atomic<bool> s_profStarted{false};
+static std::atomic<bool> s_profStopped{false};
+static unsigned s_profRate = 0;  // Samples per second, for the report header
+
+#ifdef VL_PROF_SAMPLE_SIGNALS
+static void _vl_prof_sample_count(uintptr_t pc) VL_MT_SAFE {
+    // Must be async-signal-safe
+    const VlProfSampleTable* tablep = s_profTablep.load(std::memory_order_acquire);
+    // Functions of a model not yet configured may precede the first entry
+    if (tablep && tablep->inRange(pc)
+        && pc >= reinterpret_cast<uintptr_t>(tablep->m_funcps.front()->m_addrp)) {
+        // Find the last function starting at or before pc
+        size_t lo = 0;
+        size_t hi = tablep->m_funcps.size();
+        while (hi - lo > 1) {
+            const size_t mid = lo + (hi - lo) / 2;
+            if (reinterpret_cast<uintptr_t>(tablep->m_funcps[mid]->m_addrp) <= pc) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+        tablep->m_funcps[lo]->m_count.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    s_profOther.fetch_add(1, std::memory_order_relaxed);
+}
+
+static void _vl_prof_sample_handler(int, siginfo_t*, void* ucontextp) {
+    const int savedErrno = errno;
+    const ucontext_t* ucp = static_cast<const ucontext_t*>(ucontextp);
+    _vl_prof_sample_count(static_cast<uintptr_t>(VL_PROF_SAMPLE_PC(ucp)));
+    errno = savedErrno;
+}
+#endif
+
+static void _vl_prof_sample_exit(void*) { VlProfSample::stop(); }
+static void _vl_prof_sample_atexit() { VlProfSample::stop(); }
+
+//=============================================================================
+// VlProfSample
+
+void VlProfSample::addFuncs(VlProfSampleFunc* funcsp, size_t count) VL_MT_SAFE {
+    if (!count) return;
+    const VerilatedLockGuard lock(s_profMutex);
+    const VlProfSampleTable* oldp = s_profTablep.load();
+    VlProfSampleTable* newp = new VlProfSampleTable;
+    if (oldp) {
+        // Another model of the same type already added this table
+        if (std::find(oldp->m_funcps.begin(), oldp->m_funcps.end(), funcsp)
+            != oldp->m_funcps.end()) {
+            delete newp;
+            return;
+        }
+        newp->m_funcps = oldp->m_funcps;
+    }
+    for (size_t i = 0; i < count; ++i) newp->m_funcps.push_back(&funcsp[i]);
+    std::stable_sort(newp->m_funcps.begin(), newp->m_funcps.end(),
+                     [](const VlProfSampleFunc* ap, const VlProfSampleFunc* bp) {
+                         return reinterpret_cast<uintptr_t>(ap->m_addrp)
+                                < reinterpret_cast<uintptr_t>(bp->m_addrp);
+                     });
+#ifdef VL_PROF_SAMPLE_SECTION
+    newp->m_ranges[0][0] = reinterpret_cast<uintptr_t>(__start_vlprof_sample_text);
+    newp->m_ranges[0][1] = reinterpret_cast<uintptr_t>(__stop_vlprof_sample_text);
+    newp->m_ranges[1][0] = reinterpret_cast<uintptr_t>(__start_vlprof_sample_inline);
+    newp->m_ranges[1][1] = reinterpret_cast<uintptr_t>(__stop_vlprof_sample_inline);
+#endif
+    s_profTablep.store(newp, std::memory_order_release);
+}
+
+void VlProfSample::start() VL_MT_SAFE {
+    if (s_profStarted.exchange(true)) return;
+    s_profRate = std::max(1U, Verilated::profSampleRate());
+#ifdef VL_PROF_SAMPLE_SIGNALS
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_sigaction = _vl_prof_sample_handler;
+    action.sa_flags = SA_RESTART | SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+    if (VL_UNCOVERABLE(sigaction(SIGPROF, &action, nullptr))) {
+        VL_PRINTF_MT("%%Warning: --prof-sample: cannot install SIGPROF handler, "
+                     "no samples will be collected\n");  // LCOV_EXCL_LINE
+    }
+    struct itimerval timer;
+    timer.it_interval.tv_sec = 0;
+    timer.it_interval.tv_usec = s_profRate >= 1000000 ? 1 : 1000000 / s_profRate;
+    timer.it_value = timer.it_interval;
+    setitimer(ITIMER_PROF, &timer, nullptr);
+#else
+    VL_PRINTF_MT("%%Warning: --prof-sample is not supported on this platform, "
+                 "no samples will be collected\n");
+#endif
+    // Normal exit runs atexit; $stop and fatal errors run exit callbacks
+    Verilated::addExitCb(_vl_prof_sample_exit, nullptr);
+    atexit(_vl_prof_sample_atexit);
+}
+
+void VlProfSample::stop() VL_MT_SAFE {
+    if (!s_profStarted || s_profStopped.exchange(true)) return;
+#ifdef VL_PROF_SAMPLE_SIGNALS
+    struct itimerval timer;
+    memset(&timer, 0, sizeof(timer));
+    setitimer(ITIMER_PROF, &timer, nullptr);
+#endif
+    dump(Verilated::profSampleFilenamep());
+}
+
+void VlProfSample::dump(const char* filenamep) VL_MT_SAFE {
+    // Parameterized copies of a module may emit the same function names,
+    // so aggregate by name rather than by table entry
+    typedef std::map<std::string, vluint64_t> CountMap;
+    CountMap funcs;
+    CountMap modules;
+    vluint64_t total = s_profOther;
+    {
+        const VerilatedLockGuard lock(s_profMutex);
+        if (const VlProfSampleTable* tablep = s_profTablep.load()) {
+            for (const VlProfSampleFunc* funcp : tablep->m_funcps) {
+                const vluint64_t count = funcp->m_count.load();
+                const std::string key = std::string(funcp->m_modulep) + " " + funcp->m_funcp
+                                        + " " + funcp->m_filenamep + ":"
+                                        + std::to_string(funcp->m_lineno);
+                funcs[key] += count;
+                modules[funcp->m_modulep] += count;
+                total += count;
+            }
+        }
+    }
+
+    FILE* fp = fopen(filenamep, "w");
+    if (VL_UNCOVERABLE(!fp)) {
+        VL_FATAL_MT(filenamep, 0, "", "+prof+sample+file file not writable");
+        // cppcheck-suppress resourceLeak   // bug, doesn't realize fp is nullptr
+        return;  // LCOV_EXCL_LINE
+    }
+    // Sort by descending count
+    typedef std::vector<std::pair<vluint64_t, std::string>> SortedVec;
+    const auto sortedByCount = [](const CountMap& counts) {
+        SortedVec sorted;
+        for (const auto& it : counts) sorted.emplace_back(it.second, it.first);
+        std::stable_sort(sorted.begin(), sorted.end(),
+                         [](const SortedVec::value_type& a, const SortedVec::value_type& b) {
+                             return a.first > b.first;
+                         });
+        return sorted;
+    };
+    const double pctDiv = total ? 100.0 / static_cast<double>(total) : 0.0;
+
+    fputs("// Verilated sample profile, see 'verilator --help' --prof-sample\n", fp);
+    fprintf(fp, "VLPROFSAMPLE rate %u samples %" VL_PRI64 "u other %" VL_PRI64 "u\n", s_profRate,
+            total, s_profOther.load());
+    fputs("// VLPROFSAMPLE module <samples> <percent> <module>\n", fp);
+    for (const auto& it : sortedByCount(modules)) {
+        fprintf(fp, "VLPROFSAMPLE module %" VL_PRI64 "u %.2f %s\n", it.first,
+                static_cast<double>(it.first) * pctDiv, it.second.c_str());
+    }
+    fputs("// VLPROFSAMPLE func <samples> <percent> <module> <function> <file>:<line>\n", fp);
+    for (const auto& it : sortedByCount(funcs)) {
+        fprintf(fp, "VLPROFSAMPLE func %" VL_PRI64 "u %.2f %s\n", it.first,
+                static_cast<double>(it.first) * pctDiv, it.second.c_str());
+    }
+    fclose(fp);
+}
+
+//=============================================================================
+// VlProfCost
+
+static VerilatedMutex s_costMutex;  // Protects s_costSitesp list
+static VlProfCostSite* s_costSitesp = nullptr;  // Registered sites
+static std::atomic<bool> s_costStarted{false};
+static std::atomic<bool> s_costStopped{false};
+
+VL_THREAD_LOCAL vluint64_t VlProfCost::t_childTicks = 0;
+
+void VlProfCost::addSite(VlProfCostSite* sitep) VL_MT_SAFE {
+    const VerilatedLockGuard lock(s_costMutex);
+    if (sitep->m_registered) return;  // Another thread won
+    sitep->m_nextp = s_costSitesp;
+    s_costSitesp = sitep;
+    sitep->m_registered = true;
+}
+
+static void _vl_prof_cost_exit(void*) { VlProfCost::stop(); }
+static void _vl_prof_cost_atexit() { VlProfCost::stop(); }
+
+void VlProfCost::start() VL_MT_SAFE {
+    if (s_costStarted.exchange(true)) return;
+    // Normal exit runs atexit; $stop and fatal errors run exit callbacks
+    Verilated::addExitCb(_vl_prof_cost_exit, nullptr);
+    atexit(_vl_prof_cost_atexit);
+}
+
+void VlProfCost::stop() VL_MT_SAFE {
+    if (!s_costStarted || s_costStopped.exchange(true)) return;
+    dump(Verilated::profCostFilenamep());
+}
+
+void VlProfCost::clear() VL_MT_SAFE {
+    const VerilatedLockGuard lock(s_costMutex);
+    for (VlProfCostSite* sitep = s_costSitesp; sitep; sitep = sitep->m_nextp) {
+        sitep->m_calls = 0;
+        sitep->m_selfTicks = 0;
+        sitep->m_totalTicks = 0;
+    }
+}
+
+void VlProfCost::dump(const char* filenamep) VL_MT_SAFE {
+    struct Counts {
+        vluint64_t m_calls = 0;
+        vluint64_t m_selfTicks = 0;
+        vluint64_t m_totalTicks = 0;
+    };
+    typedef std::map<std::string, Counts> CountMap;
+    CountMap funcs;
+    CountMap instances;
+    CountMap modules;
+    vluint64_t total = 0;
+    {
+        const VerilatedLockGuard lock(s_costMutex);
+        for (const VlProfCostSite* sitep = s_costSitesp; sitep; sitep = sitep->m_nextp) {
+            Counts counts;
+            counts.m_calls = sitep->m_calls;
+            counts.m_selfTicks = sitep->m_selfTicks;
+            counts.m_totalTicks = sitep->m_totalTicks;
+            const std::string instance = sitep->m_instancep[0] ? sitep->m_instancep : "-";
+            const std::string instKey = instance + " " + sitep->m_modulep;
+            for (Counts* sump : {&funcs[instKey + " " + sitep->m_funcp], &instances[instKey],
+                                 &modules[sitep->m_modulep]}) {
+                sump->m_calls += counts.m_calls;
+                sump->m_selfTicks += counts.m_selfTicks;
+                sump->m_totalTicks += counts.m_totalTicks;
+            }
+            total += counts.m_selfTicks;
+        }
+    }
+
+    FILE* fp = fopen(filenamep, "w");
+    if (VL_UNCOVERABLE(!fp)) {
+        VL_FATAL_MT(filenamep, 0, "", "+prof+cost+file file not writable");
+        // cppcheck-suppress resourceLeak   // bug, doesn't realize fp is nullptr
+        return;  // LCOV_EXCL_LINE
+    }
+    // Sort by descending self ticks
+    typedef std::vector<std::pair<std::string, Counts>> SortedVec;
+    const auto sortedByCost = [](const CountMap& counts) {
+        SortedVec sorted(counts.begin(), counts.end());
+        std::stable_sort(sorted.begin(), sorted.end(),
+                         [](const SortedVec::value_type& a, const SortedVec::value_type& b) {
+                             return a.second.m_selfTicks > b.second.m_selfTicks;
+                         });
+        return sorted;
+    };
+    const double pctDiv = total ? 100.0 / static_cast<double>(total) : 0.0;
+
+    fputs("// Verilated eval cost profile, see 'verilator --help' --prof-cost\n", fp);
+    fprintf(fp, "VLPROFCOST ticks %" VL_PRI64 "u\n", total);
+    fputs("// VLPROFCOST module <calls> <self_ticks> <percent> <module>\n", fp);
+    for (const auto& it : sortedByCost(modules)) {
+        fprintf(fp, "VLPROFCOST module %" VL_PRI64 "u %" VL_PRI64 "u %.2f %s\n",
+                it.second.m_calls, it.second.m_selfTicks,
+                static_cast<double>(it.second.m_selfTicks) * pctDiv, it.first.c_str());
+    }
+    fputs("// VLPROFCOST instance <calls> <self_ticks> <percent> <instance> <module>\n", fp);
+    for (const auto& it : sortedByCost(instances)) {
+        fprintf(fp, "VLPROFCOST instance %" VL_PRI64 "u %" VL_PRI64 "u %.2f %s\n",
+                it.second.m_calls, it.second.m_selfTicks,
+                static_cast<double>(it.second.m_selfTicks) * pctDiv, it.first.c_str());
+    }
+    fputs("// VLPROFCOST func <calls> <self_ticks> <total_ticks> <percent> <instance> <module>"
+          " <function>\n",
+          fp);
+    for (const auto& it : sortedByCost(funcs)) {
+        fprintf(fp, "VLPROFCOST func %" VL_PRI64 "u %" VL_PRI64 "u %" VL_PRI64 "u %.2f %s\n",
+                it.second.m_calls, it.second.m_selfTicks, it.second.m_totalTicks,
+                static_cast<double>(it.second.m_selfTicks) * pctDiv, it.first.c_str());
+    }
+    fclose(fp);
+}
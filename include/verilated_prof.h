@@ -0,0 +1,170 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//=============================================================================
+//
+// THIS MODULE IS PUBLICLY LICENSED
+//
+// Copyright 2020 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//=============================================================================
+///
+/// \file
+/// \brief Verilator: Runtime profiling of verilated models
+///
+/// This file is included by models built with --prof-sample or --prof-cost.
+///
+/// Each model class registers a table of its functions' code addresses.
+/// A SIGPROF handler looks up the interrupted program counter in the sorted
+/// table and counts a sample against the function containing it, so the
+/// model code itself carries no instrumentation.
+///
+/// Cost accounting instead times every call of each emitted function with
+/// the CPU timestamp counter, and reports it per module and per instance.
+///
+//=============================================================================
+
+#ifndef _VERILATED_PROF_H_
+#define _VERILATED_PROF_H_ 1  ///< Header Guard
+
+#include "verilatedos.h"
+#include "verilated.h"
+
+#include <atomic>
+
+// clang-format off
+#if defined(__GNUC__) && defined(__ELF__)
+// Sampled functions are linked into their own sections, so a program counter
+// between the bounds of either is always in some function of the table.
+// Functions defined VL_INLINE_OPT may be COMDAT, so they need another section.
+# define VL_PROF_SAMPLE_SECTION 1
+# define VL_ATTR_PROF_SAMPLE __attribute__((section("vlprof_sample_text")))
+# define VL_ATTR_PROF_SAMPLE_INLINE __attribute__((section("vlprof_sample_inline")))
+#else
+# define VL_ATTR_PROF_SAMPLE  ///< Function is in the sample table
+# define VL_ATTR_PROF_SAMPLE_INLINE  ///< VL_INLINE_OPT function is in the sample table
+#endif
+// clang-format on
+
+//=============================================================================
+// VlProfSampleFunc - One sampled function, emitted in a static table by the
+// model's configure function
+
+struct VlProfSampleFunc {
+    const void* m_addrp;  ///< Code address, from VlProfSample::funcAddr
+    const char* m_funcp;  ///< Emitted C function name
+    const char* m_modulep;  ///< Verilog module name
+    const char* m_filenamep;  ///< Verilog source filename
+    int m_lineno;  ///< Verilog source line number
+    std::atomic<vluint64_t> m_count;  ///< Samples in this function
+};
+
+//=============================================================================
+// VlProfSample - Statistical sampling profiler
+
+class VlProfSample final {
+public:
+    // METHODS
+    /// Start sampling, if not already started. Called by the model constructor.
+    /// Rate and report filename are from +verilator+prof+sample+ arguments.
+    static void start() VL_MT_SAFE;
+    /// Stop sampling and write the report, if not already written.
+    /// Called automatically at exit.
+    static void stop() VL_MT_SAFE;
+    /// Write the report collected so far to the given filename
+    static void dump(const char* filenamep) VL_MT_SAFE;
+    /// Add a table of functions to sample, if not already added.
+    /// Called by the configure function of the first instance of each module.
+    static void addFuncs(VlProfSampleFunc* funcsp, size_t count) VL_MT_SAFE;
+    /// Return the code address of a static member function
+    template <typename T_Func> static const void* funcAddr(T_Func* funcp) VL_PURE {
+        return reinterpret_cast<const void*>(funcp);
+    }
+    /// Return the code address of a non-virtual member function
+    template <typename T_Func, class T_Class>
+    static const void* funcAddr(T_Func T_Class::*funcp) VL_PURE {
+        // The Itanium and MSVC ABIs both put the address first
+        const void* addrp;
+        memcpy(&addrp, &funcp, sizeof(addrp));
+        return addrp;
+    }
+};
+
+//=============================================================================
+// VlProfCostSite - Cost of one emitted function in one instance, emitted as a
+// function-local static object by the generated code
+
+#ifdef VL_THREADED
+// Functions called from several mtasks may update a site concurrently
+typedef std::atomic<vluint64_t> VlProfCostCount;
+typedef std::atomic<bool> VlProfCostFlag;
+#else
+typedef vluint64_t VlProfCostCount;
+typedef bool VlProfCostFlag;
+#endif
+
+struct VlProfCostSite {
+    const char* m_funcp;  ///< Emitted C function name
+    const char* m_modulep;  ///< Verilog module name
+    const char* m_instancep;  ///< Verilog instance (scope) name, or "" if not under a scope
+    VlProfCostCount m_calls;  ///< Number of calls
+    VlProfCostCount m_selfTicks;  ///< Ticks in this function, excluding callees
+    VlProfCostCount m_totalTicks;  ///< Ticks in this function, including callees
+    VlProfCostFlag m_registered;  ///< On list of sites for the report
+    VlProfCostSite* m_nextp;  ///< Next registered site
+};
+
+//=============================================================================
+// VlProfCost - Per-module and per-instance eval cost accounting
+
+class VlProfCost final {
+    friend class VlProfCostScope;
+    // MEMBERS
+    // Ticks spent in callees of the function now executing on this thread
+    static VL_THREAD_LOCAL vluint64_t t_childTicks;
+    // METHODS
+    static void addSite(VlProfCostSite* sitep) VL_MT_SAFE;
+
+public:
+    /// Start accounting, if not already started. Called by the model constructor.
+    /// The report filename is from +verilator+prof+cost+file+.
+    static void start() VL_MT_SAFE;
+    /// Write the report, if not already written. Called automatically at exit.
+    static void stop() VL_MT_SAFE;
+    /// Write the report collected so far to the given filename
+    static void dump(const char* filenamep) VL_MT_SAFE;
+    /// Zero all counts, for example to exclude initialization from the report
+    static void clear() VL_MT_SAFE;
+};
+
+//=============================================================================
+// VlProfCostScope - Time an emitted function for the life of the call
+
+class VlProfCostScope final {
+    VlProfCostSite* m_sitep;  ///< Site being timed
+    vluint64_t m_prevChildTicks;  ///< Caller's callee ticks so far, restored on return
+    vluint64_t m_startTicks;  ///< Counter at entry
+
+public:
+    explicit VlProfCostScope(VlProfCostSite* sitep)
+        : m_sitep{sitep}
+        , m_prevChildTicks{VlProfCost::t_childTicks} {
+        if (VL_UNLIKELY(!sitep->m_registered)) VlProfCost::addSite(sitep);
+        VlProfCost::t_childTicks = 0;
+        VL_RDTSC(m_startTicks);
+    }
+    ~VlProfCostScope() {
+        vluint64_t endTicks;
+        VL_RDTSC(endTicks);
+        const vluint64_t ticks = endTicks - m_startTicks;
+        m_sitep->m_calls += 1;
+        m_sitep->m_selfTicks += ticks - VlProfCost::t_childTicks;
+        m_sitep->m_totalTicks += ticks;
+        VlProfCost::t_childTicks = m_prevChildTicks + ticks;
+    }
+    VL_UNCOPYABLE(VlProfCostScope);
+};
+
+#endif  // Guard
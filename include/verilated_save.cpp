@@ -20,15 +20,26 @@
 #include "verilated.h"
 #include "verilated_save.h"
 
+#include <algorithm>
 #include <cerrno>
+#include <deque>
 #include <fcntl.h>
+#include <map>
+#include <vector>
 
 // clang-format off
+#ifdef VL_THREADED
+# include <condition_variable>
+# include <thread>
+#endif
 #if defined(_WIN32) && !defined(__MINGW32__) && !defined(__CYGWIN__)
 # include <io.h>
 #else
 # include <unistd.h>
 #endif
+#if !defined(_WIN32) || defined(__CYGWIN__)
+# include <sys/mman.h>
+#endif
 
 #ifndef O_LARGEFILE  // For example on WIN32
 # define O_LARGEFILE 0
@@ -46,6 +57,53 @@
 static const char* const VLTSAVE_HEADER_STR = "verilatorsave01\n";
 /// Value of last bytes of each file (must be multiple of 8 bytes)
 static const char* const VLTSAVE_TRAILER_STR = "vltsaved";
+/// Value of first bytes of each delta file (must be multiple of 8 bytes)
+static const char* const VLTSAVE_DELTA_HEADER_STR = "verilatordelta1\n";
+/// Value of last bytes of each delta file (must be multiple of 8 bytes)
+static const char* const VLTSAVE_DELTA_TRAILER_STR = "vltdelta";
+/// Region index marking the end of the pages in a delta file
+static const vluint64_t VLTSAVE_DELTA_END = ~0ULL;
+
+//=============================================================================
+// File helpers
+
+static void _vl_save_write(int fd, const void* datap, size_t size) VL_MT_SAFE {
+    const vluint8_t* wp = static_cast<const vluint8_t*>(datap);
+    while (size) {
+        errno = 0;
+        ssize_t got = ::write(fd, wp, size);
+        if (got > 0) {
+            wp += got;
+            size -= got;
+        } else if (VL_UNCOVERABLE(got < 0)) {
+            if (VL_UNCOVERABLE(errno != EAGAIN && errno != EINTR)) {
+                // LCOV_EXCL_START
+                // write failed, presume error (perhaps out of disk space)
+                std::string msg = std::string(__FUNCTION__) + ": " + strerror(errno);
+                VL_FATAL_MT("", 0, "", msg.c_str());
+                return;
+                // LCOV_EXCL_STOP
+            }
+        }
+    }
+}
+
+static bool _vl_save_read_at(int fd, vluint64_t offset, void* datap, size_t size) VL_MT_SAFE {
+    // Returns false on error or end-of-file before size bytes
+    if (VL_UNLIKELY(::lseek(fd, static_cast<off_t>(offset), SEEK_SET) < 0)) return false;
+    vluint8_t* rp = static_cast<vluint8_t*>(datap);
+    while (size) {
+        errno = 0;
+        ssize_t got = ::read(fd, rp, size);
+        if (got > 0) {
+            rp += got;
+            size -= got;
+        } else if (got == 0 || (errno != EAGAIN && errno != EINTR)) {
+            return false;
+        }
+    }
+    return true;
+}
 
 //=============================================================================
 //=============================================================================
@@ -247,5 +305,539 @@ void VerilatedRestore::fill() VL_MT_UNSAFE_ONE {
     }
 }
 
+//=============================================================================
+// VerilatedSaveAsync
+
+class VerilatedSaveAsyncImp final {
+public:
+    // TYPES
+    struct Chunk {
+        vluint8_t* m_bufp;  // Staged buffer, from new[]
+        size_t m_size;  // Bytes used in m_bufp
+    };
+    // MEMBERS
+    int m_fd = -1;  ///< File descriptor we're writing to
+    size_t m_maxPending = 0;  ///< Max staged bytes, 0 = unlimited
+#ifdef VL_THREADED
+    mutable VerilatedMutex m_mutex;
+    std::condition_variable_any m_cv;  ///< Chunk staged, written, or writer done
+    std::deque<Chunk> m_pending VL_GUARDED_BY(m_mutex);  ///< Chunks to write in order
+    std::vector<vluint8_t*> m_free VL_GUARDED_BY(m_mutex);  ///< Written buffers to reuse
+    size_t m_pendingBytes VL_GUARDED_BY(m_mutex) = 0;  ///< Sum of m_pending sizes
+    bool m_closing VL_GUARDED_BY(m_mutex) = false;  ///< No more chunks will be staged
+    bool m_done VL_GUARDED_BY(m_mutex) = true;  ///< Writer has closed the file
+    std::thread m_thread;  ///< Writer thread
+#endif
+
+    // CONSTRUCTORS
+    VerilatedSaveAsyncImp() = default;
+    ~VerilatedSaveAsyncImp() {
+#ifdef VL_THREADED
+        VerilatedLockGuard lock(m_mutex);
+        for (vluint8_t* bufp : m_free) delete[] bufp;
+#endif
+    }
+
+    // METHODS
+    void write(const vluint8_t* wp, size_t size) { _vl_save_write(m_fd, wp, size); }
+#ifdef VL_THREADED
+    void writerLoop() {
+        while (true) {
+            Chunk chunk;
+            {
+                VerilatedLockGuard lock(m_mutex);
+                while (m_pending.empty() && !m_closing) m_cv.wait(lock);
+                if (m_pending.empty()) break;
+                chunk = m_pending.front();
+                m_pending.pop_front();
+            }
+            write(chunk.m_bufp, chunk.m_size);
+            {
+                VerilatedLockGuard lock(m_mutex);
+                m_pendingBytes -= chunk.m_size;
+                m_free.push_back(chunk.m_bufp);
+            }
+            m_cv.notify_all();
+        }
+        ::close(m_fd);  // May get error, just ignore it
+        {
+            VerilatedLockGuard lock(m_mutex);
+            m_done = true;
+        }
+        m_cv.notify_all();
+    }
+#endif
+};
+
+VerilatedSaveAsync::VerilatedSaveAsync()
+    : m_impp{new VerilatedSaveAsyncImp} {}
+
+VerilatedSaveAsync::~VerilatedSaveAsync() {
+    close();
+    wait();
+    VL_DO_CLEAR(delete m_impp, m_impp = nullptr);
+}
+
+void VerilatedSaveAsync::open(const char* filenamep) VL_MT_UNSAFE_ONE {
+    m_assertOne.check();
+    if (isOpen()) return;
+    wait();
+    VL_DEBUG_IF(VL_DBG_MSGF("- save: opening async save file %s\n", filenamep););
+    // cppcheck-suppress duplicateExpression
+    m_impp->m_fd = ::open(filenamep, O_CREAT | O_WRONLY | O_TRUNC | O_LARGEFILE | O_CLOEXEC, 0666);
+    if (VL_UNLIKELY(m_impp->m_fd < 0)) {
+        // User code can check isOpen()
+        m_isOpen = false;
+        return;
+    }
+#ifdef VL_THREADED
+    {
+        VerilatedLockGuard lock(m_impp->m_mutex);
+        m_impp->m_closing = false;
+        m_impp->m_done = false;
+    }
+    m_impp->m_thread = std::thread(&VerilatedSaveAsyncImp::writerLoop, m_impp);
+#endif
+    m_isOpen = true;
+    m_filename = filenamep;
+    m_cp = m_bufp;
+    header();
+}
+
+void VerilatedSaveAsync::close() VL_MT_UNSAFE_ONE {
+    if (!isOpen()) return;
+    trailer();
+    flush();
+    m_isOpen = false;
+#ifdef VL_THREADED
+    {
+        VerilatedLockGuard lock(m_impp->m_mutex);
+        m_impp->m_closing = true;
+    }
+    m_impp->m_cv.notify_all();
+#else
+    ::close(m_impp->m_fd);  // May get error, just ignore it
+#endif
+}
+
+void VerilatedSaveAsync::flush() VL_MT_UNSAFE_ONE {
+    m_assertOne.check();
+    if (VL_UNLIKELY(!isOpen())) return;
+    const size_t size = m_cp - m_bufp;
+    if (!size) return;
+#ifdef VL_THREADED
+    // Hand the filled buffer to the writer, and continue in a free one
+    vluint8_t* nextp = nullptr;
+    {
+        VerilatedLockGuard lock(m_impp->m_mutex);
+        while (m_impp->m_maxPending && !m_impp->m_pending.empty()
+               && (m_impp->m_pendingBytes + size) > m_impp->m_maxPending) {
+            m_impp->m_cv.wait(lock);
+        }
+        m_impp->m_pending.push_back({m_bufp, size});
+        m_impp->m_pendingBytes += size;
+        if (!m_impp->m_free.empty()) {
+            nextp = m_impp->m_free.back();
+            m_impp->m_free.pop_back();
+        }
+    }
+    m_impp->m_cv.notify_all();
+    m_bufp = nextp ? nextp : new vluint8_t[bufferSize()];
+#else
+    m_impp->write(m_bufp, size);
+#endif
+    m_cp = m_bufp;  // Reset buffer
+}
+
+void VerilatedSaveAsync::wait() VL_MT_UNSAFE_ONE {
+#ifdef VL_THREADED
+    if (m_impp->m_thread.joinable()) m_impp->m_thread.join();
+#endif
+}
+
+bool VerilatedSaveAsync::busy() const VL_MT_UNSAFE_ONE {
+#ifdef VL_THREADED
+    VerilatedLockGuard lock(m_impp->m_mutex);
+    return !m_impp->m_done;
+#else
+    return false;
+#endif
+}
+
+void VerilatedSaveAsync::maxPendingBytes(size_t bytes) VL_MT_UNSAFE_ONE {
+    m_impp->m_maxPending = bytes;
+}
+
+//=============================================================================
+// VerilatedSaveDelta
+// A delta file is the delta header, the previous image's region count and
+// region sizes, then for each changed page its region, page index, size and
+// contents, then VLTSAVE_DELTA_END, the new image's region count and region
+// sizes, and the delta trailer.  The "image" is exactly what VerilatedSave
+// would have written.
+
+void VerilatedSaveDelta::open(const char* filenamep) VL_MT_UNSAFE_ONE {
+    m_assertOne.check();
+    if (isOpen()) return;
+    m_delta = m_based;
+    VL_DEBUG_IF(VL_DBG_MSGF("- save: opening %s save file %s\n", m_delta ? "delta" : "full",
+                            filenamep););
+    // cppcheck-suppress duplicateExpression
+    m_fd = ::open(filenamep, O_CREAT | O_WRONLY | O_TRUNC | O_LARGEFILE | O_CLOEXEC, 0666);
+    if (VL_UNLIKELY(m_fd < 0)) {
+        // User code can check isOpen()
+        m_isOpen = false;
+        return;
+    }
+    m_isOpen = true;
+    m_filename = filenamep;
+    m_cp = m_bufp;
+    m_region.clear();
+    m_regionNum = 0;
+    m_pages = 0;
+    m_dirtyPages = 0;
+    if (m_delta) {
+        assert((strlen(VLTSAVE_DELTA_HEADER_STR) & 7) == 0);  // Keep aligned
+        writeFd(VLTSAVE_DELTA_HEADER_STR, strlen(VLTSAVE_DELTA_HEADER_STR));
+        writeRegionSizes();
+    }
+    header();
+}
+
+void VerilatedSaveDelta::close() VL_MT_UNSAFE_ONE {
+    if (!isOpen()) return;
+    trailer();
+    regionDone();
+    m_prevRegions.resize(m_regionNum);
+    m_based = true;
+    if (m_delta) {
+        const vluint64_t end[3] = {VLTSAVE_DELTA_END, 0, 0};
+        writeFd(end, sizeof(end));
+        writeRegionSizes();
+        writeFd(VLTSAVE_DELTA_TRAILER_STR, strlen(VLTSAVE_DELTA_TRAILER_STR));
+    }
+    VL_DEBUG_IF(VL_DBG_MSGF("- save: wrote %" VL_PRI64 "u of %" VL_PRI64 "u pages to %s\n",
+                            static_cast<vluint64_t>(m_dirtyPages),
+                            static_cast<vluint64_t>(m_pages), m_filename.c_str()););
+    m_isOpen = false;
+    ::close(m_fd);  // May get error, just ignore it
+}
+
+void VerilatedSaveDelta::rebase() VL_MT_UNSAFE_ONE {
+    m_assertOne.check();
+    m_based = false;
+    m_prevRegions.clear();
+}
+
+void VerilatedSaveDelta::writeFd(const void* datap, size_t size) VL_MT_UNSAFE_ONE {
+    _vl_save_write(m_fd, datap, size);
+}
+
+void VerilatedSaveDelta::writeRegionSizes() VL_MT_UNSAFE_ONE {
+    // Region count, then the size of each region of m_prevRegions
+    std::vector<vluint64_t> sizes;
+    sizes.reserve(m_prevRegions.size() + 1);
+    sizes.push_back(m_prevRegions.size());
+    for (const auto& region : m_prevRegions) sizes.push_back(region.size());
+    writeFd(sizes.data(), sizes.size() * sizeof(vluint64_t));
+}
+
+void VerilatedSaveDelta::flush() VL_MT_UNSAFE_ONE {
+    m_assertOne.check();
+    if (VL_UNLIKELY(!isOpen())) return;
+    if (!m_delta) writeFd(m_bufp, m_cp - m_bufp);
+    m_region.insert(m_region.end(), m_bufp, m_cp);
+    m_cp = m_bufp;  // Reset buffer
+}
+
+void VerilatedSaveDelta::regionDone() VL_MT_UNSAFE_ONE {
+    if (VL_UNLIKELY(!isOpen())) return;
+    flush();
+    if (m_regionNum >= m_prevRegions.size()) m_prevRegions.emplace_back();
+    std::vector<vluint8_t>& prev = m_prevRegions[m_regionNum];
+    // A delta writes only pages that differ from the same page of the last image
+    for (size_t start = 0; start < m_region.size(); start += pageSize()) {
+        const size_t size = std::min(pageSize(), m_region.size() - start);
+        const size_t prevSize
+            = start < prev.size() ? std::min(pageSize(), prev.size() - start) : 0;
+        ++m_pages;
+        if (m_delta && size == prevSize && 0 == memcmp(&m_region[start], &prev[start], size)) {
+            continue;
+        }
+        ++m_dirtyPages;
+        if (m_delta) {
+            const vluint64_t rec[3] = {m_regionNum, start / pageSize(), size};
+            writeFd(rec, sizeof(rec));
+            writeFd(&m_region[start], size);
+        }
+    }
+    prev.swap(m_region);
+    m_region.clear();
+    ++m_regionNum;
+}
+
+//=============================================================================
+// VerilatedRestoreMmap
+
+void VerilatedRestoreMmap::open(const char* filenamep) VL_MT_UNSAFE_ONE {
+    m_assertOne.check();
+    if (isOpen()) return;
+    VL_DEBUG_IF(VL_DBG_MSGF("- restore: mapping restore file %s\n", filenamep););
+    // cppcheck-suppress duplicateExpression
+    const int fd = ::open(filenamep, O_RDONLY | O_LARGEFILE | O_CLOEXEC);
+    if (VL_UNLIKELY(fd < 0)) {
+        // User code can check isOpen()
+        m_isOpen = false;
+        return;
+    }
+    const off_t size = ::lseek(fd, 0, SEEK_END);
+    m_mapSize = size < 0 ? 0 : size;
+    m_mapp = nullptr;
+    m_mapped = false;
+#if !defined(_WIN32) || defined(__CYGWIN__)
+    if (m_mapSize) {
+        void* const mapp = ::mmap(nullptr, m_mapSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapp != MAP_FAILED) {
+            ::madvise(mapp, m_mapSize, MADV_SEQUENTIAL);
+            m_mapp = static_cast<vluint8_t*>(mapp);
+            m_mapped = true;
+        }
+    }
+#endif
+    if (!m_mapped) {
+        // Can't map, so read the whole file instead
+        m_mapp = new vluint8_t[m_mapSize + 1];
+        if (VL_UNLIKELY(!_vl_save_read_at(fd, 0, m_mapp, m_mapSize))) m_mapSize = 0;
+    }
+    ::close(fd);  // Mapping holds its own reference; may get error, just ignore it
+    m_isOpen = true;
+    m_filename = filenamep;
+    // Deserialize straight from the file contents
+    m_bufp = m_mapp;
+    m_cp = m_mapp;
+    m_endp = m_mapp + m_mapSize;
+    header();
+}
+
+void VerilatedRestoreMmap::close() VL_MT_UNSAFE_ONE {
+    if (!isOpen()) return;
+    trailer();
+    flush();
+    m_isOpen = false;
+    m_bufp = m_ownBufp;
+#if !defined(_WIN32) || defined(__CYGWIN__)
+    if (m_mapped) ::munmap(m_mapp, m_mapSize);
+#endif
+    if (!m_mapped) delete[] m_mapp;
+    m_mapp = nullptr;
+}
+
+void VerilatedRestoreMmap::fill() VL_MT_UNSAFE_ONE {
+    m_assertOne.check();
+    if (VL_UNLIKELY(!isOpen())) return;
+    // Within bufferInsertSize() of the end of the file; move the tail to our
+    // own buffer. (No memcpy, overlaps allowed when already there)
+    vluint8_t* rp = m_ownBufp;
+    for (vluint8_t* sp = m_cp; sp < m_endp; *rp++ = *sp++) {}
+    m_bufp = m_ownBufp;
+    m_cp = m_bufp;
+    m_endp = rp;
+    // Fill buffer from here to end with NULLs so reader's don't
+    // need to check eof each character.
+    while (m_endp < m_bufp + bufferSize()) *m_endp++ = '\0';
+}
+
+//=============================================================================
+// VerilatedRestoreDelta
+
+void VerilatedRestoreDelta::open(const std::vector<std::string>& filenames) VL_MT_UNSAFE_ONE {
+    m_assertOne.check();
+    if (isOpen() || filenames.empty()) return;
+    m_regions.clear();
+    for (const std::string& filename : filenames) {
+        VL_DEBUG_IF(VL_DBG_MSGF("- restore: opening restore file %s\n", filename.c_str()););
+        // cppcheck-suppress duplicateExpression
+        const int fd = ::open(filename.c_str(), O_RDONLY | O_LARGEFILE | O_CLOEXEC);
+        if (VL_UNLIKELY(fd < 0)) {
+            // User code can check isOpen()
+            closeFds();
+            return;
+        }
+        m_fds.push_back(fd);
+        m_filename = filename;
+        if (m_fds.size() == 1) {
+            // Full checkpoint; the file is the image
+            const off_t size = ::lseek(fd, 0, SEEK_END);
+            m_imageSize = size < 0 ? 0 : size;
+        } else if (VL_UNLIKELY(!openDelta(fd))) {
+            std::string msg = "Can't restore; delta checkpoint is corrupt or does not follow the"
+                              " previous checkpoint: "
+                              + filename;
+            VL_FATAL_MT(filename.c_str(), 0, "", msg.c_str());
+            closeFds();
+            return;
+        }
+    }
+    // Pages in image order
+    m_pages.clear();
+    if (m_regions.empty()) {
+        Region region;
+        addPages(region, m_fds[0], 0, m_imageSize);
+        m_pages.swap(region);
+    } else {
+        for (const Region& region : m_regions) {
+            m_pages.insert(m_pages.end(), region.begin(), region.end());
+        }
+    }
+    m_isOpen = true;
+    m_cp = m_bufp;
+    m_endp = m_bufp;
+    m_readPage = 0;
+    m_readOffset = 0;
+    header();
+}
+
+void VerilatedRestoreDelta::addPages(Region& region, int fd, vluint64_t offset,
+                                     vluint64_t size) {
+    // Pages of a region stored contiguously in a file
+    for (vluint64_t start = 0; start < size; start += pageSize()) {
+        region.push_back({fd, offset + start, std::min<vluint64_t>(pageSize(), size - start)});
+    }
+}
+
+bool VerilatedRestoreDelta::openDelta(int fd) VL_MT_UNSAFE_ONE {
+    // Read the page index of a delta file; returns false if it is not valid
+    vluint64_t offset = 0;
+    const auto readAt = [&](void* datap, size_t size) {
+        const bool ok = _vl_save_read_at(fd, offset, datap, size);
+        offset += size;
+        return ok;
+    };
+    const auto readSizes = [&](vluint64_t count, std::vector<vluint64_t>& sizes) {
+        // Check against the file size before allocating
+        const vluint64_t fileSize = static_cast<vluint64_t>(::lseek(fd, 0, SEEK_END));
+        if (count > fileSize / sizeof(vluint64_t)) return false;
+        sizes.resize(count);
+        return count == 0 || readAt(sizes.data(), count * sizeof(vluint64_t));
+    };
+    const size_t headerSize = strlen(VLTSAVE_DELTA_HEADER_STR);
+    char header[16];
+    if (!readAt(header, headerSize) || 0 != memcmp(header, VLTSAVE_DELTA_HEADER_STR, headerSize)) {
+        return false;
+    }
+    // Layout of the previous image, which must be the one we have
+    vluint64_t count;
+    std::vector<vluint64_t> sizes;
+    if (!readAt(&count, sizeof(count)) || !readSizes(count, sizes)) return false;
+    if (m_fds.size() == 2) {
+        // Previous is the full checkpoint, which has no layout of its own
+        vluint64_t start = 0;
+        m_regions.resize(sizes.size());
+        for (size_t r = 0; r < sizes.size(); ++r) {
+            addPages(m_regions[r], m_fds[0], start, sizes[r]);
+            start += sizes[r];
+        }
+        if (start != m_imageSize) return false;
+    } else {
+        if (sizes.size() != m_regions.size()) return false;
+        for (size_t r = 0; r < sizes.size(); ++r) {
+            vluint64_t size = 0;
+            for (const PageSrc& src : m_regions[r]) size += src.m_size;
+            if (size != sizes[r]) return false;
+        }
+    }
+    // Changed pages
+    std::map<std::pair<vluint64_t, vluint64_t>, PageSrc> changed;
+    while (true) {
+        vluint64_t rec[3];  // Region, page index and size
+        if (!readAt(rec, sizeof(rec))) return false;
+        if (rec[0] == VLTSAVE_DELTA_END) break;
+        if (rec[2] > pageSize()) return false;
+        changed[std::make_pair(rec[0], rec[1])] = {fd, offset, rec[2]};
+        offset += rec[2];
+    }
+    // Layout of the new image; each page is changed, or unchanged from the previous
+    if (!readAt(&count, sizeof(count)) || !readSizes(count, sizes)) return false;
+    std::vector<Region> regions(sizes.size());
+    m_imageSize = 0;
+    for (size_t r = 0; r < sizes.size(); ++r) {
+        for (vluint64_t start = 0; start < sizes[r]; start += pageSize()) {
+            const vluint64_t page = start / pageSize();
+            const vluint64_t size = std::min<vluint64_t>(pageSize(), sizes[r] - start);
+            const auto it = changed.find(std::make_pair(r, page));
+            if (it != changed.end()) {
+                if (it->second.m_size != size) return false;
+                regions[r].push_back(it->second);
+            } else if (r < m_regions.size() && page < m_regions[r].size()
+                       && m_regions[r][page].m_size == size) {
+                regions[r].push_back(m_regions[r][page]);
+            } else {
+                return false;
+            }
+        }
+        m_imageSize += sizes[r];
+    }
+    m_regions.swap(regions);
+    if (!readAt(header, strlen(VLTSAVE_DELTA_TRAILER_STR))
+        || 0 != memcmp(header, VLTSAVE_DELTA_TRAILER_STR, strlen(VLTSAVE_DELTA_TRAILER_STR))) {
+        return false;
+    }
+    return true;
+}
+
+void VerilatedRestoreDelta::closeFds() VL_MT_UNSAFE_ONE {
+    for (int fd : m_fds) ::close(fd);  // May get error, just ignore it
+    m_fds.clear();
+    m_regions.clear();
+    m_pages.clear();
+}
+
+void VerilatedRestoreDelta::close() VL_MT_UNSAFE_ONE {
+    if (!isOpen()) return;
+    trailer();
+    flush();
+    m_isOpen = false;
+    closeFds();
+}
+
+void VerilatedRestoreDelta::fill() VL_MT_UNSAFE_ONE {
+    m_assertOne.check();
+    if (VL_UNLIKELY(!isOpen())) return;
+    // Move remaining characters down to start of buffer.  (No memcpy, overlaps allowed)
+    vluint8_t* rp = m_bufp;
+    for (vluint8_t* sp = m_cp; sp < m_endp; *rp++ = *sp++) {}
+    m_endp = m_bufp + (m_endp - m_cp);
+    m_cp = m_bufp;  // Reset buffer
+    // Read into buffer starting at m_endp, each page from the newest file holding it
+    while (m_endp < m_bufp + bufferSize()) {
+        if (m_readPage >= m_pages.size()) {
+            // Fill buffer from here to end with NULLs so reader's don't
+            // need to check eof each character.
+            while (m_endp < m_bufp + bufferSize()) *m_endp++ = '\0';
+            break;
+        }
+        const PageSrc& src = m_pages[m_readPage];
+        vluint64_t blk = src.m_size - m_readOffset;
+        if (blk > static_cast<vluint64_t>(m_bufp + bufferSize() - m_endp)) {
+            blk = m_bufp + bufferSize() - m_endp;
+        }
+        if (VL_UNCOVERABLE(
+                !_vl_save_read_at(src.m_fd, src.m_offset + m_readOffset, m_endp, blk))) {
+            // LCOV_EXCL_START
+            std::string msg = std::string(__FUNCTION__) + ": " + strerror(errno);
+            VL_FATAL_MT("", 0, "", msg.c_str());
+            close();
+            break;
+            // LCOV_EXCL_STOP
+        }
+        m_endp += blk;
+        m_readOffset += blk;
+        if (m_readOffset == src.m_size) {
+            ++m_readPage;
+            m_readOffset = 0;
+        }
+    }
+}
+
 //=============================================================================
 // Serialization of types
@@ -23,6 +23,7 @@
 #include "verilated_heavy.h"
 
 #include <string>
+#include <vector>
 
 //=============================================================================
 // VerilatedSerialize - convert structures to a stream representation
@@ -35,6 +36,7 @@ protected:
     vluint8_t* m_cp;  ///< Current pointer into m_bufp buffer
     vluint8_t* m_bufp;  ///< Output buffer
     bool m_isOpen = false;  ///< True indicates open file/stream
+    bool m_trackRegions = false;  ///< Call regionDone() at each region()
     std::string m_filename;  ///< Filename, for error messages
     VerilatedAssertOneThread m_assertOne;  ///< Assert only called from single thread
 
@@ -43,6 +45,7 @@ protected:
 
     void header() VL_MT_UNSAFE_ONE;
     void trailer() VL_MT_UNSAFE_ONE;
+    virtual void regionDone() VL_MT_UNSAFE_ONE {}
 
     // CONSTRUCTORS
     VL_UNCOPYABLE(VerilatedSerialize);
@@ -67,12 +70,18 @@ public:
             bufferCheck();
             size_t blk = size;
             if (blk > bufferInsertSize()) blk = bufferInsertSize();
-            const vluint8_t* __restrict maxp = dp + blk;
-            for (; dp < maxp; *m_cp++ = *dp++) {}
+            memcpy(m_cp, dp, blk);
+            m_cp += blk;
+            dp += blk;
             size -= blk;
         }
         return *this;  // For function chaining
     }
+    /// Start a new region of the image, e.g. at a variable whose size may
+    /// change.  VerilatedSaveDelta pages each region separately.
+    void region() VL_MT_UNSAFE_ONE {
+        if (VL_UNLIKELY(m_trackRegions)) regionDone();
+    }
 
 private:
     VerilatedSerialize& bufferCheck() VL_MT_UNSAFE_ONE {
@@ -128,8 +137,9 @@ public:
             bufferCheck();
             size_t blk = size;
             if (blk > bufferInsertSize()) blk = bufferInsertSize();
-            const vluint8_t* __restrict maxp = dp + blk;
-            for (; dp < maxp; *dp++ = *m_cp++) {}
+            memcpy(dp, m_cp, blk);
+            m_cp += blk;
+            dp += blk;
             size -= blk;
         }
         return *this;  // For function chaining
@@ -170,6 +180,84 @@ public:
     virtual void flush() override VL_MT_UNSAFE_ONE;
 };
 
+//=============================================================================
+// VerilatedSaveAsync - serialize to a file, writing on a background thread
+// Serializing only copies into staging buffers, which a writer thread then
+// writes to the file, so the simulation may continue as soon as close()
+// returns.  Without VL_THREADED this behaves as VerilatedSave.
+// This class is not thread safe, it must be called by a single thread
+
+class VerilatedSaveAsyncImp;
+
+class VerilatedSaveAsync final : public VerilatedSerialize {
+private:
+    VerilatedSaveAsyncImp* m_impp;  ///< Staging buffers and writer thread
+
+public:
+    // CONSTRUCTORS
+    VerilatedSaveAsync();
+    virtual ~VerilatedSaveAsync() override;
+    // METHODS
+    /// Open the file; call isOpen() to see if errors.  Waits for any previous save.
+    void open(const char* filenamep) VL_MT_UNSAFE_ONE;
+    void open(const std::string& filename) VL_MT_UNSAFE_ONE { open(filename.c_str()); }
+    /// Finish serializing; the file is completed in the background
+    virtual void close() override VL_MT_UNSAFE_ONE;
+    virtual void flush() override VL_MT_UNSAFE_ONE;
+    /// Wait until the last closed save has been completely written
+    void wait() VL_MT_UNSAFE_ONE;
+    /// Return true if the last closed save is still being written
+    bool busy() const VL_MT_UNSAFE_ONE;
+    /// Limit staged but unwritten bytes, serializing blocks beyond this; 0 = no limit
+    void maxPendingBytes(size_t bytes) VL_MT_UNSAFE_ONE;
+};
+
+//=============================================================================
+// VerilatedSaveDelta - serialize to a file, only writing what changed
+// The serialized image is split into regions at each region() call, which
+// the model's serialization makes at variables that may change size and at
+// memories, and each region into pageSize() pages.  The first checkpoint
+// (and the first after rebase()) is a full save, readable by VerilatedRestore.
+// Each later checkpoint is a delta holding only the pages whose contents
+// differ from the previous checkpoint made by this object; restore the chain
+// with VerilatedRestoreDelta.  Pages are compared against a copy of the
+// previous image, so this object holds as much memory as one checkpoint.
+// This class is not thread safe, it must be called by a single thread
+
+class VerilatedSaveDelta final : public VerilatedSerialize {
+private:
+    int m_fd = -1;  ///< File descriptor we're writing to
+    bool m_delta = false;  ///< Writing a delta, rather than a full checkpoint
+    bool m_based = false;  ///< Have a previous checkpoint to make a delta from
+    std::vector<std::vector<vluint8_t>> m_prevRegions;  ///< Regions of the previous image
+    std::vector<vluint8_t> m_region;  ///< Region being accumulated
+    size_t m_regionNum = 0;  ///< Index of m_region
+    size_t m_pages = 0;  ///< Pages in this checkpoint so far
+    size_t m_dirtyPages = 0;  ///< Pages written by this checkpoint
+
+    void writeFd(const void* datap, size_t size) VL_MT_UNSAFE_ONE;
+    void writeRegionSizes() VL_MT_UNSAFE_ONE;
+    virtual void regionDone() override VL_MT_UNSAFE_ONE;
+
+public:
+    // CONSTRUCTORS
+    VerilatedSaveDelta() { m_trackRegions = true; }
+    virtual ~VerilatedSaveDelta() override { close(); }
+    // METHODS
+    static constexpr size_t pageSize() { return 4096; }
+    /// Open the file; call isOpen() to see if errors
+    void open(const char* filenamep) VL_MT_UNSAFE_ONE;
+    void open(const std::string& filename) VL_MT_UNSAFE_ONE { open(filename.c_str()); }
+    virtual void close() override VL_MT_UNSAFE_ONE;
+    virtual void flush() override VL_MT_UNSAFE_ONE;
+    /// Make the next checkpoint a full save, starting a new chain
+    void rebase() VL_MT_UNSAFE_ONE;
+    /// Return true if the open (or last closed) checkpoint is a delta
+    bool isDelta() const { return m_delta; }
+    /// Return pages written by the open (or last closed) checkpoint
+    size_t dirtyPages() const { return m_dirtyPages; }
+};
+
 //=============================================================================
 // VerilatedRestore - deserialize from a file
 // This class is not thread safe, it must be called by a single thread
@@ -192,6 +280,77 @@ public:
     virtual void fill() override VL_MT_UNSAFE_ONE;
 };
 
+//=============================================================================
+// VerilatedRestoreMmap - deserialize from a memory-mapped file
+// The file is mapped read-only and deserialized in place, so restoring costs
+// a single copy of the state, with no read() calls or staging buffer, and
+// processes restoring the same checkpoint share its pages in the OS cache.
+// Reads files from VerilatedSave or VerilatedSaveAsync.
+// This class is not thread safe, it must be called by a single thread
+
+class VerilatedRestoreMmap final : public VerilatedDeserialize {
+private:
+    vluint8_t* m_ownBufp;  ///< Buffer from VerilatedDeserialize, used for the tail
+    vluint8_t* m_mapp = nullptr;  ///< File contents
+    size_t m_mapSize = 0;  ///< Bytes in m_mapp
+    bool m_mapped = false;  ///< m_mapp is from mmap, else from new[]
+
+public:
+    // CONSTRUCTORS
+    VerilatedRestoreMmap()
+        : m_ownBufp{m_bufp} {}
+    virtual ~VerilatedRestoreMmap() override { close(); }
+
+    // METHODS
+    /// Open the file; call isOpen() to see if errors
+    void open(const char* filenamep) VL_MT_UNSAFE_ONE;
+    void open(const std::string& filename) VL_MT_UNSAFE_ONE { open(filename.c_str()); }
+    virtual void close() override VL_MT_UNSAFE_ONE;
+    virtual void flush() override VL_MT_UNSAFE_ONE {}
+    virtual void fill() override VL_MT_UNSAFE_ONE;
+};
+
+//=============================================================================
+// VerilatedRestoreDelta - deserialize from a full checkpoint and its deltas
+// Pages are read on demand from whichever file in the chain last wrote them.
+// This class is not thread safe, it must be called by a single thread
+
+class VerilatedRestoreDelta final : public VerilatedDeserialize {
+private:
+    // TYPES
+    struct PageSrc {
+        int m_fd;  ///< File holding the page's latest contents
+        vluint64_t m_offset;  ///< Offset of the page in m_fd
+        vluint64_t m_size;  ///< Bytes in the page
+    };
+    typedef std::vector<PageSrc> Region;
+    // MEMBERS
+    std::vector<int> m_fds;  ///< File descriptors of the chain
+    std::vector<Region> m_regions;  ///< Pages of each region, once a delta gives the layout
+    std::vector<PageSrc> m_pages;  ///< Source of each page of the image, in order
+    vluint64_t m_imageSize = 0;  ///< Bytes in the reconstructed image
+    size_t m_readPage = 0;  ///< Page holding m_endp
+    vluint64_t m_readOffset = 0;  ///< Offset of m_endp in m_readPage
+
+    static constexpr size_t pageSize() { return VerilatedSaveDelta::pageSize(); }
+    static void addPages(Region& region, int fd, vluint64_t offset, vluint64_t size);
+    bool openDelta(int fd) VL_MT_UNSAFE_ONE;
+    void closeFds() VL_MT_UNSAFE_ONE;
+
+public:
+    // CONSTRUCTORS
+    VerilatedRestoreDelta() = default;
+    virtual ~VerilatedRestoreDelta() override { close(); }
+
+    // METHODS
+    /// Open a full checkpoint followed by its deltas, oldest first;
+    /// call isOpen() to see if errors
+    void open(const std::vector<std::string>& filenames) VL_MT_UNSAFE_ONE;
+    virtual void close() override VL_MT_UNSAFE_ONE;
+    virtual void flush() override VL_MT_UNSAFE_ONE {}
+    virtual void fill() override VL_MT_UNSAFE_ONE;
+};
+
 //=============================================================================
 
 inline VerilatedSerialize& operator<<(VerilatedSerialize& os, vluint64_t& rhs) {
@@ -247,8 +406,39 @@ inline VerilatedDeserialize& operator>>(VerilatedDeserialize& os, std::string& r
     rhs.resize(len);
     return os.read((void*)rhs.data(), len);
 }
-template <class T_Key, class T_Value>
-VerilatedSerialize& operator<<(VerilatedSerialize& os, VlAssocArray<T_Key, T_Value>& rhs) {
+template <class T_Value, std::size_t T_Depth>
+VerilatedSerialize& operator<<(VerilatedSerialize& os, VlPagedUnpacked<T_Value, T_Depth>& rhs) {
+    // Only resident pages are saved; the rest restore to their reset values
+    bool randomize = rhs.randomize();
+    vluint32_t obits = rhs.obits();
+    vluint64_t key = rhs.key();
+    os << randomize << obits << key;
+    for (std::size_t page = 0; page < rhs.pages(); ++page) {
+        const T_Value* pagep = rhs.pagep(page);
+        bool resident = pagep != nullptr;
+        os << resident;
+        if (resident) os.write(pagep, rhs.pageSize() * sizeof(T_Value));
+    }
+    return os;
+}
+template <class T_Value, std::size_t T_Depth>
+VerilatedDeserialize& operator>>(VerilatedDeserialize& os,
+                                 VlPagedUnpacked<T_Value, T_Depth>& rhs) {
+    bool randomize = false;
+    vluint32_t obits = 0;
+    vluint64_t key = 0;
+    os >> randomize >> obits >> key;
+    rhs.reset(randomize, obits, key);
+    for (std::size_t page = 0; page < rhs.pages(); ++page) {
+        bool resident = false;
+        os >> resident;
+        if (resident) os.read(rhs.pageAlloc(page), rhs.pageSize() * sizeof(T_Value));
+    }
+    return os;
+}
+template <class T_Key, class T_Value, class T_Backing>
+VerilatedSerialize& operator<<(VerilatedSerialize& os,
+                               VlAssocArray<T_Key, T_Value, T_Backing>& rhs) {
     os << rhs.atDefault();
     vluint32_t len = rhs.size();
     os << len;
@@ -259,8 +449,9 @@ VerilatedSerialize& operator<<(VerilatedSerialize& os, VlAssocArray<T_Key, T_Val
     }
     return os;
 }
-template <class T_Key, class T_Value>
-VerilatedDeserialize& operator>>(VerilatedDeserialize& os, VlAssocArray<T_Key, T_Value>& rhs) {
+template <class T_Key, class T_Value, class T_Backing>
+VerilatedDeserialize& operator>>(VerilatedDeserialize& os,
+                                 VlAssocArray<T_Key, T_Value, T_Backing>& rhs) {
     os >> rhs.atDefault();
     vluint32_t len = 0;
     os >> len;
@@ -17,7 +17,18 @@
 #include "verilatedos.h"
 #include "verilated_threads.h"
 
+#include <cerrno>
 #include <cstdio>
+#include <cstring>
+
+// clang-format off
+#if defined(__linux)
+# include <linux/perf_event.h>
+# include <sys/ioctl.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+#endif
+// clang-format on
 
 std::atomic<vluint64_t> VlMTaskVertex::s_yields;
 
@@ -32,12 +43,87 @@ VlMTaskVertex::VlMTaskVertex(vluint32_t upstreamDepCount)
     assert(atomic_is_lock_free(&m_upstreamDepsDone));
 }
 
+//=============================================================================
+// VlPerfCounters
+
+static void perfCountersWarn(const char* whyp) {
+    static std::atomic<bool> s_warned{false};
+    if (!s_warned.exchange(true)) {
+        VL_PRINTF_MT("%%Warning: +verilator+prof+threads+counters: %s; counters will read 0\n",
+                     whyp);
+    }
+}
+
+#if defined(__linux)
+// The calling thread's counter group, opened on first read, closed at thread exit
+class VlPerfThreadFds final {
+public:
+    int m_fds[VlPerfCounters::NUM];  // Group leader first
+    bool m_tried = false;  // Open was attempted
+    VlPerfThreadFds() {
+        for (int& fd : m_fds) fd = -1;
+    }
+    ~VlPerfThreadFds() { closeAll(); }
+    void closeAll() {
+        for (int& fd : m_fds) {
+            if (fd >= 0) ::close(fd);
+            fd = -1;
+        }
+    }
+    void open() {
+        m_tried = true;
+        static const vluint64_t configs[VlPerfCounters::NUM]
+            = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES};
+        for (int i = 0; i < VlPerfCounters::NUM; ++i) {
+            struct perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = configs[i];
+            attr.disabled = (i == 0);  // Whole group is enabled through the leader
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP;
+            // This thread, any CPU
+            m_fds[i] = static_cast<int>(
+                syscall(__NR_perf_event_open, &attr, 0, -1, (i ? m_fds[0] : -1), 0));
+            if (m_fds[i] < 0) {
+                perfCountersWarn(strerror(errno));
+                closeAll();
+                return;
+            }
+        }
+        ioctl(m_fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(m_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+};
+static VL_THREAD_LOCAL VlPerfThreadFds t_perfFds;
+#endif
+
+void VlPerfCounters::read(vluint64_t* valuesp) VL_MT_SAFE {
+#if defined(__linux)
+    if (VL_UNLIKELY(!t_perfFds.m_tried)) t_perfFds.open();
+    if (t_perfFds.m_fds[0] >= 0) {
+        // PERF_FORMAT_GROUP: number of counters, then each value
+        vluint64_t buf[1 + NUM];
+        if (::read(t_perfFds.m_fds[0], buf, sizeof(buf)) == sizeof(buf) && buf[0] == NUM) {
+            for (int i = 0; i < NUM; ++i) valuesp[i] = buf[1 + i];
+            return;
+        }
+    }
+#else
+    perfCountersWarn("perf_event is only supported on Linux");
+#endif
+    for (int i = 0; i < NUM; ++i) valuesp[i] = 0;
+}
+
 //=============================================================================
 // VlWorkerThread
 
-VlWorkerThread::VlWorkerThread(VlThreadPool* poolp, bool profiling)
+VlWorkerThread::VlWorkerThread(VlThreadPool* poolp, vluint32_t threadIndex, bool profiling)
     : m_waiting{false}
     , m_poolp{poolp}
+    , m_threadIndex{threadIndex}
     , m_profiling{profiling}  // Must init this last -- after setting up fields that it might read:
     , m_exiting{false}
     , m_cthread{startWorker, this} {}
@@ -50,6 +136,7 @@ VlWorkerThread::~VlWorkerThread() {
 }
 
 void VlWorkerThread::workerLoop() {
+    Verilated::threadIndex(m_threadIndex);
     if (VL_UNLIKELY(m_profiling)) m_poolp->setupProfilingClientThread();
 
     ExecRec work;
@@ -89,7 +176,8 @@ VlThreadPool::VlThreadPool(int nThreads, bool profiling)
     }
     // Create'em
     for (int i = 0; i < nThreads; ++i) {
-        m_workers.push_back(new VlWorkerThread(this, profiling));
+        // Index 0 is the "main" thread, so workers are numbered from 1
+        m_workers.push_back(new VlWorkerThread(this, i + 1, profiling));
     }
     // Set up a profile buffer for the current thread too -- on the
     // assumption that it's the same thread that calls eval and may be
@@ -148,12 +236,16 @@ void VlThreadPool::profileDump(const char* filenamep, vluint64_t ticksElapsed) {
             Verilated::profThreadsStart());
     fprintf(fp, "VLPROF arg +verilator+prof+threads+window+%u\n", Verilated::profThreadsWindow());
     fprintf(fp, "VLPROF stat yields %" VL_PRI64 "u\n", VlMTaskVertex::yields());
+    const bool counters = Verilated::profThreadsCounters();
 
     vluint32_t thread_id = 0;
     for (const auto& pi : m_allProfiles) {
         ++thread_id;
 
         bool printing = false;  // False while in warmup phase
+        vluint64_t busy = 0;  // Ticks running mtasks
+        vluint64_t spin = 0;  // Ticks spinning for upstream mtasks
+        vluint64_t yield = 0;  // Ticks yielding the CPU for upstream mtasks
         for (const auto& ei : *pi) {
             switch (ei.m_type) {
             case VlProfileRec::TYPE_BARRIER:  //
@@ -161,18 +253,123 @@ void VlThreadPool::profileDump(const char* filenamep, vluint64_t ticksElapsed) {
                 break;
             case VlProfileRec::TYPE_MTASK_RUN:
                 if (!printing) break;
+                busy += ei.m_endTime - ei.m_startTime;
+                spin += ei.spinTicks();
+                yield += ei.m_yieldTicks;
                 fprintf(fp,
                         "VLPROF mtask %d"
                         " start %" VL_PRI64 "u end %" VL_PRI64 "u elapsed %" VL_PRI64 "u"
-                        " predict_time %u cpu %u on thread %u\n",
+                        " predict_time %u cpu %u on thread %u wait %" VL_PRI64 "u"
+                        " spin %" VL_PRI64 "u yield %" VL_PRI64 "u",
                         ei.m_mtaskId, ei.m_startTime, ei.m_endTime,
-                        (ei.m_endTime - ei.m_startTime), ei.m_predictTime, ei.m_cpu, thread_id);
+                        (ei.m_endTime - ei.m_startTime), ei.m_predictTime, ei.m_cpu, thread_id,
+                        (ei.m_startTime - ei.m_waitTime), ei.spinTicks(), ei.m_yieldTicks);
+                for (int i = 0; counters && i < VlPerfCounters::NUM; ++i) {
+                    fprintf(fp, " %s %" VL_PRI64 "u", VlPerfCounters::name(i), ei.m_counters[i]);
+                }
+                fprintf(fp, "\n");
                 break;
             default: assert(false); break;  // LCOV_EXCL_LINE
             }
         }
+        // Idle is the rest of the window: between evals, or with no mtask ready
+        const vluint64_t wait = spin + yield;
+        const vluint64_t idle = ticksElapsed > busy + wait ? ticksElapsed - busy - wait : 0;
+        fprintf(fp,
+                "VLPROF thread %u busy %" VL_PRI64 "u wait %" VL_PRI64 "u spin %" VL_PRI64
+                "u yield %" VL_PRI64 "u idle %" VL_PRI64 "u\n",
+                thread_id, busy, wait, spin, yield, idle);
     }
     fprintf(fp, "VLPROF stat ticks %" VL_PRI64 "u\n", ticksElapsed);
 
     fclose(fp);
+
+    if (Verilated::profThreadsJsonFilenamep()) {
+        profileDumpJson(Verilated::profThreadsJsonFilenamep(), ticksElapsed);
+    }
+}
+
+void VlThreadPool::profileDumpJson(const char* filenamep, vluint64_t ticksElapsed) {
+    // Chrome trace-event format, for chrome://tracing or ui.perfetto.dev
+    VL_DEBUG_IF(VL_DBG_MSGF("+prof+threads writing trace to '%s'\n", filenamep););
+    FILE* fp = fopen(filenamep, "w");
+    if (VL_UNLIKELY(!fp)) {
+        VL_FATAL_MT(filenamep, 0, "", "+prof+threads+json file not writable");
+        // cppcheck-suppress resourceLeak   // bug, doesn't realize fp is nullptr
+        return;  // LCOV_EXCL_LINE
+    }
+
+    // Trace times are in microseconds; the barrier recorded both clocks,
+    // so measure the tick rate over the time since
+    double ticksPerUs = 0.0;
+    for (const auto& pi : m_allProfiles) {
+        for (const auto& ei : *pi) {
+            if (ei.m_type != VlProfileRec::TYPE_BARRIER || !ei.m_startTime) continue;
+            const VlProfileRec now{VlProfileRec::Barrier()};
+            if (now.m_endTime > ei.m_endTime && now.m_startTime > ei.m_startTime) {
+                ticksPerUs = static_cast<double>(now.m_startTime - ei.m_startTime) * 1000.0
+                             / static_cast<double>(now.m_endTime - ei.m_endTime);
+            }
+            break;
+        }
+        if (ticksPerUs != 0.0) break;
+    }
+    if (ticksPerUs <= 0.0) ticksPerUs = 1000.0;  // No usable clock; show ticks as ns
+
+    const bool counters = Verilated::profThreadsCounters();
+    fprintf(fp, "{\"displayTimeUnit\": \"ns\",\n");
+    fprintf(fp,
+            " \"otherData\": {\"threads\": %u, \"ticks\": %" VL_PRI64
+            "u, \"ticks_per_us\": %.3f},\n",
+            static_cast<unsigned>(m_workers.size() + 1), ticksElapsed, ticksPerUs);
+    fprintf(fp, " \"traceEvents\": [\n");
+    const char* sep = "  ";
+    vluint32_t thread_id = 0;
+    for (const auto& pi : m_allProfiles) {
+        ++thread_id;
+        fprintf(fp,
+                "%s{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": %u,"
+                " \"args\": {\"name\": \"thread %u\"}}",
+                sep, thread_id, thread_id);
+        sep = ",\n  ";
+        bool printing = false;  // False while in warmup phase
+        for (const auto& ei : *pi) {
+            if (ei.m_type == VlProfileRec::TYPE_BARRIER) {
+                printing = true;
+                continue;
+            }
+            if (!printing) continue;
+            if (ei.m_startTime > ei.m_waitTime) {
+                fprintf(fp,
+                        "%s{\"name\": \"wait\", \"cat\": \"wait\", \"ph\": \"X\","
+                        " \"ts\": %.3f, \"dur\": %.3f, \"pid\": 0, \"tid\": %u,"
+                        " \"args\": {\"mtask\": %u, \"spin\": %" VL_PRI64 "u,"
+                        " \"yield\": %" VL_PRI64 "u}}",
+                        sep, ei.m_waitTime / ticksPerUs,
+                        (ei.m_startTime - ei.m_waitTime) / ticksPerUs, thread_id, ei.m_mtaskId,
+                        ei.spinTicks(), ei.m_yieldTicks);
+            }
+            fprintf(fp,
+                    "%s{\"name\": \"mtask %u\", \"cat\": \"mtask\", \"ph\": \"X\","
+                    " \"ts\": %.3f, \"dur\": %.3f, \"pid\": 0, \"tid\": %u,"
+                    " \"args\": {\"elapsed\": %" VL_PRI64 "u, \"predict\": %u, \"cpu\": %u",
+                    sep, ei.m_mtaskId, ei.m_startTime / ticksPerUs,
+                    (ei.m_endTime - ei.m_startTime) / ticksPerUs, thread_id,
+                    ei.m_endTime - ei.m_startTime, ei.m_predictTime, ei.m_cpu);
+            if (counters) {
+                for (int i = 0; i < VlPerfCounters::NUM; ++i) {
+                    fprintf(fp, ", \"%s\": %" VL_PRI64 "u", VlPerfCounters::name(i),
+                            ei.m_counters[i]);
+                }
+                const vluint64_t cycles = ei.m_counters[VlPerfCounters::CYCLES];
+                fprintf(fp, ", \"ipc\": %.3f",
+                        cycles ? static_cast<double>(ei.m_counters[VlPerfCounters::INSTRUCTIONS])
+                                     / cycles
+                               : 0.0);
+            }
+            fprintf(fp, "}}");
+        }
+    }
+    fprintf(fp, "\n ]\n}\n");
+    fclose(fp);
 }
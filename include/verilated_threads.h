@@ -31,6 +31,7 @@
 #error "verilated_threads.h/cpp expected VL_THREADED (from verilator --threads)"
 #endif
 
+#include <chrono>
 #include <condition_variable>
 #include <set>
 #include <vector>
@@ -121,6 +122,36 @@ public:
             }
         }
     }
+    // As waitUntilUpstreamDone, when profiling.  Returns the ticks spent
+    // yielding, so the profile can tell them from the ticks spent spinning.
+    vluint64_t waitUntilUpstreamDoneYieldTicks(bool evenCycle) const {
+        vluint64_t yieldTicks = 0;
+        unsigned ct = 0;
+        while (VL_UNLIKELY(!areUpstreamDepsDone(evenCycle))) {
+            VL_CPU_RELAX();
+            ++ct;
+            if (VL_UNLIKELY(ct > VL_LOCK_SPINS)) {
+                ct = 0;
+                const vluint64_t start = VL_RDTSC_Q();
+                yieldThread();
+                yieldTicks += VL_RDTSC_Q() - start;
+            }
+        }
+        return yieldTicks;
+    }
+};
+
+// Hardware performance counters for profiling, per thread
+class VlPerfCounters final {
+public:
+    enum en { CYCLES, INSTRUCTIONS, LLC_MISSES, NUM };
+    static const char* name(int counter) {
+        static const char* const names[] = {"cycles", "instructions", "llc_misses"};
+        return names[counter];
+    }
+    // Read the calling thread's counters, opening them on first use.
+    // Reads zeros if perf_event is not available.
+    static void read(vluint64_t* valuesp) VL_MT_SAFE;
 };
 
 // Profiling support
@@ -131,21 +162,49 @@ protected:
     VlProfileE m_type = TYPE_BARRIER;  // Record type
     vluint32_t m_mtaskId = 0;  // Mtask we're logging
     vluint32_t m_predictTime = 0;  // How long scheduler predicted would take
-    vluint64_t m_startTime = 0;  // Tick at start of execution
-    vluint64_t m_endTime = 0;  // Tick at end of execution
+    vluint64_t m_waitTime = 0;  // Tick at start of waiting for upstream mtasks
+    vluint64_t m_yieldTicks = 0;  // Ticks of the wait spent yielding, rest is spinning
+    vluint64_t m_startTime = 0;  // Tick at start of execution; barrier: absolute tick
+    vluint64_t m_endTime = 0;  // Tick at end of execution; barrier: steady_clock ns
+    vluint64_t m_counters[VlPerfCounters::NUM] = {};  // Counts during execution
     unsigned m_cpu;  // Execution CPU number (at start anyways)
 public:
     class Barrier {};
     VlProfileRec() = default;
-    explicit VlProfileRec(Barrier) { m_cpu = getcpu(); }
-    void startRecord(vluint64_t time, uint32_t mtask, uint32_t predict) {
+    explicit VlProfileRec(Barrier) {
+        // Both clocks, so the dump can convert ticks to time
+        m_startTime = VL_RDTSC_Q();
+        m_endTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch())
+                        .count();
+        m_cpu = getcpu();
+    }
+    void waitRecord(vluint64_t time) { m_waitTime = time; }
+    void yieldRecord(vluint64_t ticks) { m_yieldTicks = ticks; }
+    vluint64_t spinTicks() const {
+        const vluint64_t wait = m_startTime - m_waitTime;
+        return wait > m_yieldTicks ? wait - m_yieldTicks : 0;
+    }
+    // Start and end ticks are read here, relative to cycleStart, so the
+    // counter reads fall outside the timed interval
+    void startRecord(vluint64_t cycleStart, uint32_t mtask, uint32_t predict) {
         m_type = VlProfileRec::TYPE_MTASK_RUN;
         m_mtaskId = mtask;
         m_predictTime = predict;
-        m_startTime = time;
         m_cpu = getcpu();
+        if (VL_UNLIKELY(Verilated::profThreadsCounters())) VlPerfCounters::read(m_counters);
+        const vluint64_t time = VL_RDTSC_Q() - cycleStart;
+        if (!m_waitTime) m_waitTime = time;  // Did not wait
+        m_startTime = time;
+    }
+    void endRecord(vluint64_t cycleStart) {
+        m_endTime = VL_RDTSC_Q() - cycleStart;
+        if (VL_UNLIKELY(Verilated::profThreadsCounters())) {
+            vluint64_t ends[VlPerfCounters::NUM];
+            VlPerfCounters::read(ends);
+            for (int i = 0; i < VlPerfCounters::NUM; ++i) m_counters[i] = ends[i] - m_counters[i];
+        }
     }
-    void endRecord(vluint64_t time) { m_endTime = time; }
     static int getcpu() {  // Return current executing CPU
 #if defined(__linux)
         return sched_getcpu();
@@ -199,6 +258,7 @@ private:
     std::atomic<size_t> m_ready_size;
 
     VlThreadPool* m_poolp;  // Our associated thread pool
+    vluint32_t m_threadIndex;  // Verilated::threadIndex() of this worker
 
     bool m_profiling;  // Is profiling enabled?
     std::atomic<bool> m_exiting;  // Worker thread should exit
@@ -208,7 +268,7 @@ private:
 
 public:
     // CONSTRUCTORS
-    explicit VlWorkerThread(VlThreadPool* poolp, bool profiling);
+    VlWorkerThread(VlThreadPool* poolp, vluint32_t threadIndex, bool profiling);
     ~VlWorkerThread();
 
     // METHODS
@@ -293,6 +353,7 @@ public:
     void tearDownProfilingClientThread();
 
 private:
+    void profileDumpJson(const char* filenamep, vluint64_t ticksElapsed) VL_REQUIRES(m_mutex);
     VL_UNCOPYABLE(VlThreadPool);
 };
 
@@ -0,0 +1,170 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Select associative array backing containers
+//
+// Code available from: https://verilator.org
+//
+//*************************************************************************
+//
+// Copyright 2003-2020 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+// V3Assoc's Transformations:
+//
+// Each associative array variable:
+//    Record how every reference uses it.  If the variable is only ever
+//    indexed, or passed to methods that do not depend on index order,
+//    and the key is integral or a string:
+//      Give it a HASH backed dtype (VlAssocHash)
+//    Else if the key is integral, and the variable is only indexed or
+//    passed to array methods:
+//      Give it a PAGED backed dtype (VlAssocPaged)
+//    Otherwise (whole-array assignment, argument passing, %p, class
+//    members, public signals, etc.) it keeps the std::map backing, so all
+//    types stay compatible.
+//
+//*************************************************************************
+
+#include "config_build.h"
+#include "verilatedos.h"
+
+#include "V3Global.h"
+#include "V3Assoc.h"
+#include "V3Stats.h"
+#include "V3Ast.h"
+
+#include <map>
+#include <vector>
+
+//######################################################################
+
+class AssocVisitor final : public AstNVisitor {
+private:
+    // TYPES
+    enum : int {
+        USE_ORDERED = 1,  // Used by a method that depends on index order
+        USE_OTHER = 2  // Used other than as an index or method, must keep type
+    };
+    typedef std::map<std::pair<AstAssocArrayDType*, int>, AstAssocArrayDType*> DTypeMap;
+
+    // NODE STATE
+    // AstVar::user1()       -> int.  USE_* flags
+    AstUser1InUse m_inuser1;
+
+    // STATE
+    VDouble0 m_statHash;  // Statistic tracking
+    VDouble0 m_statPaged;  // Statistic tracking
+    AstNodeModule* m_modp = nullptr;  // Current module
+    std::vector<AstVar*> m_vars;  // Associative array variables, in netlist order
+    DTypeMap m_dtypes;  // New dtypes, by original dtype and backing
+
+    // METHODS
+    VL_DEBUG_FUNC;  // Declare debug()
+
+    static AstAssocArrayDType* assocDTypep(const AstVar* varp) {
+        return VN_CAST(varp->dtypeSkipRefp(), AssocArrayDType);
+    }
+    static bool orderFree(const string& name) {
+        // Array methods whose result does not depend on index order
+        return name == "exists" || name == "erase" || name == "clear" || name == "size"
+               || name == "r_sum" || name == "r_product" || name == "r_and" || name == "r_or"
+               || name == "r_xor";
+    }
+    static void use(AstVar* varp, int flags) { varp->user1(varp->user1() | flags); }
+    AstAssocArrayDType* backedDTypep(AstAssocArrayDType* adtypep, VAssocBacking backing) {
+        const auto key = std::make_pair(adtypep, static_cast<int>(backing));
+        const auto it = m_dtypes.find(key);
+        if (it != m_dtypes.end()) return it->second;
+        AstAssocArrayDType* const newp = new AstAssocArrayDType(
+            adtypep->fileline(), adtypep->subDTypep(), adtypep->keyDTypep(), backing);
+        v3Global.rootp()->typeTablep()->addTypesp(newp);
+        m_dtypes.emplace(key, newp);
+        return newp;
+    }
+    void selectBackings() {
+        for (AstVar* varp : m_vars) {
+            if (varp->user1() & USE_OTHER) continue;
+            AstAssocArrayDType* const adtypep = assocDTypep(varp);
+            const AstNodeDType* const keyp = adtypep->keyDTypep()->skipRefp();
+            const AstBasicDType* const basicp = keyp->basicp();
+            const bool integral = basicp && !basicp->isOpaque() && !keyp->isWide();
+            const bool isString = basicp && basicp->isString();
+            VAssocBacking backing;
+            if (!(varp->user1() & USE_ORDERED) && (integral || isString)) {
+                backing = VAssocBacking::HASH;
+                ++m_statHash;
+            } else if (integral) {
+                backing = VAssocBacking::PAGED;
+                ++m_statPaged;
+            } else {
+                continue;
+            }
+            UINFO(4, "  Assoc " << backing << " " << varp << endl);
+            varp->dtypep(backedDTypep(adtypep, backing));
+        }
+    }
+
+    // VISITORS
+    virtual void visit(AstNetlist* nodep) override {
+        iterateChildren(nodep);
+        selectBackings();
+    }
+    virtual void visit(AstNodeModule* nodep) override {
+        VL_RESTORER(m_modp);
+        {
+            m_modp = nodep;
+            iterateChildren(nodep);
+        }
+    }
+    virtual void visit(AstVar* nodep) override {
+        if (!assocDTypep(nodep)) return;
+        m_vars.push_back(nodep);
+        // Class members are referenced via other classes; ports and public
+        // signals are seen by other code, so these must keep their type
+        if (VN_IS(m_modp, Class) || nodep->isIO() || nodep->isSigPublic()) {
+            use(nodep, USE_OTHER);
+        }
+    }
+    virtual void visit(AstNodeVarRef* nodep) override {
+        AstVar* const varp = nodep->varp();
+        if (!varp || !assocDTypep(varp)) return;
+        AstNode* const backp = nodep->backp();
+        if (const AstAssocSel* const selp = VN_CAST(backp, AssocSel)) {
+            if (selp->fromp() == nodep) return;  // Indexing; order free
+        } else if (const AstCMethodHard* const callp = VN_CAST(backp, CMethodHard)) {
+            if (callp->fromp() == nodep) {
+                use(varp, orderFree(callp->name()) ? 0 : USE_ORDERED);
+                return;
+            }
+        } else if (const AstNodeReadWriteMem* const memp = VN_CAST(backp, NodeReadWriteMem)) {
+            if (memp->memp() == nodep) {
+                use(varp, USE_ORDERED);
+                return;
+            }
+        }
+        use(varp, USE_OTHER);
+    }
+    virtual void visit(AstNodeDType*) override {}  // Accelerate
+    virtual void visit(AstNode* nodep) override { iterateChildren(nodep); }
+
+public:
+    // CONSTRUCTORS
+    explicit AssocVisitor(AstNetlist* nodep) { iterate(nodep); }
+    virtual ~AssocVisitor() override {
+        V3Stats::addStat("Optimizations, Assoc arrays hashed", m_statHash);
+        V3Stats::addStat("Optimizations, Assoc arrays paged", m_statPaged);
+    }
+};
+
+//######################################################################
+// Assoc class functions
+
+void V3Assoc::assocAll(AstNetlist* nodep) {
+    UINFO(2, __FUNCTION__ << ": " << endl);
+    { AssocVisitor visitor(nodep); }  // Destruct before checking
+    V3Global::dumpCheckGlobalTree("assoc", 0, v3Global.opt.dumpTreeLevel(__FILE__) >= 3);
+}
@@ -397,7 +397,8 @@ public:
         VAR_SFORMAT,                    // V3LinkParse moves to AstVar::attrSFormat
         VAR_CLOCKER,                    // V3LinkParse moves to AstVar::attrClocker
         VAR_NO_CLOCKER,                 // V3LinkParse moves to AstVar::attrClocker
-        VAR_SPLIT_VAR                   // V3LinkParse moves to AstVar::attrSplitVar
+        VAR_SPLIT_VAR,                  // V3LinkParse moves to AstVar::attrSplitVar
+        VAR_LAZY_ARRAY                  // V3LinkParse moves to AstVar::attrLazyArray
     };
     // clang-format on
     enum en m_e;
@@ -415,7 +416,7 @@ public:
             "VAR_BASE", "VAR_CLOCK_ENABLE", "VAR_PUBLIC",
             "VAR_PUBLIC_FLAT", "VAR_PUBLIC_FLAT_RD", "VAR_PUBLIC_FLAT_RW",
             "VAR_ISOLATE_ASSIGNMENTS", "VAR_SC_BV", "VAR_SFORMAT", "VAR_CLOCKER",
-            "VAR_NO_CLOCKER", "VAR_SPLIT_VAR"
+            "VAR_NO_CLOCKER", "VAR_SPLIT_VAR", "VAR_LAZY_ARRAY"
         };
         // clang-format on
         return names[m_e];
@@ -1077,6 +1078,42 @@ inline std::ostream& operator<<(std::ostream& os, const VUseType& rhs) {
 
 //######################################################################
 
+class VAssocBacking final {
+public:
+    enum en : uint8_t {
+        ORDERED,  // std::map; any key, any use
+        HASH,  // Hash table; never iterated in index order
+        PAGED  // Sparse pages; integral keys
+    };
+    enum en m_e;
+    inline VAssocBacking()
+        : m_e{ORDERED} {}
+    // cppcheck-suppress noExplicitConstructor
+    inline VAssocBacking(en _e)
+        : m_e{_e} {}
+    explicit inline VAssocBacking(int _e)
+        : m_e(static_cast<en>(_e)) {}  // Need () or GCC 4.8 false warning
+    operator en() const { return m_e; }
+    const char* ascii() const {
+        static const char* const names[] = {"ordered", "hash", "paged"};
+        return names[m_e];
+    }
+    const char* cType() const {  // VlAssocArray backing template argument
+        static const char* const names[] = {"VlAssocOrdered", "VlAssocHash", "VlAssocPaged"};
+        return names[m_e];
+    }
+};
+inline bool operator==(const VAssocBacking& lhs, const VAssocBacking& rhs) {
+    return lhs.m_e == rhs.m_e;
+}
+inline bool operator==(const VAssocBacking& lhs, VAssocBacking::en rhs) { return lhs.m_e == rhs; }
+inline bool operator==(VAssocBacking::en lhs, const VAssocBacking& rhs) { return lhs == rhs.m_e; }
+inline std::ostream& operator<<(std::ostream& os, const VAssocBacking& rhs) {
+    return os << rhs.ascii();
+}
+
+//######################################################################
+
 class VBasicTypeKey final {
 public:
     int m_width;  // From AstNodeDType: Bit width of operation
@@ -2458,6 +2495,7 @@ public:
         return (isString() ? "N" : isWide() ? "W" : isQuad() ? "Q" : "I");
     }
     string cType(const string& name, bool forFunc, bool isRef) const;
+    string cTypeCompound() const;  // Type as a template argument, e.g. VlWide<3> not WData[3]
 
 private:
     class CTypeRecursed;
@@ -2678,6 +2716,7 @@ class AstNodeFTask VL_NOT_FINAL : public AstNode {
 private:
     string m_name;  // Name of task
     string m_cname;  // Name of task if DPI import
+    string m_dpiGroups;  // DPI import hazard groups, comma separated
     uint64_t m_dpiOpenParent = 0;  // DPI import open array, if !=0, how many callees
     bool m_taskPublic : 1;  // Public task
     bool m_attrIsolateAssign : 1;  // User isolate_assignments attribute
@@ -2688,6 +2727,7 @@ private:
     bool m_dpiExport : 1;  // DPI exported
     bool m_dpiImport : 1;  // DPI imported
     bool m_dpiContext : 1;  // DPI import context
+    bool m_dpiAsync : 1;  // DPI import called asynchronously (dpi_async)
     bool m_dpiOpenChild : 1;  // DPI import open array child wrapper
     bool m_dpiTask : 1;  // DPI import task (vs. void function)
     bool m_isConstructor : 1;  // Class constructor
@@ -2710,6 +2750,7 @@ public:
         , m_dpiExport{false}
         , m_dpiImport{false}
         , m_dpiContext{false}
+        , m_dpiAsync{false}
         , m_dpiOpenChild{false}
         , m_dpiTask{false}
         , m_isConstructor{false}
@@ -2767,6 +2808,13 @@ public:
     bool dpiImport() const { return m_dpiImport; }
     void dpiContext(bool flag) { m_dpiContext = flag; }
     bool dpiContext() const { return m_dpiContext; }
+    void dpiAsync(bool flag) { m_dpiAsync = flag; }
+    bool dpiAsync() const { return m_dpiAsync; }
+    string dpiGroups() const { return m_dpiGroups; }
+    void addDpiGroups(const string& groups) {
+        if (groups.empty()) return;
+        m_dpiGroups += (m_dpiGroups.empty() ? "" : ",") + groups;
+    }
     void dpiOpenChild(bool flag) { m_dpiOpenChild = flag; }
     bool dpiOpenChild() const { return m_dpiOpenChild; }
     void dpiTask(bool flag) { m_dpiTask = flag; }
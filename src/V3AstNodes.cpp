@@ -213,8 +213,9 @@ AstNodeBiop* AstEqWild::newTyped(FileLine* fl, AstNode* lhsp, AstNode* rhsp) {
     }
 }
 
-AstExecGraph::AstExecGraph(FileLine* fileline)
-    : AstNode{AstType::atExecGraph, fileline} {
+AstExecGraph::AstExecGraph(FileLine* fileline, bool settle)
+    : AstNode{AstType::atExecGraph, fileline}
+    , m_settle{settle} {
     m_depGraphp = new V3Graph;
 }
 AstExecGraph::~AstExecGraph() { VL_DO_DANGLING(delete m_depGraphp, m_depGraphp); }
@@ -327,6 +328,12 @@ string AstVar::vlArgType(bool named, bool forReturn, bool forFunc, const string&
         if (!namespc.empty()) oname += namespc + "::";
         oname += VIdProtect::protectIf(name(), protect());
     }
+    if (isLazyArray()) {
+        const AstUnpackArrayDType* adtypep = VN_CAST(dtypeSkipRefp(), UnpackArrayDType);
+        UASSERT_OBJ(adtypep, this, "Lazy array not unpacked array");
+        return ostatic + "VlPagedUnpacked<" + adtypep->subDTypep()->cTypeCompound() + ", "
+               + cvtToStr(adtypep->elementsConst()) + "> " + oname;
+    }
     return ostatic + dtypep()->cType(oname, forFunc, isRef);
 }
 
@@ -634,6 +641,8 @@ string AstNodeDType::cType(const string& name, bool forFunc, bool isRef) const {
     return info.render(name, isRef);
 }
 
+string AstNodeDType::cTypeCompound() const { return cTypeRecurse(true).m_type; }
+
 AstNodeDType::CTypeRecursed AstNodeDType::cTypeRecurse(bool compound) const {
     CTypeRecursed info;
 
@@ -641,7 +650,11 @@ AstNodeDType::CTypeRecursed AstNodeDType::cTypeRecurse(bool compound) const {
     if (const auto* adtypep = VN_CAST_CONST(dtypep, AssocArrayDType)) {
         const CTypeRecursed key = adtypep->keyDTypep()->cTypeRecurse(true);
         const CTypeRecursed val = adtypep->subDTypep()->cTypeRecurse(true);
-        info.m_type = "VlAssocArray<" + key.m_type + ", " + val.m_type + ">";
+        info.m_type = "VlAssocArray<" + key.m_type + ", " + val.m_type;
+        if (adtypep->backing() != VAssocBacking::ORDERED) {
+            info.m_type += std::string(", ") + adtypep->backing().cType();
+        }
+        info.m_type += ">";
     } else if (const auto* adtypep = VN_CAST_CONST(dtypep, DynArrayDType)) {
         const CTypeRecursed sub = adtypep->subDTypep()->cTypeRecurse(true);
         info.m_type = "VlQueue<" + sub.m_type + ">";
@@ -1483,6 +1496,10 @@ void AstMTaskBody::dump(std::ostream& str) const {
     str << " ";
     m_execMTaskp->dump(str);
 }
+void AstExecGraph::dump(std::ostream& str) const {
+    this->AstNode::dump(str);
+    if (settle()) str << " [SETTLE]";
+}
 void AstTypeTable::dump(std::ostream& str) const {
     this->AstNode::dump(str);
     for (int i = 0; i < static_cast<int>(AstBasicDTypeKwd::_ENUM_MAX); ++i) {
@@ -1506,7 +1523,9 @@ void AstTypeTable::dump(std::ostream& str) const {
 }
 void AstAssocArrayDType::dumpSmall(std::ostream& str) const {
     this->AstNodeDType::dumpSmall(str);
-    str << "[assoc-" << reinterpret_cast<const void*>(keyDTypep()) << "]";
+    str << "[assoc-" << reinterpret_cast<const void*>(keyDTypep());
+    if (backing() != VAssocBacking::ORDERED) str << "-" << backing();
+    str << "]";
 }
 string AstAssocArrayDType::prettyDTypeName() const {
     return subDTypep()->prettyDTypeName() + "[" + keyDTypep()->prettyDTypeName() + "]";
@@ -1652,6 +1671,8 @@ void AstNodeFTask::dump(std::ostream& str) const {
     if (taskPublic()) str << " [PUBLIC]";
     if (prototype()) str << " [PROTOTYPE]";
     if (dpiImport()) str << " [DPII]";
+    if (dpiAsync()) str << " [DPIASYNC]";
+    if (!dpiGroups().empty()) str << " [DPIGROUP " << dpiGroups() << "]";
     if (dpiExport()) str << " [DPIX]";
     if (dpiOpenChild()) str << " [DPIOPENCHILD]";
     if (dpiOpenParent()) str << " [DPIOPENPARENT]";
@@ -1729,6 +1750,8 @@ void AstCFunc::dump(std::ostream& str) const {
         str << " [STATIC]";
     }
     if (dpiImport()) str << " [DPII]";
+    if (dpiAsync()) str << " [DPIASYNC]";
+    if (!dpiGroups().empty()) str << " [DPIGROUP " << dpiGroups() << "]";
     if (dpiExport()) str << " [DPIX]";
     if (dpiExportWrapper()) str << " [DPIXWR]";
     if (isConstructor()) str << " [CTOR]";
@@ -521,6 +521,7 @@ class AstAssocArrayDType final : public AstNodeDType {
 private:
     AstNodeDType* m_refDTypep;  // Elements of this type (after widthing)
     AstNodeDType* m_keyDTypep;  // Keys of this type (after widthing)
+    VAssocBacking m_backing;  // Runtime container, see V3Assoc
 public:
     AstAssocArrayDType(FileLine* fl, VFlagChildDType, AstNodeDType* dtp, AstNodeDType* keyDtp)
         : ASTGEN_SUPER(fl) {
@@ -530,6 +531,14 @@ public:
         keyDTypep(nullptr);
         dtypep(nullptr);  // V3Width will resolve
     }
+    AstAssocArrayDType(FileLine* fl, AstNodeDType* dtp, AstNodeDType* keyDtp,
+                       VAssocBacking backing)
+        : ASTGEN_SUPER(fl)
+        , m_backing{backing} {
+        refDTypep(dtp);
+        keyDTypep(keyDtp);
+        dtypep(this);
+    }
     ASTNODE_NODE_FUNCS(AssocArrayDType)
     virtual const char* broken() const override {
         BROKEN_RTN(!((m_refDTypep && !childDTypep() && m_refDTypep->brokeExists())
@@ -546,7 +555,8 @@ public:
         const AstAssocArrayDType* asamep = static_cast<const AstAssocArrayDType*>(samep);
         if (!asamep->subDTypep()) return false;
         if (!asamep->keyDTypep()) return false;
-        return (subDTypep() == asamep->subDTypep() && keyDTypep() == asamep->keyDTypep());
+        return (subDTypep() == asamep->subDTypep() && keyDTypep() == asamep->keyDTypep()
+                && m_backing == asamep->m_backing);
     }
     virtual bool similarDType(AstNodeDType* samep) const override {
         const AstAssocArrayDType* asamep = static_cast<const AstAssocArrayDType*>(samep);
@@ -576,6 +586,7 @@ public:
     // op1 = Range of variable
     AstNodeDType* keyChildDTypep() const { return VN_CAST(op2p(), NodeDType); }
     void keyChildDTypep(AstNodeDType* nodep) { setOp2p(nodep); }
+    VAssocBacking backing() const { return m_backing; }
     // METHODS
     virtual AstBasicDType* basicp() const override { return nullptr; }
     virtual AstNodeDType* skipRefp() const override { return (AstNodeDType*)this; }
@@ -1935,6 +1946,9 @@ private:
     bool m_attrIsolateAssign : 1;  // User isolate_assignments attribute
     bool m_attrSFormat : 1;  // User sformat attribute
     bool m_attrSplitVar : 1;  // declared with split_var metacomment
+    bool m_attrLazyArray : 1;  // declared with lazy_array metacomment
+    bool m_isLazyArray : 1;  // Stored as VlPagedUnpacked, allocated on first access
+    bool m_isRandStream : 1;  // State of a random stream (--rand-streams)
     bool m_fileDescr : 1;  // File descriptor
     bool m_isRand : 1;  // Random variable
     bool m_isConst : 1;  // Table contains constant data
@@ -1975,6 +1989,9 @@ private:
         m_attrIsolateAssign = false;
         m_attrSFormat = false;
         m_attrSplitVar = false;
+        m_attrLazyArray = false;
+        m_isLazyArray = false;
+        m_isRandStream = false;
         m_fileDescr = false;
         m_isRand = false;
         m_isConst = false;
@@ -2111,6 +2128,9 @@ public:
     void attrIsolateAssign(bool flag) { m_attrIsolateAssign = flag; }
     void attrSFormat(bool flag) { m_attrSFormat = flag; }
     void attrSplitVar(bool flag) { m_attrSplitVar = flag; }
+    void attrLazyArray(bool flag) { m_attrLazyArray = flag; }
+    void isLazyArray(bool flag) { m_isLazyArray = flag; }
+    void isRandStream(bool flag) { m_isRandStream = flag; }
     void usedClock(bool flag) { m_usedClock = flag; }
     void usedParam(bool flag) { m_usedParam = flag; }
     void usedLoopIdx(bool flag) { m_usedLoopIdx = flag; }
@@ -2209,6 +2229,9 @@ public:
     bool attrScClocked() const { return m_scClocked; }
     bool attrSFormat() const { return m_attrSFormat; }
     bool attrSplitVar() const { return m_attrSplitVar; }
+    bool attrLazyArray() const { return m_attrLazyArray; }
+    bool isLazyArray() const { return m_isLazyArray; }
+    bool isRandStream() const { return m_isRandStream; }
     bool attrIsolateAssign() const { return m_attrIsolateAssign; }
     VVarAttrClocker attrClocker() const { return m_attrClocker; }
     virtual string verilogKwd() const override;
@@ -5498,9 +5521,10 @@ public:
                        : (m_urandom ? "%f$urandom()" : "%f$random()");
     }
     virtual string emitC() override {
-        return m_reset
-                   ? "VL_RAND_RESET_%nq(%nw, %P)"
-                   : seedp() ? "VL_RANDOM_SEEDED_%nq%lq(%nw, %P, %li)" : "VL_RANDOM_%nq(%nw, %P)";
+        return m_reset     ? "VL_RAND_RESET_%nq(%nw, %P)"
+               : seedp()   ? "VL_RANDOM_SEEDED_%nq%lq(%nw, %P, %li)"
+               : streamp() ? "VL_RANDOM_STREAM_%nq(%nw, %P, %ri)"
+                           : "VL_RANDOM_%nq(%nw, %P)";
     }
     virtual bool cleanOut() const override { return true; }
     virtual bool isGateOptimizable() const override { return false; }
@@ -5509,6 +5533,8 @@ public:
     virtual V3Hash sameHash() const override { return V3Hash(); }
     virtual bool same(const AstNode* samep) const override { return true; }
     AstNode* seedp() const { return op1p(); }
+    AstNode* streamp() const { return op2p(); }  // Random stream state (--rand-streams)
+    void streamp(AstNode* nodep) { setOp2p(nodep); }
     bool reset() const { return m_reset; }
     bool urandom() const { return m_urandom; }
 };
@@ -5528,7 +5554,10 @@ public:
         V3ERROR_NA;
     }
     virtual string emitVerilog() override { return "%f$urandom_range(%l, %r)"; }
-    virtual string emitC() override { return "VL_URANDOM_RANGE_%nq(%li, %ri)"; }
+    virtual string emitC() override {
+        return streamp() ? "VL_URANDOM_RANGE_STREAM_%nq(%li, %ri, %ti)"
+                         : "VL_URANDOM_RANGE_%nq(%li, %ri)";
+    }
     virtual bool cleanOut() const override { return true; }
     virtual bool cleanLhs() const override { return true; }
     virtual bool cleanRhs() const override { return true; }
@@ -5537,6 +5566,8 @@ public:
     virtual bool isGateOptimizable() const override { return false; }
     virtual bool isPredictOptimizable() const override { return false; }
     virtual int instrCount() const override { return instrCountPli(); }
+    AstNode* streamp() const { return op3p(); }  // Random stream state (--rand-streams)
+    void streamp(AstNode* nodep) { setOp3p(nodep); }
 };
 
 class AstTime final : public AstNodeTermop {
@@ -5618,7 +5649,7 @@ public:
     ASTNODE_NODE_FUNCS(Negate)
     virtual void numberOperate(V3Number& out, const V3Number& lhs) override { out.opNegate(lhs); }
     virtual string emitVerilog() override { return "%f(- %l)"; }
-    virtual string emitC() override { return "VL_NEGATE_%lq(%lW, %P, %li)"; }
+    virtual string emitC() override { return "VL_NEGATE_%lq%lT(%lW, %P, %li)"; }
     virtual string emitSimpleOperator() override { return "-"; }
     virtual bool cleanOut() const override { return false; }
     virtual bool cleanLhs() const override { return false; }
@@ -5664,7 +5695,7 @@ public:
     ASTNODE_NODE_FUNCS(RedOr)
     virtual void numberOperate(V3Number& out, const V3Number& lhs) override { out.opRedOr(lhs); }
     virtual string emitVerilog() override { return "%f(| %l)"; }
-    virtual string emitC() override { return "VL_REDOR_%lq(%lW, %P, %li)"; }
+    virtual string emitC() override { return "VL_REDOR_%lq%lT(%lW, %P, %li)"; }
     virtual bool cleanOut() const override { return true; }
     virtual bool cleanLhs() const override { return true; }
     virtual bool sizeMattersLhs() const override { return false; }
@@ -5678,7 +5709,7 @@ public:
     ASTNODE_NODE_FUNCS(RedXor)
     virtual void numberOperate(V3Number& out, const V3Number& lhs) override { out.opRedXor(lhs); }
     virtual string emitVerilog() override { return "%f(^ %l)"; }
-    virtual string emitC() override { return "VL_REDXOR_%lq(%lW, %P, %li)"; }
+    virtual string emitC() override { return "VL_REDXOR_%lq%lT(%lW, %P, %li)"; }
     virtual bool cleanOut() const override { return false; }
     virtual bool cleanLhs() const override {
         int w = lhsp()->width();
@@ -5727,7 +5758,7 @@ public:
     ASTNODE_NODE_FUNCS(Not)
     virtual void numberOperate(V3Number& out, const V3Number& lhs) override { out.opNot(lhs); }
     virtual string emitVerilog() override { return "%f(~ %l)"; }
-    virtual string emitC() override { return "VL_NOT_%lq(%lW, %P, %li)"; }
+    virtual string emitC() override { return "VL_NOT_%lq%lT(%lW, %P, %li)"; }
     virtual string emitSimpleOperator() override { return "~"; }
     virtual bool cleanOut() const override { return false; }
     virtual bool cleanLhs() const override { return false; }
@@ -6716,7 +6747,7 @@ public:
         out.opOr(lhs, rhs);
     }
     virtual string emitVerilog() override { return "%k(%l %f| %r)"; }
-    virtual string emitC() override { return "VL_OR_%lq(%lW, %P, %li, %ri)"; }
+    virtual string emitC() override { return "VL_OR_%lq%lT(%lW, %P, %li, %ri)"; }
     virtual string emitSimpleOperator() override { return "|"; }
     virtual bool cleanOut() const override { V3ERROR_NA_RETURN(false); }
     virtual bool cleanLhs() const override { return false; }
@@ -6738,7 +6769,7 @@ public:
         out.opAnd(lhs, rhs);
     }
     virtual string emitVerilog() override { return "%k(%l %f& %r)"; }
-    virtual string emitC() override { return "VL_AND_%lq(%lW, %P, %li, %ri)"; }
+    virtual string emitC() override { return "VL_AND_%lq%lT(%lW, %P, %li, %ri)"; }
     virtual string emitSimpleOperator() override { return "&"; }
     virtual bool cleanOut() const override { V3ERROR_NA_RETURN(false); }
     virtual bool cleanLhs() const override { return false; }
@@ -6760,7 +6791,7 @@ public:
         out.opXor(lhs, rhs);
     }
     virtual string emitVerilog() override { return "%k(%l %f^ %r)"; }
-    virtual string emitC() override { return "VL_XOR_%lq(%lW, %P, %li, %ri)"; }
+    virtual string emitC() override { return "VL_XOR_%lq%lT(%lW, %P, %li, %ri)"; }
     virtual string emitSimpleOperator() override { return "^"; }
     virtual bool cleanOut() const override { return false; }  // Lclean && Rclean
     virtual bool cleanLhs() const override { return false; }
@@ -6784,7 +6815,7 @@ public:
         out.opEq(lhs, rhs);
     }
     virtual string emitVerilog() override { return "%k(%l %f== %r)"; }
-    virtual string emitC() override { return "VL_EQ_%lq(%lW, %P, %li, %ri)"; }
+    virtual string emitC() override { return "VL_EQ_%lq%lT(%lW, %P, %li, %ri)"; }
     virtual string emitSimpleOperator() override { return "=="; }
     virtual bool cleanOut() const override { return true; }
     virtual bool cleanLhs() const override { return true; }
@@ -7300,7 +7331,7 @@ public:
         out.opShiftL(lhs, rhs);
     }
     virtual string emitVerilog() override { return "%k(%l %f<< %r)"; }
-    virtual string emitC() override { return "VL_SHIFTL_%nq%lq%rq(%nw,%lw,%rw, %P, %li, %ri)"; }
+    virtual string emitC() override { return "VL_SHIFTL_%nq%lq%rq%nT(%nw,%lw,%rw, %P, %li, %ri)"; }
     virtual string emitSimpleOperator() override { return "<<"; }
     virtual bool cleanOut() const override { return false; }
     virtual bool cleanLhs() const override { return false; }
@@ -7322,7 +7353,7 @@ public:
         out.opShiftR(lhs, rhs);
     }
     virtual string emitVerilog() override { return "%k(%l %f>> %r)"; }
-    virtual string emitC() override { return "VL_SHIFTR_%nq%lq%rq(%nw,%lw,%rw, %P, %li, %ri)"; }
+    virtual string emitC() override { return "VL_SHIFTR_%nq%lq%rq%nT(%nw,%lw,%rw, %P, %li, %ri)"; }
     virtual string emitSimpleOperator() override { return ">>"; }
     virtual bool cleanOut() const override { return false; }
     virtual bool cleanLhs() const override { return true; }
@@ -7371,7 +7402,7 @@ public:
         out.opAdd(lhs, rhs);
     }
     virtual string emitVerilog() override { return "%k(%l %f+ %r)"; }
-    virtual string emitC() override { return "VL_ADD_%lq(%lW, %P, %li, %ri)"; }
+    virtual string emitC() override { return "VL_ADD_%lq%lT(%lW, %P, %li, %ri)"; }
     virtual string emitSimpleOperator() override { return "+"; }
     virtual bool cleanOut() const override { return false; }
     virtual bool cleanLhs() const override { return false; }
@@ -7417,7 +7448,7 @@ public:
         out.opSub(lhs, rhs);
     }
     virtual string emitVerilog() override { return "%k(%l %f- %r)"; }
-    virtual string emitC() override { return "VL_SUB_%lq(%lW, %P, %li, %ri)"; }
+    virtual string emitC() override { return "VL_SUB_%lq%lT(%lW, %P, %li, %ri)"; }
     virtual string emitSimpleOperator() override { return "-"; }
     virtual bool cleanOut() const override { return false; }
     virtual bool cleanLhs() const override { return false; }
@@ -7463,7 +7494,7 @@ public:
         out.opMul(lhs, rhs);
     }
     virtual string emitVerilog() override { return "%k(%l %f* %r)"; }
-    virtual string emitC() override { return "VL_MUL_%lq(%lW, %P, %li, %ri)"; }
+    virtual string emitC() override { return "VL_MUL_%lq%lT(%lW, %P, %li, %ri)"; }
     virtual string emitSimpleOperator() override { return "*"; }
     virtual bool cleanOut() const override { return false; }
     virtual bool cleanLhs() const override { return true; }
@@ -7873,7 +7904,7 @@ public:
         out.opCaseEq(lhs, rhs);
     }
     virtual string emitVerilog() override { return "%k(%l %f=== %r)"; }
-    virtual string emitC() override { return "VL_EQ_%lq(%lW, %P, %li, %ri)"; }
+    virtual string emitC() override { return "VL_EQ_%lq%lT(%lW, %P, %li, %ri)"; }
     virtual string emitSimpleOperator() override { return "=="; }
     virtual bool cleanOut() const override { return true; }
     virtual bool cleanLhs() const override { return true; }
@@ -7920,7 +7951,7 @@ public:
         out.opWildEq(lhs, rhs);
     }
     virtual string emitVerilog() override { return "%k(%l %f==? %r)"; }
-    virtual string emitC() override { return "VL_EQ_%lq(%lW, %P, %li, %ri)"; }
+    virtual string emitC() override { return "VL_EQ_%lq%lT(%lW, %P, %li, %ri)"; }
     virtual string emitSimpleOperator() override { return "=="; }
     virtual bool cleanOut() const override { return true; }
     virtual bool cleanLhs() const override { return true; }
@@ -8814,6 +8845,7 @@ private:
     string m_argTypes;  // Argument types
     string m_ctorInits;  // Constructor sub-class inits
     string m_ifdef;  // #ifdef symbol around this function
+    string m_dpiGroups;  // DPI import wrapper hazard groups, comma separated
     VBoolOrUnknown m_isConst;  // Function is declared const (*this not changed)
     VBoolOrUnknown m_isStatic;  // Function is declared static (no this)
     bool m_dontCombine : 1;  // V3Combine shouldn't compare this func tree, it's special
@@ -8834,6 +8866,7 @@ private:
     bool m_dpiExportWrapper : 1;  // From dpi export; static function with dispatch table
     bool m_dpiImport : 1;  // From dpi import
     bool m_dpiImportWrapper : 1;  // Wrapper from dpi import
+    bool m_dpiAsync : 1;  // Wrapper posts call to VerilatedDpiAsync
 public:
     AstCFunc(FileLine* fl, const string& name, AstScope* scopep, const string& rtnType = "")
         : ASTGEN_SUPER(fl) {
@@ -8861,6 +8894,7 @@ public:
         m_dpiExportWrapper = false;
         m_dpiImport = false;
         m_dpiImportWrapper = false;
+        m_dpiAsync = false;
     }
     ASTNODE_NODE_FUNCS(CFunc)
     virtual string name() const override { return m_name; }
@@ -8910,6 +8944,8 @@ public:
     string ctorInits() const { return m_ctorInits; }
     void ifdef(const string& str) { m_ifdef = str; }
     string ifdef() const { return m_ifdef; }
+    void dpiGroups(const string& str) { m_dpiGroups = str; }
+    string dpiGroups() const { return m_dpiGroups; }
     void funcType(AstCFuncType flag) { m_funcType = flag; }
     AstCFuncType funcType() const { return m_funcType; }
     bool isConstructor() const { return m_isConstructor; }
@@ -8936,6 +8972,8 @@ public:
     void dpiImport(bool flag) { m_dpiImport = flag; }
     bool dpiImportWrapper() const { return m_dpiImportWrapper; }
     void dpiImportWrapper(bool flag) { m_dpiImportWrapper = flag; }
+    bool dpiAsync() const { return m_dpiAsync; }
+    void dpiAsync(bool flag) { m_dpiAsync = flag; }
     //
     // If adding node accessors, see below emptyBody
     AstNode* argsp() const { return op1p(); }
@@ -9003,6 +9041,8 @@ public:
         : ASTGEN_SUPER(oldp, funcp) {}
     virtual bool hasDType() const override { return true; }
     ASTNODE_NODE_FUNCS(CNew)
+    AstNode* streamp() const { return op3p(); }  // Random stream state (--rand-streams)
+    void streamp(AstNode* nodep) { setOp3p(nodep); }
 };
 
 class AstCReturn final : public AstNodeStmt {
@@ -9141,17 +9181,22 @@ class AstExecGraph final : public AstNode {
     // traverse the graph.)
 private:
     V3Graph* m_depGraphp;  // contains ExecMTask's
+    bool m_settle;  // Graph runs settle logic in _eval_settle, not _eval
 public:
-    explicit AstExecGraph(FileLine* fl);
+    AstExecGraph(FileLine* fl, bool settle);
     ASTNODE_NODE_FUNCS_NO_DTOR(ExecGraph)
     virtual ~AstExecGraph() override;
     virtual const char* broken() const override {
         BROKEN_RTN(!m_depGraphp);
         return nullptr;
     }
+    virtual void dump(std::ostream& str = std::cout) const override;
     const V3Graph* depGraphp() const { return m_depGraphp; }
     V3Graph* mutableDepGraphp() { return m_depGraphp; }
     void addMTaskBody(AstMTaskBody* bodyp) { addOp1p(bodyp); }
+    bool settle() const { return m_settle; }
+    // Suffix for the per-graph synchronization members emitted in the top class
+    string stateSuffix() const { return m_settle ? "_settle" : ""; }
 };
 
 class AstSplitPlaceholder final : public AstNode {
@@ -9208,6 +9253,7 @@ private:
     AstPackage* m_dollarUnitPkgp = nullptr;  // $unit
     AstCFunc* m_evalp = nullptr;  // The '_eval' function
     AstExecGraph* m_execGraphp = nullptr;  // Execution MTask graph for threads>1 mode
+    AstExecGraph* m_settleGraphp = nullptr;  // Execution MTask graph for --threads-settle
     VTimescale m_timeunit;  // Global time unit
     VTimescale m_timeprecision;  // Global time precision
 public:
@@ -9253,6 +9299,14 @@ public:
     void evalp(AstCFunc* evalp) { m_evalp = evalp; }
     AstExecGraph* execGraphp() const { return m_execGraphp; }
     void execGraphp(AstExecGraph* graphp) { m_execGraphp = graphp; }
+    AstExecGraph* settleGraphp() const { return m_settleGraphp; }
+    void settleGraphp(AstExecGraph* graphp) { m_settleGraphp = graphp; }
+    std::vector<AstExecGraph*> execGraphps() const {  // All graphs, in emit order
+        std::vector<AstExecGraph*> graphps;
+        if (m_execGraphp) graphps.push_back(m_execGraphp);
+        if (m_settleGraphp) graphps.push_back(m_settleGraphp);
+        return graphps;
+    }
     VTimescale timeunit() const { return m_timeunit; }
     void timeunit(const VTimescale& value) { m_timeunit = value; }
     VTimescale timeprecision() const { return m_timeprecision; }
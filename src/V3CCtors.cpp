@@ -18,6 +18,11 @@
 //      for all AstVar, create a creates a AstCReset node in an _ctor_var_reset AstCFunc.
 //      for all AstCoverDecl, move the declaration into a _configure_coverage AstCFunc.
 //      For each variable that needs reset, add a AstCReset node.
+//      For each random stream (--rand-streams), add its VL_RAND_STREAM_INIT.
+//
+//      Large unpacked arrays (--lazy-array-size or lazy_array) referenced
+//      only by element selects and $readmem/$writemem are marked
+//      isLazyArray, to be allocated a page at a time by VlPagedUnpacked.
 //
 //      For primary inputs, add _eval_debug_assertions.
 //
@@ -33,6 +38,7 @@
 
 #include <algorithm>
 #include <map>
+#include <vector>
 
 class V3CCtorsVisitor final {
 private:
@@ -91,6 +97,73 @@ private:
     VL_UNCOPYABLE(V3CCtorsVisitor);
 };
 
+//######################################################################
+// Decide which unpacked arrays to allocate lazily
+
+class CCtorsLazyArrayVisitor final : public AstNVisitor {
+private:
+    // NODE STATE
+    //  AstVar::user1()         -> bool.  Referenced other than by element or $readmem
+    AstUser1InUse m_inuser1;
+
+    // STATE
+    std::vector<AstVar*> m_candidateps;  // Variables that could be lazy
+
+    // METHODS
+    VL_DEBUG_FUNC;  // Declare debug()
+
+    static bool isCandidate(const AstNodeModule* modp, const AstVar* varp) {
+        if (!VN_IS(modp, Module)) return false;
+        const vluint64_t minBytes = v3Global.opt.lazyArraySize();
+        if (!varp->attrLazyArray() && !minBytes) return false;
+        if (varp->isIO() || varp->isSigPublic() || varp->isParam() || varp->isStatic()
+            || varp->isIfaceParent() || varp->isIfaceRef() || varp->valuep()) {
+            return false;
+        }
+        // One dimension of numbers, so elements are selected with one []
+        const AstUnpackArrayDType* adtypep = VN_CAST(varp->dtypeSkipRefp(), UnpackArrayDType);
+        if (!adtypep || adtypep->isCompound()) return false;
+        const AstNodeDType* elemp = adtypep->subDTypep()->skipRefp();
+        const AstBasicDType* basicp = elemp->basicp();
+        if (VN_IS(elemp, UnpackArrayDType) || !basicp || basicp->isOpaque()) return false;
+        const vluint64_t bytes = static_cast<vluint64_t>(adtypep->elementsConst())
+                                 * static_cast<vluint64_t>(elemp->widthTotalBytes());
+        return varp->attrLazyArray() || bytes >= minBytes;
+    }
+
+    // VISITORS
+    virtual void visit(AstNodeModule* nodep) override {
+        for (AstNode* np = nodep->stmtsp(); np; np = np->nextp()) {
+            AstVar* varp = VN_CAST(np, Var);
+            if (varp && isCandidate(nodep, varp)) m_candidateps.push_back(varp);
+        }
+        iterateChildren(nodep);
+    }
+    virtual void visit(AstNodeVarRef* nodep) override {
+        const AstNode* abovep = nodep->backp();
+        const AstArraySel* selp = VN_CAST_CONST(abovep, ArraySel);
+        const AstNodeReadWriteMem* memp = VN_CAST_CONST(abovep, NodeReadWriteMem);
+        if (!(selp && selp->fromp() == nodep) && !(memp && memp->memp() == nodep)) {
+            nodep->varp()->user1(true);
+        }
+        iterateChildren(nodep);
+    }
+    virtual void visit(AstNode* nodep) override { iterateChildren(nodep); }
+
+public:
+    // CONSTRUCTORS
+    explicit CCtorsLazyArrayVisitor(AstNetlist* nodep) {
+        iterate(nodep);
+        for (AstVar* varp : m_candidateps) {
+            if (!varp->user1()) {
+                UINFO(4, "  Lazy array " << varp << endl);
+                varp->isLazyArray(true);
+            }
+        }
+    }
+    virtual ~CCtorsLazyArrayVisitor() override = default;
+};
+
 //######################################################################
 
 void V3CCtors::evalAsserts() {
@@ -135,6 +208,7 @@ void V3CCtors::evalAsserts() {
 
 void V3CCtors::cctorsAll() {
     UINFO(2, __FUNCTION__ << ": " << endl);
+    { CCtorsLazyArrayVisitor visitor(v3Global.rootp()); }
     evalAsserts();
     for (AstNodeModule* modp = v3Global.rootp()->modulesp(); modp;
          modp = VN_CAST(modp->nextp(), NodeModule)) {
@@ -146,9 +220,21 @@ void V3CCtors::cctorsAll() {
                 (VN_IS(modp, Class) ? "vlSymsp" : ""),
                 (VN_IS(modp, Class) ? "if (false && vlSymsp) {}  // Prevent unused\n" : ""));
 
+            int streamNum = 0;
             for (AstNode* np = modp->stmtsp(); np; np = np->nextp()) {
                 if (AstVar* varp = VN_CAST(np, Var)) {
-                    if (!varp->isIfaceParent() && !varp->isIfaceRef() && !varp->noReset()) {
+                    if (varp->isRandStream()) {
+                        // Class objects have no scope name, so are keyed at runtime by
+                        // the call site that constructed them
+                        var_reset.add(new AstCStmt(
+                            varp->fileline(),
+                            (VN_IS(modp, Class)
+                                 ? "VL_RAND_STREAM_INIT_OBJ(" + varp->nameProtect() + ", \""
+                                       + modp->nameProtect() + "\", "
+                                 : "VL_RAND_STREAM_INIT(" + varp->nameProtect() + ", name(), ")
+                                + cvtToStr(++streamNum) + "ULL);\n"));
+                    } else if (!varp->isIfaceParent() && !varp->isIfaceRef()
+                               && !varp->noReset()) {
                         var_reset.add(
                             new AstCReset(varp->fileline(),
                                           new AstVarRef(varp->fileline(), varp, VAccess::WRITE)));
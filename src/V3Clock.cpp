@@ -380,10 +380,10 @@ private:
                 }
                 // Move statements to if
                 m_lastIfp->addIfsp(stmtsp);
-            } else if (nodep->hasInitial() || nodep->hasSettle()) {
-                nodep->v3fatalSrc("MTask should not include initial/settle logic.");
+            } else if (nodep->hasInitial()) {
+                nodep->v3fatalSrc("MTask should not include initial logic.");
             } else {
-                // Combo logic. Move statements to mtask func.
+                // Combo or settle logic. Move statements to mtask func.
                 clearLastSen();
                 m_mtaskBodyp->addStmtsp(stmtsp);
             }
@@ -430,11 +430,15 @@ private:
             iterate(m_mtaskBodyp);
         }
         clearLastSen();
-        // Move the ExecGraph into _eval. Its location marks the
-        // spot where the graph will execute, relative to other
+        // Move the ExecGraph into _eval (or _eval_settle). Its location
+        // marks the spot where the graph will execute, relative to other
         // (serial) logic in the cycle.
         nodep->unlinkFrBack();
-        addToEvalLoop(nodep);
+        if (nodep->settle()) {
+            addToSettleLoop(nodep);
+        } else {
+            addToEvalLoop(nodep);
+        }
     }
 
     //--------------------
@@ -121,6 +121,7 @@ class V3ConfigFTask final {
     bool m_isolate = false;  // Isolate function return
     bool m_noinline = false;  // Don't inline function/task
     bool m_public = false;  // Public function/task
+    string m_dpiGroups;  // DPI import hazard groups, comma separated
 
 public:
     V3ConfigFTask() = default;
@@ -129,6 +130,7 @@ public:
         if (f.m_isolate) m_isolate = true;
         if (f.m_noinline) m_noinline = true;
         if (f.m_public) m_public = true;
+        addDpiGroups(f.m_dpiGroups);
         m_vars.update(f.m_vars);
     }
 
@@ -137,6 +139,10 @@ public:
     void setIsolate(bool set) { m_isolate = set; }
     void setNoInline(bool set) { m_noinline = set; }
     void setPublic(bool set) { m_public = set; }
+    void addDpiGroups(const string& groups) {
+        if (groups.empty()) return;
+        m_dpiGroups += (m_dpiGroups.empty() ? "" : ",") + groups;
+    }
 
     void apply(AstNodeFTask* ftaskp) const {
         if (m_noinline)
@@ -145,6 +151,7 @@ public:
             ftaskp->addStmtsp(new AstPragma(ftaskp->fileline(), AstPragmaType::PUBLIC_TASK));
         // Only functions can have isolate (return value)
         if (VN_IS(ftaskp, Func)) ftaskp->attrIsolateAssign(m_isolate);
+        ftaskp->addDpiGroups(m_dpiGroups);
     }
 };
 
@@ -400,6 +407,17 @@ void V3Config::addModulePragma(const string& module, AstPragmaType pragma) {
     V3ConfigResolver::s().modules().at(module).addModulePragma(pragma);
 }
 
+void V3Config::addDpiGroup(FileLine* fl, const string& module, const string& ftask,
+                           const string& group) {
+    if (ftask.empty()) {
+        fl->v3error("dpi_group requires -function or -task");
+    } else if (group.empty() || group.find_first_of(", \t") != string::npos) {
+        fl->v3error("dpi_group -group requires a single group name");
+    } else {
+        V3ConfigResolver::s().modules().at(module).ftasks().at(ftask).addDpiGroups(group);
+    }
+}
+
 void V3Config::addInline(FileLine* fl, const string& module, const string& ftask, bool on) {
     if (ftask.empty()) {
         V3ConfigResolver::s().modules().at(module).setInline(on);
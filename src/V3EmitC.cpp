@@ -17,6 +17,8 @@
 #include "config_build.h"
 #include "verilatedos.h"
 
+#include "verilated_fmtprog.h"
+
 #include "V3Global.h"
 #include "V3String.h"
 #include "V3EmitC.h"
@@ -220,6 +222,12 @@ public:
             return lhsp->name() < rhsp->name();
         }
     };
+    static bool isProfSampleFunc(const AstCFunc* funcp) {
+        // Constructors have no address to take, and virtual functions no fixed address
+        return v3Global.opt.profSample() && funcp->isMethod() && !funcp->skipDecl()
+               && !funcp->dpiImport() && !funcp->isConstructor() && !funcp->isDestructor()
+               && !funcp->isVirtual();
+    }
     void emitIntFuncDecls(AstNodeModule* modp, bool methodFuncs) {
         typedef std::vector<const AstCFunc*> FuncVec;
         FuncVec funcsp;
@@ -248,24 +256,29 @@ public:
             puts("(" + cFuncArgs(funcp) + ")");
             if (funcp->isConst().trueKnown()) puts(" const");
             if (funcp->slow()) puts(" VL_ATTR_COLD");
+            if (isProfSampleFunc(funcp)) {
+                puts(funcp->isInline() ? " VL_ATTR_PROF_SAMPLE_INLINE" : " VL_ATTR_PROF_SAMPLE");
+            }
             puts(";\n");
             if (!funcp->ifdef().empty()) puts("#endif  // " + funcp->ifdef() + "\n");
         }
 
         if (methodFuncs && modp->isTop() && v3Global.opt.mtasks()) {
             // Emit the mtask func prototypes.
-            AstExecGraph* execGraphp = v3Global.rootp()->execGraphp();
-            UASSERT_OBJ(execGraphp, v3Global.rootp(), "Root should have an execGraphp");
-            const V3Graph* depGraphp = execGraphp->depGraphp();
-            for (const V3GraphVertex* vxp = depGraphp->verticesBeginp(); vxp;
-                 vxp = vxp->verticesNextp()) {
-                const ExecMTask* mtp = dynamic_cast<const ExecMTask*>(vxp);
-                if (mtp->threadRoot()) {
-                    // Emit function declaration for this mtask
-                    ofp()->putsPrivate(true);
-                    puts("static void ");
-                    puts(protect(mtp->cFuncName()));
-                    puts("(bool even_cycle, void* symtab);\n");
+            UASSERT_OBJ(v3Global.rootp()->execGraphp(), v3Global.rootp(),
+                        "Root should have an execGraphp");
+            for (const AstExecGraph* execGraphp : v3Global.rootp()->execGraphps()) {
+                const V3Graph* depGraphp = execGraphp->depGraphp();
+                for (const V3GraphVertex* vxp = depGraphp->verticesBeginp(); vxp;
+                     vxp = vxp->verticesNextp()) {
+                    const ExecMTask* mtp = dynamic_cast<const ExecMTask*>(vxp);
+                    if (mtp->threadRoot()) {
+                        // Emit function declaration for this mtask
+                        ofp()->putsPrivate(true);
+                        puts("static void ");
+                        puts(protect(mtp->cFuncName()));
+                        puts("(bool even_cycle, void* symtab);\n");
+                    }
                 }
             }
             // No AstCFunc for this one, as it's synthetic. Just write it:
@@ -463,9 +476,15 @@ public:
     }
     virtual void visit(AstCoverDecl* nodep) override {
         puts("__vlCoverInsert(");  // As Declared in emitCoverageDecl
-        puts("&(vlSymsp->__Vcoverage[");
-        puts(cvtToStr(nodep->dataDeclThisp()->binNum()));
-        puts("])");
+        if (coverShards()) {
+            puts("vlSymsp->__Vcoverage.binp(");
+            puts(cvtToStr(nodep->dataDeclThisp()->binNum()));
+            puts(")");
+        } else {
+            puts("&(vlSymsp->__Vcoverage[");
+            puts(cvtToStr(nodep->dataDeclThisp()->binNum()));
+            puts("])");
+        }
         // If this isn't the first instantiation of this module under this
         // design, don't really count the bucket, and rely on verilator_cov to
         // aggregate counts.  This is because Verilator combines all
@@ -490,7 +509,15 @@ public:
         puts(");\n");
     }
     virtual void visit(AstCoverInc* nodep) override {
-        if (v3Global.opt.threads()) {
+        if (coverShards()) {
+            puts("vlSymsp->__Vcoverage.inc(");
+            puts(cvtToStr(nodep->declp()->dataDeclThisp()->binNum()));
+            puts(");\n");
+        } else if (v3Global.opt.coverageCounterWidth() == 64) {
+            puts("vlCoverSatInc(vlSymsp->__Vcoverage[");
+            puts(cvtToStr(nodep->declp()->dataDeclThisp()->binNum()));
+            puts("]);\n");
+        } else if (v3Global.opt.threads()) {
             puts("vlSymsp->__Vcoverage[");
             puts(cvtToStr(nodep->declp()->dataDeclThisp()->binNum()));
             puts("].fetch_add(1, std::memory_order_relaxed);\n");
@@ -850,7 +877,10 @@ public:
         puts(");\n");
     }
     virtual void visit(AstRand* nodep) override {
-        emitOpName(nodep, nodep->emitC(), nodep->seedp(), nullptr, nullptr);
+        emitOpName(nodep, nodep->emitC(), nodep->seedp(), nodep->streamp(), nullptr);
+    }
+    virtual void visit(AstURandomRange* nodep) override {
+        emitOpName(nodep, nodep->emitC(), nodep->lhsp(), nodep->rhsp(), nodep->streamp());
     }
     virtual void visit(AstTime* nodep) override {
         puts("VL_TIME_UNITED_Q(");
@@ -1009,7 +1039,13 @@ public:
         puts(")");
     }
     virtual void visit(AstCNew* nodep) override {
-        puts("std::make_shared<" + prefixNameProtect(nodep->dtypep()) + ">(");
+        if (nodep->streamp()) {
+            puts("VL_NEW_RAND_STREAM<" + prefixNameProtect(nodep->dtypep()) + ">(");
+            iterateAndNextNull(nodep->streamp());
+            puts(", ");
+        } else {
+            puts("std::make_shared<" + prefixNameProtect(nodep->dtypep()) + ">(");
+        }
         puts("vlSymsp");  // TODO make this part of argsp, and eliminate when unnecessary
         if (nodep->argsp()) puts(", ");
         iterateAndNextNull(nodep->argsp());
@@ -1332,6 +1368,7 @@ unsigned EmitVarTspSorter::s_serialNext = 0;
 class EmitCImp final : EmitCStmts {
     // MEMBERS
     AstNodeModule* m_modp = nullptr;
+    const AstExecGraph* m_execGraphp = nullptr;  // Graph of the mtask bodies being emitted
     std::vector<AstChangeDet*> m_blkChangeDetVec;  // All encountered changes in block
     bool m_slow = false;  // Creating __Slow file
     bool m_fast = false;  // Creating non __Slow file (or both)
@@ -1437,10 +1474,7 @@ class EmitCImp final : EmitCStmts {
 
     void emitMTaskBody(AstMTaskBody* nodep) {
         ExecMTask* curExecMTaskp = nodep->execMTaskp();
-        if (packedMTaskMayBlock(curExecMTaskp)) {
-            puts("vlTOPp->__Vm_mt_" + cvtToStr(curExecMTaskp->id())
-                 + ".waitUntilUpstreamDone(even_cycle);\n");
-        }
+        const bool mayBlock = packedMTaskMayBlock(curExecMTaskp);
 
         string recName;
         if (v3Global.opt.profThreads()) {
@@ -1449,7 +1483,26 @@ class EmitCImp final : EmitCStmts {
             // Leave this if() here, as don't want to call VL_RDTSC_Q unless profiling
             puts("if (VL_UNLIKELY(vlTOPp->__Vm_profile_cycle_start)) {\n");
             puts(recName + " = vlTOPp->__Vm_threadPoolp->profileAppend();\n");
-            puts(recName + "->startRecord(VL_RDTSC_Q() - vlTOPp->__Vm_profile_cycle_start,");
+            if (mayBlock) {
+                // Time spent waiting on other threads' mtasks
+                puts(recName + "->waitRecord(VL_RDTSC_Q() - vlTOPp->__Vm_profile_cycle_start);\n");
+            }
+            puts("}\n");
+        }
+        if (mayBlock) {
+            const string vertexName = "vlTOPp->__Vm_mt_" + cvtToStr(curExecMTaskp->id());
+            if (v3Global.opt.profThreads()) {
+                puts("if (VL_UNLIKELY(" + recName + ")) {\n");
+                puts(recName + "->yieldRecord(" + vertexName
+                     + ".waitUntilUpstreamDoneYieldTicks(even_cycle));\n");
+                puts("} else {\n");
+            }
+            puts(vertexName + ".waitUntilUpstreamDone(even_cycle);\n");
+            if (v3Global.opt.profThreads()) puts("}\n");
+        }
+        if (v3Global.opt.profThreads()) {
+            puts("if (VL_UNLIKELY(" + recName + ")) {\n");
+            puts(recName + "->startRecord(vlTOPp->__Vm_profile_cycle_start,");
             puts(" " + cvtToStr(curExecMTaskp->id()) + ",");
             puts(" " + cvtToStr(curExecMTaskp->cost()) + ");\n");
             puts("}\n");
@@ -1462,7 +1515,7 @@ class EmitCImp final : EmitCStmts {
         if (v3Global.opt.profThreads()) {
             // Leave this if() here, as don't want to call VL_RDTSC_Q unless profiling
             puts("if (VL_UNLIKELY(" + recName + ")) {\n");
-            puts(recName + "->endRecord(VL_RDTSC_Q() - vlTOPp->__Vm_profile_cycle_start);\n");
+            puts(recName + "->endRecord(vlTOPp->__Vm_profile_cycle_start);\n");
             puts("}\n");
         }
 
@@ -1485,7 +1538,8 @@ class EmitCImp final : EmitCStmts {
             emitMTaskBody(nextp->bodyp());
         } else {
             // Unblock the fake "final" mtask
-            puts("vlTOPp->__Vm_mt_final.signalUpstreamDone(even_cycle);\n");
+            puts("vlTOPp->__Vm_mt_final" + m_execGraphp->stateSuffix()
+                 + ".signalUpstreamDone(even_cycle);\n");
         }
     }
 
@@ -1544,6 +1598,8 @@ class EmitCImp final : EmitCStmts {
         for (int i = 0; i < m_modp->level(); ++i) { puts("  "); }
         puts(prefixNameProtect(m_modp) + "::" + nodep->nameProtect() + "\\n\"); );\n");
 
+        if (v3Global.opt.profCost()) emitProfCostSite(nodep);
+
         // Declare and set vlTOPp
         if (nodep->symProlog()) puts(EmitCBaseVisitor::symTopAssign() + "\n");
 
@@ -1574,6 +1630,18 @@ class EmitCImp final : EmitCStmts {
         if (nodep->ifdef() != "") puts("#endif  // " + nodep->ifdef() + "\n");
     }
 
+    void emitProfCostSite(AstCFunc* nodep) {
+        // Functions of one module are only shared between instances with
+        // --relative-cfuncs, which --prof-cost disables, so the scope is the instance
+        puts("static VlProfCostSite __Vcost_site = {");
+        putsQuoted(nodep->nameProtect());
+        puts(", ");
+        putsQuoted(protect(m_modp->prettyName()));
+        puts(", ");
+        putsQuoted(nodep->scopep() ? protect(nodep->scopep()->prettyName()) : "");
+        puts("};\nVlProfCostScope __Vcost_scope(&__Vcost_site);\n");
+    }
+
     void emitChangeDet() {
         putsDecoration("// Change detection\n");
         puts("QData __req = false;  // Logically a bool\n");  // But not because it results in
@@ -1669,16 +1737,18 @@ class EmitCImp final : EmitCStmts {
     }
 
     virtual void visit(AstExecGraph* nodep) override {
-        UASSERT_OBJ(nodep == v3Global.rootp()->execGraphp(), nodep,
-                    "ExecGraph should be a singleton!");
+        UASSERT_OBJ(nodep == v3Global.rootp()->execGraphp()
+                        || nodep == v3Global.rootp()->settleGraphp(),
+                    nodep, "ExecGraph should be a singleton!");
         // The location of the AstExecGraph within the containing _eval()
-        // function is where we want to invoke the graph and wait for it to
-        // complete. Do that now.
+        // (or _eval_settle()) function is where we want to invoke the graph
+        // and wait for it to complete. Do that now.
         //
         // Don't recurse to children -- this isn't the place to emit
         // function definitions for the nested CFuncs. We'll do that at the
         // end.
-        puts("vlTOPp->__Vm_even_cycle = !vlTOPp->__Vm_even_cycle;\n");
+        const string evenCycle = "vlTOPp->__Vm_even_cycle" + nodep->stateSuffix();
+        puts(evenCycle + " = !" + evenCycle + ";\n");
 
         // Build the list of initial mtasks to start
         std::vector<const ExecMTask*> execMTasks;
@@ -1698,17 +1768,17 @@ class EmitCImp final : EmitCStmts {
                 if (runInline) {
                     // The thread calling eval() will run this mtask inline,
                     // along with its packed successors.
-                    puts(protect(execMTasks[i]->cFuncName())
-                         + "(vlTOPp->__Vm_even_cycle, vlSymsp);\n");
+                    puts(protect(execMTasks[i]->cFuncName()) + "(" + evenCycle + ", vlSymsp);\n");
                     puts("Verilated::mtaskId(0);\n");
                 } else {
                     // The other N-1 go to the thread pool.
                     puts("vlTOPp->__Vm_threadPoolp->workerp(" + cvtToStr(i) + ")->addTask("
-                         + protect(execMTasks[i]->cFuncName())
-                         + ", vlTOPp->__Vm_even_cycle, vlSymsp);\n");
+                         + protect(execMTasks[i]->cFuncName()) + ", " + evenCycle
+                         + ", vlSymsp);\n");
                 }
             }
-            puts("vlTOPp->__Vm_mt_final.waitUntilUpstreamDone(vlTOPp->__Vm_even_cycle);\n");
+            puts("vlTOPp->__Vm_mt_final" + nodep->stateSuffix() + ".waitUntilUpstreamDone("
+                 + evenCycle + ");\n");
         }
     }
 
@@ -1766,6 +1836,13 @@ class EmitCImp final : EmitCStmts {
             puts(emitVarResetRecurse(varp, dtypep, 0, ""));
         }
     }
+    static bool isZeroReset(const AstVar* varp, const AstBasicDType* basicp) {
+        return (varp->attrFileDescr()  // Zero so we don't core dump if never $fopen
+                || (basicp && basicp->isZeroInit())
+                || (v3Global.opt.underlineZero() && !varp->name().empty()
+                    && varp->name()[0] == '_')
+                || (v3Global.opt.xInitial() == "fast" || v3Global.opt.xInitial() == "0"));
+    }
     string emitVarResetRecurse(AstVar* varp, AstNodeDType* dtypep, int depth,
                                const string& suffix) {
         dtypep = dtypep->skipRefp();
@@ -1791,6 +1868,36 @@ class EmitCImp final : EmitCStmts {
         } else if (AstUnpackArrayDType* adtypep = VN_CAST(dtypep, UnpackArrayDType)) {
             UASSERT_OBJ(adtypep->hi() >= adtypep->lo(), varp,
                         "Should have swapped msb & lsb earlier.");
+            if (depth == 0 && varp->isLazyArray()) {
+                // Pages are reset as they are allocated
+                AstNodeDType* elemDtypep = adtypep->subDTypep()->skipRefp();
+                const bool zeroit = isZeroReset(varp, elemDtypep->basicp())
+                                    || (v3Global.opt.xInitialEdge() && varp->isUsedClock());
+                splitSizeInc(1);
+                return (varp->nameProtect() + ".reset(" + (zeroit ? "false" : "true") + ", "
+                        + cvtToStr(elemDtypep->widthMin()) + ", name(), \""
+                        + varp->nameProtect() + "\");\n");
+            }
+            if (depth == 0 && !VN_IS(m_modp, Class)) {
+                // Whole arrays of basic elements are contiguous, so reset in bulk with
+                // values keyed by instance and variable, independent of reset order
+                vluint64_t elements = 1;
+                AstNodeDType* elemDtypep = adtypep;
+                while (AstUnpackArrayDType* subp
+                       = VN_CAST(elemDtypep->skipRefp(), UnpackArrayDType)) {
+                    elements *= subp->elementsConst();
+                    elemDtypep = subp->subDTypep()->skipRefp();
+                }
+                AstBasicDType* elemBasicp = elemDtypep->basicp();
+                if (elemBasicp && elemBasicp->keyword() != AstBasicDTypeKwd::STRING
+                    && !VN_IS(elemDtypep, ClassRefDType) && !isZeroReset(varp, elemBasicp)
+                    && !(v3Global.opt.xInitialEdge() && varp->isUsedClock())) {
+                    splitSizeInc(1);
+                    return ("VL_RAND_RESET_ARRAY(" + cvtToStr(elemDtypep->widthMin()) + ", "
+                            + cvtToStr(elements) + "ULL, &(" + varp->nameProtect()
+                            + "), name(), \"" + varp->nameProtect() + "\");\n");
+                }
+            }
             string ivar = string("__Vi") + cvtToStr(depth);
             string pre = ("for (int " + ivar + "=" + cvtToStr(0) + "; " + ivar + "<"
                           + cvtToStr(adtypep->elementsConst()) + "; ++" + ivar + ") {\n");
@@ -1802,12 +1909,7 @@ class EmitCImp final : EmitCStmts {
             // String's constructor deals with it
             return "";
         } else if (basicp) {
-            bool zeroit
-                = (varp->attrFileDescr()  // Zero so we don't core dump if never $fopen
-                   || (basicp && basicp->isZeroInit())
-                   || (v3Global.opt.underlineZero() && !varp->name().empty()
-                       && varp->name()[0] == '_')
-                   || (v3Global.opt.xInitial() == "fast" || v3Global.opt.xInitial() == "0"));
+            bool zeroit = isZeroReset(varp, basicp);
             splitSizeInc(1);
             if (dtypep->isWide()) {  // Handle unpacked; not basicp->isWide
                 string out;
@@ -1846,9 +1948,12 @@ class EmitCImp final : EmitCStmts {
     // Medium level
     void emitCtorImp(AstNodeModule* modp);
     void emitConfigureImp(AstNodeModule* modp);
+    void emitProfSampleFuncs(AstNodeModule* modp);
+    static string coverInsertArgType();
     void emitCoverageDecl(AstNodeModule* modp);
     void emitCoverageImp(AstNodeModule* modp);
     void emitDestructorImp(AstNodeModule* modp);
+    static bool isSavableBulk(const AstVar* varp);
     void emitSavableImp(AstNodeModule* modp);
     void emitTextSection(AstType type);
     // High level
@@ -1998,6 +2103,7 @@ void EmitCStmts::emitOpName(AstNode* nodep, const string& format, AstNode* lhsp,
     //   %nq      emitIQW on the [node]
     //   %nw      width in bits
     //   %nW      width in words
+    //   %nT      width in words as a template argument, if wide
     //   %ni      iterate
     //  %l*     lhsp - if appropriate, then second char as above
     //  %r*     rhsp - if appropriate, then second char as above
@@ -2080,6 +2186,9 @@ void EmitCStmts::emitOpName(AstNode* nodep, const string& format, AstNode* lhsp,
                         needComma = true;
                     }
                     break;
+                case 'T':
+                    if (detailp->isWide()) puts("<" + cvtToStr(detailp->widthWords()) + ">");
+                    break;
                 case 'i':
                     COMMA;
                     UASSERT_OBJ(detailp, nodep, "emitOperator() references undef node");
@@ -2160,26 +2269,32 @@ void EmitCStmts::displayEmit(AstNode* nodep, bool isScan) {
         } else if (const AstDisplay* dispp = VN_CAST(nodep, Display)) {
             isStmt = true;
             if (dispp->filep()) {
-                puts("VL_FWRITEF(");
+                puts("VL_FWRITEF_P(");
                 iterate(dispp->filep());
                 puts(",");
             } else {
-                puts("VL_WRITEF(");
+                puts("VL_WRITEF_P(");
             }
         } else if (const AstSFormat* dispp = VN_CAST(nodep, SFormat)) {
             isStmt = true;
-            puts("VL_SFORMAT_X(");
+            puts("VL_SFORMAT_P(");
             puts(cvtToStr(dispp->lhsp()->widthMin()));
             putbs(",");
             iterate(dispp->lhsp());
             putbs(",");
         } else if (VN_IS(nodep, SFormatF)) {
             isStmt = false;
-            puts("VL_SFORMATF_NX(");
+            puts("VL_SFORMATF_P(");
         } else {
             nodep->v3fatalSrc("Unknown displayEmit node type");
         }
-        ofp()->putsQuoted(emitDispState.m_format);
+        if (isScan) {
+            ofp()->putsQuoted(emitDispState.m_format);
+        } else {
+            string prog;
+            VerilatedFmtProg::compile(prog, emitDispState.m_format.c_str());
+            ofp()->putsQuoted(prog);
+        }
         // Arguments
         for (unsigned i = 0; i < emitDispState.m_argsp.size(); i++) {
             char fmt = emitDispState.m_argsChar[i];
@@ -2374,12 +2489,18 @@ void EmitCStmts::displayNode(AstNode* nodep, AstScopeName* scopenamep, const str
 //######################################################################
 // Internal EmitC
 
+string EmitCImp::coverInsertArgType() {
+    // Type pointed to by __vlCoverInsert's countp
+    if (v3Global.opt.threads() && !coverShards()) return "std::atomic<" + coverCountType() + ">";
+    return coverCountType();
+}
+
 void EmitCImp::emitCoverageDecl(AstNodeModule*) {
     if (v3Global.opt.coverage()) {
         ofp()->putsPrivate(true);
         putsDecoration("// Coverage\n");
         puts("void __vlCoverInsert(");
-        puts(v3Global.opt.threads() ? "std::atomic<uint32_t>" : "uint32_t");
+        puts(coverInsertArgType());
         puts("* countp, bool enable, const char* filenamep, int lineno, int column,\n");
         puts("const char* hierp, const char* pagep, const char* commentp, const char* "
              "linescovp);\n");
@@ -2387,25 +2508,28 @@ void EmitCImp::emitCoverageDecl(AstNodeModule*) {
 }
 
 void EmitCImp::emitMTaskVertexCtors(bool* firstp) {
-    AstExecGraph* execGraphp = v3Global.rootp()->execGraphp();
-    UASSERT_OBJ(execGraphp, v3Global.rootp(), "Root should have an execGraphp");
-    const V3Graph* depGraphp = execGraphp->depGraphp();
+    UASSERT_OBJ(v3Global.rootp()->execGraphp(), v3Global.rootp(),
+                "Root should have an execGraphp");
+    for (const AstExecGraph* execGraphp : v3Global.rootp()->execGraphps()) {
+        const V3Graph* depGraphp = execGraphp->depGraphp();
 
-    unsigned finalEdgesInCt = 0;
-    for (const V3GraphVertex* vxp = depGraphp->verticesBeginp(); vxp; vxp = vxp->verticesNextp()) {
-        const ExecMTask* mtp = dynamic_cast<const ExecMTask*>(vxp);
-        unsigned edgesInCt = packedMTaskMayBlock(mtp);
-        if (packedMTaskMayBlock(mtp) > 0) {
-            emitCtorSep(firstp);
-            puts("__Vm_mt_" + cvtToStr(mtp->id()) + "(" + cvtToStr(edgesInCt) + ")");
+        unsigned finalEdgesInCt = 0;
+        for (const V3GraphVertex* vxp = depGraphp->verticesBeginp(); vxp;
+             vxp = vxp->verticesNextp()) {
+            const ExecMTask* mtp = dynamic_cast<const ExecMTask*>(vxp);
+            unsigned edgesInCt = packedMTaskMayBlock(mtp);
+            if (packedMTaskMayBlock(mtp) > 0) {
+                emitCtorSep(firstp);
+                puts("__Vm_mt_" + cvtToStr(mtp->id()) + "(" + cvtToStr(edgesInCt) + ")");
+            }
+            // Each mtask with no packed successor will become a dependency
+            // for the final node:
+            if (!mtp->packNextp()) ++finalEdgesInCt;
         }
-        // Each mtask with no packed successor will become a dependency
-        // for the final node:
-        if (!mtp->packNextp()) ++finalEdgesInCt;
-    }
 
-    emitCtorSep(firstp);
-    puts("__Vm_mt_final(" + cvtToStr(finalEdgesInCt) + ")");
+        emitCtorSep(firstp);
+        puts("__Vm_mt_final" + execGraphp->stateSuffix() + "(" + cvtToStr(finalEdgesInCt) + ")");
+    }
 
     // This will flip to 'true' before the start of the 0th cycle.
     emitCtorSep(firstp);
@@ -2414,8 +2538,10 @@ void EmitCImp::emitMTaskVertexCtors(bool* firstp) {
         emitCtorSep(firstp);
         puts("__Vm_profile_cycle_start(0)");
     }
-    emitCtorSep(firstp);
-    puts("__Vm_even_cycle(false)");
+    for (const AstExecGraph* execGraphp : v3Global.rootp()->execGraphps()) {
+        emitCtorSep(firstp);
+        puts("__Vm_even_cycle" + execGraphp->stateSuffix() + "(false)");
+    }
 }
 
 void EmitCImp::emitCtorImp(AstNodeModule* modp) {
@@ -2447,6 +2573,8 @@ void EmitCImp::emitCtorImp(AstNodeModule* modp) {
     putsDecoration("// Reset structure values\n");
     puts(protect("_ctor_var_reset") + "();\n");
     emitTextSection(AstType::atScCtor);
+    if (modp->isTop() && v3Global.opt.profSample()) puts("VlProfSample::start();\n");
+    if (modp->isTop() && v3Global.opt.profCost()) puts("VlProfCost::start();\n");
 
     if (modp->isTop() && v3Global.opt.mtasks()) {
         // TODO-- For now each top module creates its own ThreadPool here,
@@ -2497,32 +2625,73 @@ void EmitCImp::emitConfigureImp(AstNodeModule* modp) {
         puts("Verilated::timeprecision(" + cvtToStr(v3Global.rootp()->timeprecision().powerOfTen())
              + ");\n");
     }
+    if (v3Global.opt.profSample()) emitProfSampleFuncs(modp);
     puts("}\n");
     splitSizeInc(10);
 }
 
+void EmitCImp::emitProfSampleFuncs(AstNodeModule* modp) {
+    // Table of this module's functions, for the sampler to look up program counters in
+    bool any = false;
+    for (AstNode* nodep = modp->stmtsp(); nodep; nodep = nodep->nextp()) {
+        const AstCFunc* funcp = VN_CAST(nodep, CFunc);
+        if (!funcp || !isProfSampleFunc(funcp)) continue;
+        if (!any) {
+            puts("if (first) {\n");
+            puts("static VlProfSampleFunc __Vprof_funcs[] = {\n");
+            any = true;
+        }
+        if (!funcp->ifdef().empty()) puts("#ifdef " + funcp->ifdef() + "\n");
+        puts("{VlProfSample::funcAddr(&" + prefixNameProtect(modp) + "::"
+             + funcp->nameProtect() + "), ");
+        putsQuoted(funcp->nameProtect());
+        puts(", ");
+        putsQuoted(protect(modp->prettyName()));
+        puts(", ");
+        putsQuoted(protect(funcp->fileline()->filename()));
+        puts(", " + cvtToStr(funcp->fileline()->lineno()) + "},\n");
+        if (!funcp->ifdef().empty()) puts("#endif  // " + funcp->ifdef() + "\n");
+        splitSizeInc(1);
+    }
+    if (any) {
+        puts("};\n");
+        puts("VlProfSample::addFuncs(__Vprof_funcs, "
+             "sizeof(__Vprof_funcs) / sizeof(__Vprof_funcs[0]));\n");
+        puts("}\n");
+    }
+}
+
 void EmitCImp::emitCoverageImp(AstNodeModule*) {
     if (v3Global.opt.coverage()) {
         puts("\n// Coverage\n");
         // Rather than putting out VL_COVER_INSERT calls directly, we do it via this function
         // This gets around gcc slowness constructing all of the template arguments.
+        const string countType = coverCountType();
         puts("void " + prefixNameProtect(m_modp) + "::__vlCoverInsert(");
-        puts(v3Global.opt.threads() ? "std::atomic<uint32_t>" : "uint32_t");
+        puts(coverInsertArgType());
         puts("* countp, bool enable, const char* filenamep, int lineno, int column,\n");
         puts("const char* hierp, const char* pagep, const char* commentp, const char* linescovp) "
              "{\n");
-        if (v3Global.opt.threads()) {
-            puts("assert(sizeof(uint32_t) == sizeof(std::atomic<uint32_t>));\n");
-            puts("uint32_t* count32p = reinterpret_cast<uint32_t*>(countp);\n");
+        if (v3Global.opt.threads() && !coverShards()) {
+            puts("assert(sizeof(" + countType + ") == sizeof(std::atomic<" + countType
+                 + ">));\n");
+            puts(countType + "* counterp = reinterpret_cast<" + countType + "*>(countp);\n");
         } else {
-            puts("uint32_t* count32p = countp;\n");
+            puts(countType + "* counterp = countp;\n");
         }
         // static doesn't need save-restore as is constant
-        puts("static uint32_t fake_zero_count = 0;\n");
+        puts("static " + countType + " fake_zero_count = 0;\n");
         // Used for second++ instantiation of identical bin
-        puts("if (!enable) count32p = &fake_zero_count;\n");
-        puts("*count32p = 0;\n");
-        puts("VL_COVER_INSERT(count32p,");
+        puts("if (!enable) counterp = &fake_zero_count;\n");
+        puts("*counterp = 0;\n");
+        if (coverShards()) {
+            // The fake count has no shards
+            puts("VL_COVER_INSERT_SHARDS(counterp, ");
+            puts("enable ? __VlSymsp->__Vcoverage.stride() : 0, ");
+            puts("enable ? __VlSymsp->__Vcoverage.shards() : 1,");
+        } else {
+            puts("VL_COVER_INSERT(counterp,");
+        }
         puts("  \"filename\",filenamep,");
         puts("  \"lineno\",lineno,");
         puts("  \"column\",column,\n");
@@ -2557,6 +2726,19 @@ void EmitCImp::emitDestructorImp(AstNodeModule* modp) {
     splitSizeInc(10);
 }
 
+bool EmitCImp::isSavableBulk(const AstVar* varp) {
+    // True if an unpacked array is stored as a plain C array of numbers, so
+    // may be saved and restored as a single block
+    const AstUnpackArrayDType* arrayp = VN_CAST(varp->dtypeSkipRefp(), UnpackArrayDType);
+    if (!arrayp || arrayp->isCompound()) return false;
+    const AstNodeDType* elementp = arrayp;
+    while (const AstUnpackArrayDType* subp = VN_CAST_CONST(elementp, UnpackArrayDType)) {
+        elementp = subp->subDTypep()->skipRefp();
+    }
+    const AstBasicDType* basicp = elementp->basicp();
+    return basicp && !basicp->isOpaque();
+}
+
 void EmitCImp::emitSavableImp(AstNodeModule* modp) {
     if (v3Global.opt.savable()) {
         puts("\n// Savable\n");
@@ -2587,13 +2769,37 @@ void EmitCImp::emitSavableImp(AstNodeModule* modp) {
 
             // Save all members
             if (v3Global.opt.inhibitSim()) puts("os" + op + "__Vm_inhibitSim;\n");
+            bool newRegion = false;  // Previous variable may change size
             for (AstNode* nodep = modp->stmtsp(); nodep; nodep = nodep->nextp()) {
                 if (const AstVar* varp = VN_CAST(nodep, Var)) {
+                    // Give memories and variables that may change size their own
+                    // regions, so a delta checkpoint only pages what changed
+                    if (!de && !varp->isParam() && !(varp->isStatic() && varp->isConst())) {
+                        const bool sizeVaries = varp->dtypeSkipRefp()->isCompound();
+                        if (newRegion || sizeVaries || varp->isLazyArray()
+                            || isSavableBulk(varp)) {
+                            puts("os.region();\n");
+                        }
+                        newRegion = sizeVaries || varp->isLazyArray() || isSavableBulk(varp);
+                    }
                     if (varp->isIO() && modp->isTop() && optSystemC()) {
                         // System C top I/O doesn't need loading, as the
                         // lower level subinst code does it.
                     } else if (varp->isParam()) {
                     } else if (varp->isStatic() && varp->isConst()) {
+                    } else if (varp->isLazyArray()) {
+                        // Resident pages only, see verilated_save.h
+                        puts("os" + op + varp->nameProtect() + ";\n");
+                    } else if (isSavableBulk(varp)) {
+                        // Contiguous array of numbers; same bytes as saving
+                        // element by element, but one copy (in place when mapped)
+                        if (de) {
+                            puts("os.read(&" + varp->nameProtect() + ", sizeof("
+                                 + varp->nameProtect() + "));\n");
+                        } else {
+                            puts("os.write(&" + varp->nameProtect() + ", sizeof("
+                                 + varp->nameProtect() + "));\n");
+                        }
                     } else {
                         int vects = 0;
                         AstNodeDType* elementp = varp->dtypeSkipRefp();
@@ -3023,23 +3229,26 @@ void EmitCStmts::emitSortedVarList(const VarVec& anons, const VarVec& nonanons,
 
 void EmitCImp::emitMTaskState() {
     ofp()->putsPrivate(true);
-    AstExecGraph* execGraphp = v3Global.rootp()->execGraphp();
-    UASSERT_OBJ(execGraphp, v3Global.rootp(), "Root should have an execGraphp");
+    UASSERT_OBJ(v3Global.rootp()->execGraphp(), v3Global.rootp(),
+                "Root should have an execGraphp");
 
-    const V3Graph* depGraphp = execGraphp->depGraphp();
-    for (const V3GraphVertex* vxp = depGraphp->verticesBeginp(); vxp; vxp = vxp->verticesNextp()) {
-        const ExecMTask* mtp = dynamic_cast<const ExecMTask*>(vxp);
-        if (packedMTaskMayBlock(mtp) > 0) {
-            puts("VlMTaskVertex __Vm_mt_" + cvtToStr(mtp->id()) + ";\n");
+    for (const AstExecGraph* execGraphp : v3Global.rootp()->execGraphps()) {
+        const V3Graph* depGraphp = execGraphp->depGraphp();
+        for (const V3GraphVertex* vxp = depGraphp->verticesBeginp(); vxp;
+             vxp = vxp->verticesNextp()) {
+            const ExecMTask* mtp = dynamic_cast<const ExecMTask*>(vxp);
+            if (packedMTaskMayBlock(mtp) > 0) {
+                puts("VlMTaskVertex __Vm_mt_" + cvtToStr(mtp->id()) + ";\n");
+            }
         }
+        // This fake mtask depends on all the real ones.  We use it to block
+        // eval() until all mtasks are done.
+        //
+        // In the future we might allow _eval() to return before the graph is
+        // fully done executing, for "half wave" scheduling. For now we wait
+        // for all mtasks though.
+        puts("VlMTaskVertex __Vm_mt_final" + execGraphp->stateSuffix() + ";\n");
     }
-    // This fake mtask depends on all the real ones.  We use it to block
-    // eval() until all mtasks are done.
-    //
-    // In the future we might allow _eval() to return before the graph is
-    // fully done executing, for "half wave" scheduling. For now we wait
-    // for all mtasks though.
-    puts("VlMTaskVertex __Vm_mt_final;\n");
     puts("VlThreadPool* __Vm_threadPoolp;\n");
 
     if (v3Global.opt.profThreads()) {
@@ -3051,7 +3260,9 @@ void EmitCImp::emitMTaskState() {
         puts("vluint32_t __Vm_profile_window_ct;\n");
     }
 
-    puts("bool __Vm_even_cycle;\n");
+    for (const AstExecGraph* execGraphp : v3Global.rootp()->execGraphps()) {
+        puts("bool __Vm_even_cycle" + execGraphp->stateSuffix() + ";\n");
+    }
 }
 
 void EmitCImp::emitIntTop(AstNodeModule*) {
@@ -3067,6 +3278,9 @@ void EmitCImp::emitIntTop(AstNodeModule*) {
     }
     if (v3Global.opt.mtasks()) puts("#include \"verilated_threads.h\"\n");
     if (v3Global.opt.savable()) puts("#include \"verilated_save.h\"\n");
+    if (v3Global.opt.profSample() || v3Global.opt.profCost()) {
+        puts("#include \"verilated_prof.h\"\n");
+    }
     if (v3Global.opt.coverage()) {
         puts("#include \"verilated_cov.h\"\n");
         if (v3Global.opt.savable()) v3error("--coverage and --savable not supported together");
@@ -3400,22 +3614,26 @@ void EmitCImp::mainImp(AstNodeModule* modp, bool slow) {
         m_modp = modp;
     }
 
-    if (m_fast && modp->isTop() && v3Global.opt.mtasks()) {
+    if (modp->isTop() && v3Global.opt.mtasks()) {
         // Make a final pass and emit function definitions for the mtasks
-        // in the ExecGraph
-        AstExecGraph* execGraphp = v3Global.rootp()->execGraphp();
-        const V3Graph* depGraphp = execGraphp->depGraphp();
-        for (const V3GraphVertex* vxp = depGraphp->verticesBeginp(); vxp;
-             vxp = vxp->verticesNextp()) {
-            const ExecMTask* mtaskp = dynamic_cast<const ExecMTask*>(vxp);
-            if (mtaskp->threadRoot()) {
-                maybeSplit(modp);
-                // Only define one function for all the mtasks packed on
-                // a given thread. We'll name this function after the
-                // root mtask though it contains multiple mtasks' worth
-                // of logic.
-                iterate(mtaskp->bodyp());
+        // in the ExecGraphs; the settle graph's go with the other slow code.
+        for (const AstExecGraph* execGraphp : v3Global.rootp()->execGraphps()) {
+            if (!(execGraphp->settle() ? m_slow : m_fast)) continue;
+            m_execGraphp = execGraphp;
+            const V3Graph* depGraphp = execGraphp->depGraphp();
+            for (const V3GraphVertex* vxp = depGraphp->verticesBeginp(); vxp;
+                 vxp = vxp->verticesNextp()) {
+                const ExecMTask* mtaskp = dynamic_cast<const ExecMTask*>(vxp);
+                if (mtaskp->threadRoot()) {
+                    maybeSplit(modp);
+                    // Only define one function for all the mtasks packed on
+                    // a given thread. We'll name this function after the
+                    // root mtask though it contains multiple mtasks' worth
+                    // of logic.
+                    iterate(mtaskp->bodyp());
+                }
             }
+            m_execGraphp = nullptr;
         }
     }
     VL_DO_CLEAR(delete m_ofp, m_ofp = nullptr);
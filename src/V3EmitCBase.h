@@ -57,6 +57,12 @@ public:
     static string symTopAssign() {
         return v3Global.opt.prefix() + "* const __restrict vlTOPp VL_ATTR_UNUSED = vlSymsp->TOPp;";
     }
+    static bool coverShards() {  // Coverage counts are VlCoverShards
+        return v3Global.opt.coverageShards() && v3Global.opt.threads();
+    }
+    static string coverCountType() {  // C++ type of one coverage count
+        return v3Global.opt.coverageCounterWidth() == 64 ? "uint64_t" : "uint32_t";
+    }
     static string funcNameProtect(const AstCFunc* nodep, const AstNodeModule* modp) {
         if (nodep->isConstructor()) {
             return prefixNameProtect(modp);
@@ -163,6 +163,9 @@ class CMakeEmitter final {
         if (v3Global.opt.coverage()) {
             global.emplace_back("${VERILATOR_ROOT}/include/verilated_cov.cpp");
         }
+        if (v3Global.opt.profSample() || v3Global.opt.profCost()) {
+            global.emplace_back("${VERILATOR_ROOT}/include/verilated_prof.cpp");
+        }
         if (v3Global.opt.trace()) {
             global.emplace_back("${VERILATOR_ROOT}/include/" + v3Global.opt.traceSourceBase()
                                 + "_c.cpp");
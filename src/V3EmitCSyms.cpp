@@ -448,10 +448,16 @@ void EmitCSyms::emitSymHdr() {
 
     if (m_coverBins) {
         puts("\n// COVERAGE\n");
-        puts(v3Global.opt.threads() ? "std::atomic<uint32_t>" : "uint32_t");
-        puts(" __Vcoverage[");
-        puts(cvtToStr(m_coverBins));
-        puts("];\n");
+        if (coverShards()) {
+            puts("VlCoverShards<" + coverCountType() + ", " + cvtToStr(m_coverBins) + ", "
+                 + cvtToStr(v3Global.opt.threads()) + "> __Vcoverage;\n");
+        } else {
+            puts(v3Global.opt.threads() ? "std::atomic<" + coverCountType() + ">"
+                                        : coverCountType());
+            puts(" __Vcoverage[");
+            puts(cvtToStr(m_coverBins));
+            puts("];\n");
+        }
     }
 
     if (!m_scopeNames.empty()) {  // Scope names
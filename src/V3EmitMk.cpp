@@ -105,6 +105,9 @@ public:
                     if (v3Global.opt.vpi()) { putMakeClassEntry(of, "verilated_vpi.cpp"); }
                     if (v3Global.opt.savable()) { putMakeClassEntry(of, "verilated_save.cpp"); }
                     if (v3Global.opt.coverage()) { putMakeClassEntry(of, "verilated_cov.cpp"); }
+                    if (v3Global.opt.profSample() || v3Global.opt.profCost()) {
+                        putMakeClassEntry(of, "verilated_prof.cpp");
+                    }
                     if (v3Global.opt.trace()) {
                         putMakeClassEntry(of, v3Global.opt.traceSourceBase() + "_c.cpp");
                         if (v3Global.opt.systemC()) {
@@ -315,6 +315,12 @@ private:
         }
     }
     virtual void visit(AstExecGraph* nodep) override {
+        if (nodep->settle()) {
+            // Settle mtasks run at time zero, outside of the _eval graph;
+            // treat them like serial settle code.
+            iterateChildren(nodep);
+            return;
+        }
         // Treat the ExecGraph like a call to each mtask body
         m_mtasksGraphp = nodep->depGraphp();
         for (V3GraphVertex* mtaskVxp = m_mtasksGraphp->verticesBeginp(); mtaskVxp;
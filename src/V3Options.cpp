@@ -777,6 +777,17 @@ void V3Options::notify() {
     // --trace-threads implies --threads 1 unless explicitly specified
     if (traceThreads() && !threads()) m_threads = 1;
 
+    // --prof-cost needs each function tied to one instance, so that
+    // functions of different instances are not combined
+    if (profCost()) {
+        if (m_relativeCFuncs.isSetTrue()) {
+            cmdfl->v3warn(E_UNSUPPORTED, "Unsupported: Using --relative-cfuncs with --prof-cost\n"
+                                             + V3Error::warnMore()
+                                             + "... Suggest remove --relative-cfuncs.");
+        }
+        m_relativeCFuncs = VOptionBool::OPT_FALSE;
+    }
+
     // Default split limits if not specified
     if (m_outputSplitCFuncs < 0) m_outputSplitCFuncs = m_outputSplit;
     if (m_outputSplitCTrace < 0) m_outputSplitCTrace = m_outputSplit;
@@ -991,6 +1002,8 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
                 coverage(flag);
             } else if (onoff(sw, "-coverage-line", flag /*ref*/)) {
                 m_coverageLine = flag;
+            } else if (onoff(sw, "-coverage-shards", flag /*ref*/)) {
+                m_coverageShards = flag;
             } else if (onoff(sw, "-coverage-toggle", flag /*ref*/)) {
                 m_coverageToggle = flag;
             } else if (onoff(sw, "-coverage-underscore", flag /*ref*/)) {
@@ -1071,6 +1084,10 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
                 m_profCFuncs = flag;
             } else if (onoff(sw, "-profile-cfuncs", flag /*ref*/)) {  // Undocumented, renamed
                 m_profCFuncs = flag;
+            } else if (onoff(sw, "-prof-cost", flag /*ref*/)) {
+                m_profCost = flag;
+            } else if (onoff(sw, "-prof-sample", flag /*ref*/)) {
+                m_profSample = flag;
             } else if (onoff(sw, "-prof-threads", flag /*ref*/)) {
                 m_profThreads = flag;
             } else if (onoff(sw, "-protect-ids", flag /*ref*/)) {
@@ -1084,8 +1101,10 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
                 addParameter(string(sw + strlen("-pvalue+")), false);
             } else if (onoff(sw, "-quiet-exit", flag /*ref*/)) {
                 m_quietExit = flag;
-            } else if (onoff(sw, "-relative-cfuncs", flag /*ref*/)) {
-                m_relativeCFuncs = flag;
+            } else if (onoff(sw, "-rand-streams", flag /*ref*/)) {
+                m_randStreams = flag;
+            } else if (onoffb(sw, "-relative-cfuncs", bflag /*ref*/)) {
+                m_relativeCFuncs = bflag;
             } else if (onoff(sw, "-relative-includes", flag /*ref*/)) {
                 m_relativeIncludes = flag;
             } else if (onoff(sw, "-report-unoptflat", flag /*ref*/)) {
@@ -1108,6 +1127,8 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
                 m_defaultLanguage = V3LangCode::L1800_2017;
             } else if (onoff(sw, "-threads-coarsen", flag /*ref*/)) {  // Undocumented, debug
                 m_threadsCoarsen = flag;
+            } else if (onoff(sw, "-threads-settle", flag /*ref*/)) {
+                m_threadsSettle = flag;
             } else if (onoff(sw, "-trace", flag /*ref*/)) {
                 m_trace = flag;
             } else if (onoff(sw, "-trace-coverage", flag /*ref*/)) {
@@ -1151,7 +1172,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
                     case 'e': m_oCase = flag; break;
                     //    f
                     case 'g': m_oGate = flag; break;
-                    //    h
+                    case 'h': m_oAssoc = flag; break;
                     case 'i': m_oInline = flag; break;
                     //    j
                     case 'k': m_oSubstConst = flag; break;
@@ -1195,6 +1216,12 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
             } else if (!strcmp(sw, "-converge-limit") && (i + 1) < argc) {
                 shift;
                 m_convergeLimit = atoi(argv[i]);
+            } else if (!strcmp(sw, "-coverage-counter-width") && (i + 1) < argc) {
+                shift;
+                m_coverageCounterWidth = atoi(argv[i]);
+                if (m_coverageCounterWidth != 32 && m_coverageCounterWidth != 64) {
+                    fl->v3fatal("--coverage-counter-width must be 32 or 64: " << argv[i]);
+                }
             } else if (!strncmp(sw, "-D", 2)) {
                 addDefine(string(sw + strlen("-D")), false);
             } else if (!strcmp(sw, "-debug")) {
@@ -1254,6 +1281,9 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
                                                                         << " is passed");
                     }
                 }
+            } else if (!strcmp(sw, "-lazy-array-size") && (i + 1) < argc) {
+                shift;
+                m_lazyArraySize = strtoull(argv[i], nullptr, 0);
             } else if (!strcmp(sw, "-LDFLAGS") && (i + 1) < argc) {
                 shift;
                 addLdLibs(argv[i]);
@@ -1861,6 +1891,7 @@ void V3Options::optimize(int level) {
     bool flag = level > 0;
     m_oAcycSimp = flag;
     m_oAssemble = flag;
+    m_oAssoc = flag;
     m_oCase = flag;
     m_oCombine = flag;
     m_oConst = flag;
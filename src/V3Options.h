@@ -260,6 +260,7 @@ private:
     bool m_cmake = false;           // main switch: --make cmake
     bool m_context = true;          // main switch: --Wcontext
     bool m_coverageLine = false;    // main switch: --coverage-block
+    bool m_coverageShards = false;  // main switch: --coverage-shards
     bool m_coverageToggle = false;  // main switch: --coverage-toggle
     bool m_coverageUnderscore = false;  // main switch: --coverage-underscore
     bool m_coverageUser = false;    // main switch: --coverage-func
@@ -294,12 +295,14 @@ private:
     bool m_pinsUint8 = false;       // main switch: --pins-uint8
     bool m_ppComments = false;      // main switch: --pp-comments
     bool m_profCFuncs = false;      // main switch: --prof-cfuncs
+    bool m_profCost = false;        // main switch: --prof-cost
+    bool m_profSample = false;      // main switch: --prof-sample
     bool m_profThreads = false;     // main switch: --prof-threads
     bool m_protectIds = false;      // main switch: --protect-ids
     bool m_public = false;          // main switch: --public
     bool m_publicFlatRW = false;    // main switch: --public-flat-rw
     bool m_quietExit = false;       // main switch: --quiet-exit
-    bool m_relativeCFuncs = true;   // main switch: --relative-cfuncs
+    bool m_randStreams = false;     // main switch: --rand-streams
     bool m_relativeIncludes = false; // main switch: --relative-includes
     bool m_reportUnoptflat = false; // main switch: --report-unoptflat
     bool m_savable = false;         // main switch: --savable
@@ -310,6 +313,7 @@ private:
     bool m_threadsCoarsen = true;   // main switch: --threads-coarsen
     bool m_threadsDpiPure = true;   // main switch: --threads-dpi all/pure
     bool m_threadsDpiUnpure = false;  // main switch: --threads-dpi all
+    bool m_threadsSettle = false;   // main switch: --threads-settle
     bool m_trace = false;           // main switch: --trace
     bool m_traceCoverage = false;   // main switch: --trace-coverage
     bool m_traceParams = true;      // main switch: --trace-params
@@ -323,10 +327,12 @@ private:
 
     int         m_buildJobs = 1;    // main switch: -j
     int         m_convergeLimit = 100;  // main switch: --converge-limit
+    int         m_coverageCounterWidth = 32;  // main switch: --coverage-counter-width
     int         m_dumpTree = 0;     // main switch: --dump-tree
     int         m_gateStmts = 100;    // main switch: --gate-stmts
     int         m_ifDepth = 0;      // main switch: --if-depth
     int         m_inlineMult = 2000;   // main switch: --inline-mult
+    vluint64_t  m_lazyArraySize = 0;  // main switch: --lazy-array-size
     VOptionBool m_makeDepend;  // main switch: -MMD
     int         m_maxNumWidth = 65536;  // main switch: --max-num-width
     int         m_moduleRecursion = 100;  // main switch: --module-recursion-depth
@@ -334,6 +340,7 @@ private:
     int         m_outputSplitCFuncs = -1;  // main switch: --output-split-cfuncs
     int         m_outputSplitCTrace = -1;  // main switch: --output-split-ctrace
     int         m_pinsBv = 65;       // main switch: --pins-bv
+    VOptionBool m_relativeCFuncs{VOptionBool::OPT_DEFAULT_TRUE};  // main switch: --relative-cfuncs
     VOptionBool m_skipIdentical;  // main switch: --skip-identical
     int         m_threads = 0;      // main switch: --threads (0 == --no-threads)
     int         m_threadsMaxMTasks = 0;  // main switch: --threads-max-mtasks
@@ -378,6 +385,7 @@ private:
     //                          // main switch: -Op: --public
     bool        m_oAcycSimp;    // main switch: -Oy: acyclic pre-optimizations
     bool        m_oAssemble;    // main switch: -Om: assign assemble
+    bool        m_oAssoc;       // main switch: -Oh: associative array backing selection
     bool        m_oCase;        // main switch: -Oe: case tree conversion
     bool        m_oCombine;     // main switch: -Ob: common icode packing
     bool        m_oConst;       // main switch: -Oc: constant folding
@@ -465,6 +473,8 @@ public:
     bool context() const { return m_context; }
     bool coverage() const { return m_coverageLine || m_coverageToggle || m_coverageUser; }
     bool coverageLine() const { return m_coverageLine; }
+    bool coverageShards() const { return m_coverageShards; }
+    int coverageCounterWidth() const { return m_coverageCounterWidth; }
     bool coverageToggle() const { return m_coverageToggle; }
     bool coverageUnderscore() const { return m_coverageUnderscore; }
     bool coverageUser() const { return m_coverageUser; }
@@ -487,6 +497,7 @@ public:
     bool threadsDpiPure() const { return m_threadsDpiPure; }
     bool threadsDpiUnpure() const { return m_threadsDpiUnpure; }
     bool threadsCoarsen() const { return m_threadsCoarsen; }
+    bool threadsSettle() const { return m_threadsSettle; }
     bool trace() const { return m_trace; }
     bool traceCoverage() const { return m_traceCoverage; }
     bool traceParams() const { return m_traceParams; }
@@ -502,6 +513,8 @@ public:
     bool pinsUint8() const { return m_pinsUint8; }
     bool ppComments() const { return m_ppComments; }
     bool profCFuncs() const { return m_profCFuncs; }
+    bool profCost() const { return m_profCost; }
+    bool profSample() const { return m_profSample; }
     bool profThreads() const { return m_profThreads; }
     bool protectIds() const { return m_protectIds; }
     bool allPublic() const { return m_public; }
@@ -510,7 +523,8 @@ public:
     bool ignc() const { return m_ignc; }
     bool inhibitSim() const { return m_inhibitSim; }
     bool quietExit() const { return m_quietExit; }
-    bool relativeCFuncs() const { return m_relativeCFuncs; }
+    bool randStreams() const { return m_randStreams; }
+    bool relativeCFuncs() const { return m_relativeCFuncs.isTrue(); }
     bool reportUnoptflat() const { return m_reportUnoptflat; }
     bool verilate() const { return m_verilate; }
     bool vpi() const { return m_vpi; }
@@ -524,6 +538,7 @@ public:
     int gateStmts() const { return m_gateStmts; }
     int ifDepth() const { return m_ifDepth; }
     int inlineMult() const { return m_inlineMult; }
+    vluint64_t lazyArraySize() const { return m_lazyArraySize; }
     VOptionBool makeDepend() const { return m_makeDepend; }
     int maxNumWidth() const { return m_maxNumWidth; }
     int moduleRecursionDepth() const { return m_moduleRecursion; }
@@ -603,6 +618,7 @@ public:
     // ACCESSORS (optimization options)
     bool oAcycSimp() const { return m_oAcycSimp; }
     bool oAssemble() const { return m_oAssemble; }
+    bool oAssoc() const { return m_oAssoc; }
     bool oCase() const { return m_oCase; }
     bool oCombine() const { return m_oCombine; }
     bool oConst() const { return m_oConst; }
@@ -508,11 +508,14 @@ private:
 
                 // Do not construct dependencies across exclusive domains.
                 if (domainsExclusive(domainp, toLVertexp->domainp())) continue;
+                // Nor to logic the MoveVertexMaker left out of this graph.
+                T_MoveVertex* toMoveVxp = m_logic2move[toLVertexp];
+                if (!toMoveVxp) continue;
 
                 // Path from vertexp to a logic vertex; new edge.
                 // Note we use the last edge's weight, not some function of
                 // multiple edges
-                new OrderEdge(m_outGraphp, moveVxp, m_logic2move[toLVertexp], weight);
+                new OrderEdge(m_outGraphp, moveVxp, toMoveVxp, weight);
                 madeDeps = true;
             } else {
                 // This is an OrderVarVertex or other vertex representing
@@ -581,17 +584,21 @@ private:
 class OrderMTaskMoveVertexMaker final
     : public ProcessMoveBuildGraph<MTaskMoveVertex>::MoveVertexMaker {
     V3Graph* m_pomGraphp;
+    bool m_settle;  // Building the settle graph, else the _eval graph
 
 public:
-    explicit OrderMTaskMoveVertexMaker(V3Graph* pomGraphp)
-        : m_pomGraphp{pomGraphp} {}
+    OrderMTaskMoveVertexMaker(V3Graph* pomGraphp, bool settle)
+        : m_pomGraphp{pomGraphp}
+        , m_settle{settle} {}
     virtual MTaskMoveVertex* makeVertexp(OrderLogicVertex* lvertexp,
                                          const OrderEitherVertex* varVertexp,
                                          const AstScope* scopep,
                                          const AstSenTree* domainp) override {
-        // Exclude initial/settle logic from the mtasks graph.
-        // We'll output time-zero logic separately.
-        if (domainp->hasInitial() || domainp->hasSettle()) return nullptr;
+        // Exclude initial logic from the mtasks graph, and settle logic
+        // from all but the settle graph.
+        // We'll output the remaining time-zero logic separately.
+        if (domainp->hasInitial()) return nullptr;
+        if (domainp->hasSettle() != m_settle) return nullptr;
         return new MTaskMoveVertex(m_pomGraphp, lvertexp, varVertexp, scopep, domainp);
     }
     virtual void freeVertexp(MTaskMoveVertex* freeMep) override {
@@ -759,6 +766,7 @@ private:
         MTaskState() = default;
     };
     void processMTasks();
+    AstExecGraph* processMTasksGraph(bool settle, uint32_t idOffset);
     typedef enum : uint8_t { LOGIC_INITIAL, LOGIC_SETTLE } InitialLogicE;
     void processMTasksInitial(InitialLogicE logic_type);
 
@@ -1064,6 +1072,12 @@ private:
                         // clock_enable attribute: user's worrying about it for us
                         con = false;
                     }
+                    if (varscp->varp()->isRandStream() && !m_inClocked) {
+                        // Random stream state is only advanced, never consumed as a value,
+                        // so don't make combo logic circular on itself.  Writers of the
+                        // same stream still get serialized by V3Partition.
+                        con = false;
+                    }
                     if (m_inClkAss
                         && (varscp->varp()->attrClocker() != VVarAttrClocker::CLOCKER_YES)) {
                         con = false;
@@ -1776,7 +1790,8 @@ AstActive* OrderVisitor::processMoveOneLogic(const OrderLogicVertex* lvertexp,
 
 void OrderVisitor::processMTasksInitial(InitialLogicE logic_type) {
     // Emit initial/settle logic. Initial blocks won't be part of the
-    // mtask partition, aren't eligible for parallelism.
+    // mtask partition, aren't eligible for parallelism. Settle logic is
+    // only emitted here without --threads-settle.
     //
     int initStmts = 0;
     AstCFunc* initCFunc = nullptr;
@@ -1802,8 +1817,26 @@ void OrderVisitor::processMTasks() {
     V3Partition::hashGraphDebug(&m_graph, "V3Order's m_graph");
 
     processMTasksInitial(LOGIC_INITIAL);
-    processMTasksInitial(LOGIC_SETTLE);
+    if (!v3Global.opt.threadsSettle()) processMTasksInitial(LOGIC_SETTLE);
 
+    AstExecGraph* execGraphp = processMTasksGraph(false, 0);
+    v3Global.rootp()->execGraphp(execGraphp);
+
+    if (v3Global.opt.threadsSettle()) {
+        // Settle logic gets a graph of its own, as it runs in _eval_settle.
+        // Number its mtasks after the _eval graph's, so mtask IDs (and the
+        // names derived from them) stay unique across both graphs.
+        uint32_t maxId = 0;
+        for (const V3GraphVertex* vxp = execGraphp->depGraphp()->verticesBeginp(); vxp;
+             vxp = vxp->verticesNextp()) {
+            const ExecMTask* mtp = dynamic_cast<const ExecMTask*>(vxp);
+            maxId = std::max(maxId, mtp->id());
+        }
+        v3Global.rootp()->settleGraphp(processMTasksGraph(true, maxId));
+    }
+}
+
+AstExecGraph* OrderVisitor::processMTasksGraph(bool settle, uint32_t idOffset) {
     // We already produced a graph of every var, input, logic, and settle
     // block and all dependencies; this is 'm_graph'.
     //
@@ -1811,7 +1844,7 @@ void OrderVisitor::processMTasks() {
     // only logic, and discarding edges we know we can ignore.
     // This is quite similar to the 'm_pomGraph' of the serial code gen:
     V3Graph logicGraph;
-    OrderMTaskMoveVertexMaker create_mtask_vertex(&logicGraph);
+    OrderMTaskMoveVertexMaker create_mtask_vertex(&logicGraph, settle);
     ProcessMoveBuildGraph<MTaskMoveVertex> mtask_pmbg(&m_graph, &logicGraph, &create_mtask_vertex);
     mtask_pmbg.build();
 
@@ -1842,6 +1875,10 @@ void OrderVisitor::processMTasks() {
             // Add this logic to the per-mtask order
             mtaskStates[mtaskId].m_logics.push_back(movep->logicp());
 
+            // Settle logic runs only at time zero, so should not influence
+            // the memory layout chosen for _eval.
+            if (settle) continue;
+
             // Since we happen to be iterating over every logic node,
             // take this opportunity to annotate each AstVar with the id's
             // of mtasks that consume it and produce it. We'll use this
@@ -1872,9 +1909,8 @@ void OrderVisitor::processMTasks() {
     // Create the AstExecGraph node which represents the execution
     // of the MTask graph.
     FileLine* rootFlp = v3Global.rootp()->fileline();
-    AstExecGraph* execGraphp = new AstExecGraph(rootFlp);
+    AstExecGraph* execGraphp = new AstExecGraph(rootFlp, settle);
     m_scopetopp->addActivep(execGraphp);
-    v3Global.rootp()->execGraphp(execGraphp);
 
     // Create CFuncs and bodies for each MTask.
     GraphStream<MTaskVxIdLessThan> emit_mtasks(&mtasks);
@@ -1912,7 +1948,8 @@ void OrderVisitor::processMTasks() {
         //   and OrderLogicVertex's which are ephemeral to V3Order.
         // - The ExecMTask graph and the AstMTaskBody's produced here
         //   persist until code generation time.
-        state.m_execMTaskp = new ExecMTask(execGraphp->mutableDepGraphp(), bodyp, mtaskp->id());
+        state.m_execMTaskp
+            = new ExecMTask(execGraphp->mutableDepGraphp(), bodyp, idOffset + mtaskp->id());
         // Cross-link each ExecMTask and MTaskBody
         //  Q: Why even have two objects?
         //  A: One is an AstNode, the other is a GraphVertex,
@@ -1927,6 +1964,7 @@ void OrderVisitor::processMTasks() {
         }
         execGraphp->addMTaskBody(bodyp);
     }
+    return execGraphp;
 }
 
 //######################################################################
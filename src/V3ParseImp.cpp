@@ -182,6 +182,24 @@ string V3ParseImp::lexParseTag(const char* textp) {
     return tmp;
 }
 
+string V3ParseImp::lexParseDpiGroups(const char* textp) {
+    // Names may be separated by spaces or commas; return them comma separated
+    string tmp = textp + strlen("/*verilator dpi_group");
+    string::size_type pos;
+    if ((pos = tmp.rfind("*/")) != string::npos) tmp.erase(pos);
+    string groups;
+    string name;
+    for (const char c : tmp + " ") {
+        if (isspace(c) || c == ',') {
+            if (!name.empty()) groups += (groups.empty() ? "" : ",") + name;
+            name.clear();
+        } else {
+            name += c;
+        }
+    }
+    return groups;
+}
+
 double V3ParseImp::lexParseTimenum(const char* textp) {
     size_t length = strlen(textp);
     char* strgp = new char[length + 1];
@@ -39,7 +39,7 @@ class V3Lexer;
 
 typedef enum : uint8_t { uniq_NONE, uniq_UNIQUE, uniq_UNIQUE0, uniq_PRIORITY } V3UniqState;
 
-typedef enum : uint8_t { iprop_NONE, iprop_CONTEXT, iprop_PURE } V3ImportProperty;
+typedef enum : uint8_t { iprop_NONE, iprop_CONTEXT, iprop_PURE, iprop_ASYNC } V3ImportProperty;
 
 //============================================================================
 // Member qualifiers
@@ -222,6 +222,7 @@ public:
     FileLine* lexCopyOrSameFileLine() { return lexFileline()->copyOrSameFileLine(); }
     static void lexErrorPreprocDirective(FileLine* fl, const char* textp);
     static string lexParseTag(const char* textp);
+    static string lexParseDpiGroups(const char* textp);
     static double lexParseTimenum(const char* text);
     void lexPpline(const char* textp);
     void lexVerilatorCmtLint(FileLine* fl, const char* textp, bool warnOff);
@@ -1633,23 +1633,46 @@ const GraphWay* PartContraction::s_shortestWaywardCpInclusiveWay = nullptr;
 // DpiImportCallVisitor
 
 // Scan node, indicate whether it contains a call to a DPI imported
-// routine.
+// routine.  Also find random streams (--rand-streams) drawn from within
+// called functions, as ordering does not see variables used by callees.
 class DpiImportCallVisitor final : public AstNVisitor {
+public:
+    typedef std::set<string> GroupSet;  // "" is the group of imports without dpi_group
+
 private:
-    bool m_hasDpiHazard = false;  // Found a DPI import call.
+    GroupSet m_groups;  // Hazard groups of the DPI import calls found
+    GroupSet m_randStreams;  // Names of random stream AstVarScopes used by called functions
     bool m_tracingCall = false;  // Iterating into a CCall to a CFunc
+    bool m_inCall = false;  // Under a CFunc reached through a CCall
     // METHODS
     VL_DEBUG_FUNC;
 
     virtual void visit(AstCFunc* nodep) override {
         if (!m_tracingCall) return;
         m_tracingCall = false;
-        if (nodep->dpiImportWrapper()) {
+        if (nodep->dpiImportWrapper() && !nodep->dpiAsync()) {
+            // dpi_async wrappers only post to the VerilatedDpiAsync queue, which is MT safe
             if (nodep->pure() ? !v3Global.opt.threadsDpiPure()
                               : !v3Global.opt.threadsDpiUnpure()) {
-                m_hasDpiHazard = true;
+                if (nodep->dpiGroups().empty()) {
+                    m_groups.insert("");
+                } else {
+                    std::istringstream is(nodep->dpiGroups());
+                    string group;
+                    while (std::getline(is, group, ',')) m_groups.insert(group);
+                }
             }
         }
+        VL_RESTORER(m_inCall);
+        {
+            m_inCall = true;
+            iterateChildren(nodep);
+        }
+    }
+    virtual void visit(AstNodeVarRef* nodep) override {
+        if (m_inCall && nodep->varp()->isRandStream() && nodep->varScopep()) {
+            m_randStreams.insert(nodep->varScopep()->name());
+        }
         iterateChildren(nodep);
     }
     virtual void visit(AstNodeCCall* nodep) override {
@@ -1663,7 +1686,9 @@ private:
 public:
     // CONSTRUCTORS
     explicit DpiImportCallVisitor(AstNode* nodep) { iterate(nodep); }
-    bool hasDpiHazard() const { return m_hasDpiHazard; }
+    bool hasDpiHazard() const { return !m_groups.empty(); }
+    const GroupSet& groups() const { return m_groups; }
+    const GroupSet& randStreams() const { return m_randStreams; }
     virtual ~DpiImportCallVisitor() override = default;
 
 private:
@@ -1841,24 +1866,31 @@ private:
             lastMergedp = mergedp;
         }
     }
-    bool hasDpiHazard(LogicMTask* mtaskp) {
-        for (LogicMTask::VxList::const_iterator it = mtaskp->vertexListp()->begin();
-             it != mtaskp->vertexListp()->end(); ++it) {
-            if (!(*it)->logicp()) continue;
-            AstNode* nodep = (*it)->logicp()->nodep();
-            // NOTE: We don't handle DPI exports. If testbench code calls a
-            // DPI-exported function at any time during eval() we may have
-            // a data hazard. (Likewise in non-threaded mode if an export
-            // messes with an ordered variable we're broken.)
-
-            // Find all calls to DPI-imported functions, we can put those
-            // into a serial order at least. That should solve the most
-            // likely DPI-related data hazards.
-            if (DpiImportCallVisitor(nodep).hasDpiHazard()) {  //
-                return true;
+    typedef std::map<string, std::vector<const OrderLogicVertex*>> DpiGroupLogics;
+    void findDpiHazards(DpiGroupLogics* groupLogicsp, DpiGroupLogics* streamLogicsp) {
+        for (V3GraphVertex* vxp = m_mtasksp->verticesBeginp(); vxp; vxp = vxp->verticesNextp()) {
+            LogicMTask* mtaskp = dynamic_cast<LogicMTask*>(vxp);
+            for (LogicMTask::VxList::const_iterator it = mtaskp->vertexListp()->begin();
+                 it != mtaskp->vertexListp()->end(); ++it) {
+                const OrderLogicVertex* logicp = (*it)->logicp();
+                if (!logicp) continue;
+                // NOTE: We don't handle DPI exports. If testbench code calls a
+                // DPI-exported function at any time during eval() we may have
+                // a data hazard. (Likewise in non-threaded mode if an export
+                // messes with an ordered variable we're broken.)
+
+                // Find all calls to DPI-imported functions, we can put those
+                // into a serial order at least. That should solve the most
+                // likely DPI-related data hazards.
+                const DpiImportCallVisitor visitor(logicp->nodep());
+                for (const string& group : visitor.groups()) {
+                    (*groupLogicsp)[group].push_back(logicp);
+                }
+                for (const string& stream : visitor.randStreams()) {
+                    (*streamLogicsp)[stream].push_back(logicp);
+                }
             }
         }
-        return false;
     }
 
 public:
@@ -1977,15 +2009,29 @@ public:
 
         // Handle nodes containing DPI calls, we want to serialize those
         // by default unless user gave --threads-dpi-concurrent.
-        // Same basic strategy as above to serialize access to SC vars.
-        if (!v3Global.opt.threadsDpiPure() || !v3Global.opt.threadsDpiUnpure()) {
-            TasksByRank tasksByRank;
-            for (V3GraphVertex* vxp = m_mtasksp->verticesBeginp(); vxp;
-                 vxp = vxp->verticesNextp()) {
-                LogicMTask* mtaskp = dynamic_cast<LogicMTask*>(vxp);
-                if (hasDpiHazard(mtaskp)) { tasksByRank[vxp->rank()].insert(mtaskp); }
+        // Same basic strategy as above to serialize access to SC vars,
+        // except each dpi_group is serialized on its own, as if it was a
+        // variable; imports without a dpi_group share one group.
+        //
+        // Random streams drawn by called functions are serialized the same
+        // way, one group per stream, as each draw advances the stream state.
+        {
+            // Logic vertices never change, so find their groups before
+            // merging starts moving them between mtasks
+            DpiGroupLogics groupLogics;
+            DpiGroupLogics streamLogics;
+            findDpiHazards(&groupLogics, &streamLogics);
+            for (const auto& itr : streamLogics) groupLogics[" stream " + itr.first] = itr.second;
+            for (const auto& itr : groupLogics) {
+                TasksByRank tasksByRank;
+                for (const OrderLogicVertex* logicp : itr.second) {
+                    LogicMTask* mtaskp = m_olv2mtask.at(logicp);
+                    tasksByRank[mtaskp->rank()].insert(mtaskp);
+                }
+                UINFO(4, "PartFixDataHazards() hazard group '"
+                             << itr.first << "' in " << tasksByRank.size() << " ranks\n");
+                mergeSameRankTasks(&tasksByRank);
             }
-            mergeSameRankTasks(&tasksByRank);
         }
 
         UINFO(4, "PartFixDataHazards() merged " << m_mergesDone << " pairs of nodes in "
@@ -2480,7 +2526,7 @@ void V3Partition::go(V3Graph* mtasksp) {
     }
 }
 
-void V3Partition::finalizeCosts(V3Graph* execMTaskGraphp) {
+void V3Partition::finalizeCosts(V3Graph* execMTaskGraphp, const string& stage) {
     GraphStreamUnordered ser(execMTaskGraphp, GraphWay::REVERSE);
 
     while (const V3GraphVertex* vxp = ser.nextp()) {
@@ -2539,7 +2585,7 @@ void V3Partition::finalizeCosts(V3Graph* execMTaskGraphp) {
     // (More verbose stats are available with --debugi-V3Partition >= 3.)
     PartParallelismEst parEst(execMTaskGraphp);
     parEst.traverse();
-    parEst.statsReport("final");
+    parEst.statsReport(stage);
     if (debug() >= 3) {
         UINFO(0, "  Final mtask parallelism report:\n");
         parEst.debugReport();
@@ -2548,19 +2594,20 @@ void V3Partition::finalizeCosts(V3Graph* execMTaskGraphp) {
 
 void V3Partition::finalize() {
     // Called by Verilator top stage
-    AstExecGraph* execGraphp = v3Global.rootp()->execGraphp();
-    UASSERT(execGraphp, "Couldn't find AstExecGraph singleton.");
-
-    // Back in V3Order, we partitioned mtasks using provisional cost
-    // estimates. However, V3Order precedes some optimizations (notably
-    // V3LifePost) that can change the cost of logic within each mtask.
-    // Now that logic is final, recompute the cost and priority of each
-    // ExecMTask.
-    finalizeCosts(execGraphp->mutableDepGraphp());
-
-    // "Pack" the mtasks: statically associate each mtask with a thread,
-    // and determine the order in which each thread will runs its mtasks.
-    PartPackMTasks(execGraphp->mutableDepGraphp()).go();
+    UASSERT(v3Global.rootp()->execGraphp(), "Couldn't find AstExecGraph singleton.");
+    for (AstExecGraph* execGraphp : v3Global.rootp()->execGraphps()) {
+        // Back in V3Order, we partitioned mtasks using provisional cost
+        // estimates. However, V3Order precedes some optimizations (notably
+        // V3LifePost) that can change the cost of logic within each mtask.
+        // Now that logic is final, recompute the cost and priority of each
+        // ExecMTask.
+        finalizeCosts(execGraphp->mutableDepGraphp(),
+                      execGraphp->settle() ? "final settle" : "final");
+
+        // "Pack" the mtasks: statically associate each mtask with a thread,
+        // and determine the order in which each thread will runs its mtasks.
+        PartPackMTasks(execGraphp->mutableDepGraphp()).go();
+    }
 }
 
 void V3Partition::selfTest() {
@@ -63,7 +63,7 @@ public:
     static void finalize();
 
 private:
-    static void finalizeCosts(V3Graph* execMTaskGraphp);
+    static void finalizeCosts(V3Graph* execMTaskGraphp, const string& stage);
     static void setupMTaskDeps(V3Graph* mtasksp, const Vx2MTaskMap* vx2mtaskp);
 
     VL_DEBUG_FUNC;  // Declare debug()
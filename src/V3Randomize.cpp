@@ -20,7 +20,16 @@
 // Mark all classes that inherit from previously marked classed
 // Mark all classes whose instances are randomized member variables of marked classes
 // Each marked class:
-//      define a virtual randomize() method that randomizes its random variables
+//      define a virtual randomize() method that randomizes its random variables,
+//      with --rand-streams all drawn from one wide random value
+//
+// With --rand-streams, after scoping and before ordering, each
+// $random/$urandom/$urandom_range/shuffle call site without a seed:
+//      create a __Vrandstream state variable in its module, which V3CCtors
+//      initializes with VL_RAND_STREAM_INIT, and draw from that stream
+// Each class new call site likewise:
+//      create a __Vrandstream, from which the new object's streams are keyed
+//      (ordering and partitioning then see each stream as a written variable)
 //
 //*************************************************************************
 
@@ -28,6 +37,9 @@
 #include "verilatedos.h"
 
 #include "V3Randomize.h"
+#include "V3Stats.h"
+
+#include <map>
 
 //######################################################################
 // Visitor that marks classes needing a randomize() method
@@ -122,6 +134,9 @@ private:
 
     // STATE
     size_t m_enumValueTabCount = 0;  // Number of tables with enum values created
+    AstVar* m_batchVarp = nullptr;  // Random bits for all members of current randomize()
+    int m_batchBits = 0;  // Bits of m_batchVarp used so far
+    std::vector<AstVarRef*> m_batchRefps;  // References to m_batchVarp, to set width
 
     // METHODS
     VL_DEBUG_FUNC;
@@ -151,6 +166,16 @@ private:
         nodep->user2p(varp);
         return varp;
     }
+    AstNodeMath* newBatchSelp(FileLine* fl, int width) {
+        // Without a batch, a new $urandom per member
+        if (!m_batchVarp) return new AstRand(fl, nullptr, false);
+        // Next width bits of the batch; its width is set once all members are known
+        AstVarRef* refp = new AstVarRef(fl, m_batchVarp, VAccess::READ);
+        m_batchRefps.push_back(refp);
+        AstSel* selp = new AstSel(fl, refp, m_batchBits, width);
+        m_batchBits += width;
+        return selp;
+    }
     AstNodeStmt* newRandStmtsp(FileLine* fl, AstNodeVarRef* varrefp, int offset = 0,
                                AstMemberDType* memberp = nullptr) {
         if (auto* structDtp
@@ -176,14 +201,15 @@ private:
                                         EnumDType)) {
                 AstVarRef* tabRefp = new AstVarRef(fl, enumValueTabp(enumDtp), VAccess::READ);
                 tabRefp->classOrPackagep(v3Global.rootp()->dollarUnitPkgAddp());
-                auto* randp = new AstRand(fl, nullptr, false);
+                auto* randp = newBatchSelp(fl, 32);
                 auto* moddivp = new AstModDiv(fl, randp, new AstConst(fl, enumDtp->itemCount()));
                 randp->dtypep(varrefp->findBasicDType(AstBasicDTypeKwd::UINT32));
                 moddivp->dtypep(enumDtp);
                 valp = new AstArraySel(fl, tabRefp, moddivp);
             } else {
-                valp = new AstRand(fl, nullptr, false);
-                valp->dtypep(memberp ? memberp->dtypep() : varrefp->varp()->dtypep());
+                AstNodeDType* dtypep = memberp ? memberp->dtypep() : varrefp->varp()->dtypep();
+                valp = newBatchSelp(fl, dtypep->width());
+                valp->dtypep(dtypep);
             }
             return new AstAssign(fl,
                                  new AstSel(fl, varrefp, offset + (memberp ? memberp->lsb() : 0),
@@ -199,9 +225,20 @@ private:
         UINFO(9, "Define randomize() for " << nodep << endl);
         auto* funcp = V3Randomize::newRandomizeFunc(nodep);
         auto* fvarp = VN_CAST(funcp->fvarp(), Var);
-        funcp->addStmtsp(new AstAssign(
+        AstNode* const retAssignp = new AstAssign(
             nodep->fileline(), new AstVarRef(nodep->fileline(), fvarp, VAccess::WRITE),
-            new AstConst(nodep->fileline(), AstConst::WidthedValue(), 32, 1)));
+            new AstConst(nodep->fileline(), AstConst::WidthedValue(), 32, 1));
+        funcp->addStmtsp(retAssignp);
+        // With streams, draw all members' bits with one $urandom; the dtype is
+        // sized when done.  Otherwise keep the default generator's sequence.
+        if (v3Global.opt.randStreams()) {
+            m_batchVarp = new AstVar(nodep->fileline(), AstVarType::BLOCKTEMP, "__Vrandbatch",
+                                     nodep->findBitDType());
+            m_batchVarp->funcLocal(true);
+            m_batchVarp->lifetime(VLifetime::AUTOMATIC);
+        }
+        m_batchBits = 0;
+        m_batchRefps.clear();
         for (auto* classp = nodep; classp;
              classp = classp->extendsp() ? classp->extendsp()->classp() : nullptr) {
             for (auto* memberp = classp->stmtsp(); memberp; memberp = memberp->nextp()) {
@@ -230,6 +267,23 @@ private:
                 }
             }
         }
+        if (m_batchBits) {
+            AstNodeDType* const dtypep
+                = nodep->findBitDType(m_batchBits, m_batchBits, VSigning::UNSIGNED);
+            m_batchVarp->dtypep(dtypep);
+            for (AstVarRef* refp : m_batchRefps) refp->dtypep(dtypep);
+            AstRand* const randp = new AstRand(nodep->fileline(), nullptr, true);
+            randp->dtypep(dtypep);
+            AstNode* const assignp = new AstAssign(
+                nodep->fileline(),
+                new AstVarRef(nodep->fileline(), m_batchVarp, VAccess::WRITE), randp);
+            // Before the member assignments, after the return value initialization
+            retAssignp->addNextHere(assignp);
+            retAssignp->addNextHere(m_batchVarp);
+        } else if (m_batchVarp) {
+            VL_DO_DANGLING(m_batchVarp->deleteTree(), m_batchVarp);
+        }
+        m_batchVarp = nullptr;
         nodep->user1(false);
     }
     virtual void visit(AstNode* nodep) override { iterateChildren(nodep); }
@@ -240,6 +294,99 @@ public:
     virtual ~RandomizeVisitor() override = default;
 };
 
+//######################################################################
+// Visitor that gives each random call site its own stream (--rand-streams)
+
+class RandomizeStreamVisitor final : public AstNVisitor {
+private:
+    // STATE
+    AstNodeModule* m_modp = nullptr;  // Current module
+    AstScope* m_scopep = nullptr;  // Current scope
+    AstCFunc* m_cfuncp = nullptr;  // Current function
+    int m_siteNum = 0;  // Call sites so far in current scope
+    // Stream variable for each module's call site; scopes of a module visit sites in same order
+    std::map<std::pair<AstNodeModule*, int>, AstVar*> m_streamVarps;
+    VDouble0 m_statStreams;  // Statistic tracking
+
+    // METHODS
+    VL_DEBUG_FUNC;
+
+    AstVarRef* newStreamRefp(AstNode* nodep) {
+        FileLine* const fl = nodep->fileline();
+        AstVar*& varpr = m_streamVarps[std::make_pair(m_modp, m_siteNum++)];
+        if (!varpr) {
+            varpr = new AstVar(fl, AstVarType::MODULETEMP, "__Vrandstream" + cvtToStr(m_siteNum),
+                               nodep->findBitDType(128, 128, VSigning::UNSIGNED));
+            varpr->isRandStream(true);
+            m_modp->addStmtp(varpr);
+            ++m_statStreams;
+        }
+        AstVarScope* const vscp = new AstVarScope(fl, m_scopep, varpr);
+        m_scopep->addVarp(vscp);
+        return new AstVarRef(fl, vscp, VAccess::READWRITE);
+    }
+    bool streamable() const {
+        if (!m_scopep) return false;
+        if (!VN_IS(m_modp, Class)) return true;
+        // Static class methods have no object holding the stream
+        return m_cfuncp && !m_cfuncp->isStatic().trueKnown();
+    }
+
+    // VISITORS
+    virtual void visit(AstNodeModule* nodep) override {
+        VL_RESTORER(m_modp);
+        {
+            m_modp = nodep;
+            iterateChildren(nodep);
+        }
+    }
+    virtual void visit(AstScope* nodep) override {
+        VL_RESTORER(m_scopep);
+        VL_RESTORER(m_siteNum);
+        {
+            m_scopep = nodep;
+            m_siteNum = 0;
+            iterateChildren(nodep);
+        }
+    }
+    virtual void visit(AstCFunc* nodep) override {
+        VL_RESTORER(m_cfuncp);
+        {
+            m_cfuncp = nodep;
+            iterateChildren(nodep);
+        }
+    }
+    virtual void visit(AstRand* nodep) override {
+        iterateChildren(nodep);
+        if (nodep->reset() || nodep->seedp() || nodep->streamp() || !streamable()) return;
+        nodep->streamp(newStreamRefp(nodep));
+    }
+    virtual void visit(AstURandomRange* nodep) override {
+        iterateChildren(nodep);
+        if (nodep->streamp() || !streamable()) return;
+        nodep->streamp(newStreamRefp(nodep));
+    }
+    virtual void visit(AstCMethodHard* nodep) override {
+        iterateChildren(nodep);
+        if (nodep->name() != "shuffle" || nodep->pinsp() || !streamable()) return;
+        nodep->addPinsp(newStreamRefp(nodep));
+    }
+    virtual void visit(AstCNew* nodep) override {
+        // The new object's streams are keyed by a draw from the call site's stream
+        iterateChildren(nodep);
+        if (nodep->streamp() || !streamable()) return;
+        nodep->streamp(newStreamRefp(nodep));
+    }
+    virtual void visit(AstNode* nodep) override { iterateChildren(nodep); }
+
+public:
+    // CONSTRUCTORS
+    explicit RandomizeStreamVisitor(AstNetlist* nodep) { iterate(nodep); }
+    virtual ~RandomizeStreamVisitor() override {
+        V3Stats::addStat("Random streams", m_statStreams);
+    }
+};
+
 //######################################################################
 // Randomize method class functions
 
@@ -252,6 +399,12 @@ void V3Randomize::randomizeNetlist(AstNetlist* nodep) {
     V3Global::dumpCheckGlobalTree("randomize", 0, v3Global.opt.dumpTreeLevel(__FILE__) >= 3);
 }
 
+void V3Randomize::randStreamsAll(AstNetlist* nodep) {
+    UINFO(2, __FUNCTION__ << ": " << endl);
+    { RandomizeStreamVisitor visitor(nodep); }  // Destruct before checking
+    V3Global::dumpCheckGlobalTree("randstreams", 0, v3Global.opt.dumpTreeLevel(__FILE__) >= 3);
+}
+
 AstFunc* V3Randomize::newRandomizeFunc(AstClass* nodep) {
     auto* funcp = VN_CAST(nodep->findMember("randomize"), Func);
     if (!funcp) {
@@ -25,6 +25,7 @@
 class V3Randomize final {
 public:
     static void randomizeNetlist(AstNetlist* nodep);
+    static void randStreamsAll(AstNetlist* nodep);
 
     static AstFunc* newRandomizeFunc(AstClass* nodep);
 };
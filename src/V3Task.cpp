@@ -953,8 +953,42 @@ private:
         }
     }
 
+    bool checkDpiAsync(AstNodeFTask* nodep, AstVarScope* rtnvscp, AstCFunc* cfuncp) {
+        // Return true if the import may be posted to the async worker; the call
+        // runs later on another thread, so nothing may flow back into the model
+        bool ok = true;
+        if (rtnvscp) {
+            nodep->v3error("DPI import marked /*verilator dpi_async*/ must be a void function "
+                           "or a task: "
+                           << nodep->prettyNameQ());
+            ok = false;
+        }
+        for (AstNode* stmtp = cfuncp->argsp(); stmtp; stmtp = stmtp->nextp()) {
+            AstVar* portp = VN_CAST(stmtp, Var);
+            if (!portp || !portp->isIO() || portp->isFuncReturn()) continue;
+            if (portp->isWritable()) {
+                portp->v3error("DPI import marked /*verilator dpi_async*/ may not have "
+                               "output or inout arguments: "
+                               << portp->prettyNameQ());
+                ok = false;
+            } else if (portp->isDpiOpenArray()
+                       || (portp->basicp()
+                           && portp->basicp()->keyword() == AstBasicDTypeKwd::STRING
+                           && VN_IS(portp->dtypep()->skipRefp(), UnpackArrayDType))) {
+                portp->v3warn(E_UNSUPPORTED, "Unsupported: /*verilator dpi_async*/ with open "
+                                             "array or string array argument: "
+                                                 << portp->prettyNameQ());
+                ok = false;
+            }
+        }
+        return ok;
+    }
+
     void bodyDpiImportFunc(AstNodeFTask* nodep, AstVarScope* rtnvscp, AstCFunc* cfuncp) {
         const char* const tmpSuffixp = V3Task::dpiTemporaryVarSuffix();
+        // An async import's arguments are converted here, then captured by value
+        const bool async = nodep->dpiAsync() && checkDpiAsync(nodep, rtnvscp, cfuncp);
+        cfuncp->dpiAsync(async);
         // Convert input/inout arguments to DPI types
         string args;
         for (AstNode* stmtp = cfuncp->argsp(); stmtp; stmtp = stmtp->nextp()) {
@@ -991,6 +1025,11 @@ private:
                                + name + " (&" + propName + ", &" + portp->name() + ");\n");
                         cfuncp->addStmtsp(new AstCStmt(portp->fileline(), varCode));
                         args += "&" + name;
+                    } else if (async && portp->basicp()
+                               && portp->basicp()->keyword() == AstBasicDTypeKwd::STRING) {
+                        // Capture the std::string itself; a temporary const char* would
+                        // dangle once this wrapper returns
+                        args += portp->name() + ".c_str()";
                     } else {
                         if (portp->isWritable() && portp->basicp()->isDpiPrimitive()) {
                             if (!VN_IS(portp->dtypep()->skipRefp(), UnpackArrayDType)) args += "&";
@@ -1021,7 +1060,13 @@ private:
                 stmt = rtnvscp->varp()->name() + tmpSuffixp;
                 stmt += rtnvscp->varp()->basicp()->isDpiPrimitive() ? " = " : "[0] = ";
             }
-            stmt += nodep->cname() + "(" + args + ");\n";
+            if (async) {
+                // Temporaries (including svBitVecVal arrays) are copied into the closure
+                stmt += "VerilatedDpiAsync::post([=]() { " + nodep->cname() + "(" + args
+                        + "); });\n";
+            } else {
+                stmt += nodep->cname() + "(" + args + ");\n";
+            }
             cfuncp->addStmtsp(new AstCStmt(nodep->fileline(), stmt));
         }
 
@@ -1133,6 +1178,7 @@ private:
         cfuncp->funcPublic(nodep->taskPublic());
         cfuncp->dpiExport(nodep->dpiExport());
         cfuncp->dpiImportWrapper(nodep->dpiImport());
+        if (nodep->dpiImport()) cfuncp->dpiGroups(nodep->dpiGroups());
         cfuncp->isStatic(!(nodep->dpiImport() || nodep->taskPublic() || nodep->classMethod()));
         cfuncp->isVirtual(nodep->isVirtual());
         cfuncp->pure(nodep->pure());
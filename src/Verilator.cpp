@@ -21,6 +21,7 @@
 #include "V3ActiveTop.h"
 #include "V3Assert.h"
 #include "V3AssertPre.h"
+#include "V3Assoc.h"
 #include "V3Begin.h"
 #include "V3Branch.h"
 #include "V3Broken.h"
@@ -368,6 +369,10 @@ static void process() {
         // down to a module and now be identical
         V3ActiveTop::activeTopAll(v3Global.rootp());
 
+        // Give random call sites their own streams, before ordering so the
+        // streams' state is ordered (and partitioned) like any variable
+        if (v3Global.opt.randStreams()) V3Randomize::randStreamsAll(v3Global.rootp());
+
         if (v3Global.opt.stats()) V3Stats::statsStageAll(v3Global.rootp(), "PreOrder");
         if (v3Global.opt.debugEmitV()) V3EmitV::debugEmitV("preorder");
 
@@ -473,6 +478,9 @@ static void process() {
             V3Reloop::reloopAll(v3Global.rootp());
         }
 
+        // Choose associative array containers from how each array is used
+        if (v3Global.opt.oAssoc()) V3Assoc::assocAll(v3Global.rootp());
+
         // Fix very deep expressions
         // Mark evaluation functions as member functions, if needed.
         V3Depth::depthAll(v3Global.rootp());
@@ -20,6 +20,8 @@
 #include "config_build.h"
 #include "verilatedos.h"
 
+#include <algorithm>
+
 //********************************************************************
 // VlcBuckets - Container of all coverage point hits for a given test
 // This is a bitmap array - we store a single bit to indicate a test
@@ -91,24 +93,35 @@ public:
             return (m_datap[point / 64] & covBit(point)) ? 1 : 0;
         }
     }
+    static int popCount64(vluint64_t word) {
+#if defined(__GNUC__)
+        return __builtin_popcountll(word);
+#else
+        word = word - ((word >> 1) & 0x5555555555555555ULL);
+        word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+        word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+        return static_cast<int>((word * 0x0101010101010101ULL) >> 56);
+#endif
+    }
+    vluint64_t words() const { return m_dataSize / 64; }
     vluint64_t popCount() const {
         vluint64_t pop = 0;
-        for (vluint64_t i = 0; i < m_dataSize; i++) {
-            if (hits(i)) pop++;
-        }
+        for (vluint64_t w = 0; w < words(); ++w) pop += popCount64(m_datap[w]);
         return pop;
     }
-    vluint64_t dataPopCount(const VlcBuckets& remaining) {
+    vluint64_t dataPopCount(const VlcBuckets& remaining) const {
+        // Word at a time, so the compiler may vectorize the popcounts
+        const vluint64_t n = std::min(words(), remaining.words());
+        const vluint64_t* const ap = m_datap;
+        const vluint64_t* const bp = remaining.m_datap;
         vluint64_t pop = 0;
-        for (vluint64_t i = 0; i < m_dataSize; i++) {
-            if (hits(i) && remaining.hits(i)) pop++;
-        }
+        for (vluint64_t w = 0; w < n; ++w) pop += popCount64(ap[w] & bp[w]);
         return pop;
     }
     void orData(const VlcBuckets& ordata) {
-        for (vluint64_t i = 0; i < m_dataSize; i++) {
-            if (hits(i) && ordata.hits(i)) clearHits(i);
-        }
+        // Clear our hits that are also in ordata
+        const vluint64_t n = std::min(words(), ordata.words());
+        for (vluint64_t w = 0; w < n; ++w) m_datap[w] &= ~ordata.m_datap[w];
     }
 
     void dump() const {
@@ -99,6 +99,13 @@ void VlcOptions::parseOptsList(int argc, char** argv) {
             } else if (!strcmp(sw, "-debugi") && (i + 1) < argc) {
                 shift;
                 V3Error::debugDefault(atoi(argv[i]));
+            } else if (!strcmp(sw, "-merge-db") && (i + 1) < argc) {
+                shift;
+                m_mergeDb = argv[i];
+            } else if (!strcmp(sw, "-threads") && (i + 1) < argc) {
+                shift;
+                m_threads = atoi(argv[i]);
+                if (m_threads < 0) v3fatal("--threads must be >= 0: " << argv[i]);
             } else if (!strcmp(sw, "-V")) {
                 showVersion(true);
                 exit(0);
@@ -108,6 +115,9 @@ void VlcOptions::parseOptsList(int argc, char** argv) {
             } else if (!strcmp(sw, "-write") && (i + 1) < argc) {
                 shift;
                 m_writeFile = argv[i];
+            } else if (!strcmp(sw, "-write-binary") && (i + 1) < argc) {
+                shift;
+                m_writeBinaryFile = argv[i];
             } else if (!strcmp(sw, "-write-info") && (i + 1) < argc) {
                 shift;
                 m_writeInfoFile = argv[i];
@@ -150,11 +160,16 @@ int main(int argc, char** argv, char** /*env*/) {
     // Command option parsing
     top.opt.parseOptsList(argc - 1, argv + 1);
 
-    if (top.opt.readFiles().empty()) top.opt.addReadFile("vlt_coverage.dat");
+    if (!top.opt.mergeDb().empty()) {
+        top.readDatabase(top.opt.mergeDb());
+    } else if (top.opt.readFiles().empty()) {
+        top.opt.addReadFile("vlt_coverage.dat");
+    }
 
-    {
-        const VlStringSet& readFiles = top.opt.readFiles();
-        for (const auto& filename : readFiles) top.readCoverage(filename);
+    top.readCoverages(top.opt.readFiles());
+    if (!top.opt.mergeDb().empty()) {
+        V3Error::abortIfWarnings();
+        top.writeDatabase();
     }
 
     if (debug() >= 9) {
@@ -170,8 +185,12 @@ int main(int argc, char** argv, char** /*env*/) {
         top.tests().dump(false);
     }
 
-    if (!top.opt.writeFile().empty() || !top.opt.writeInfoFile().empty()) {
+    if (!top.opt.writeFile().empty() || !top.opt.writeBinaryFile().empty()
+        || !top.opt.writeInfoFile().empty() || !top.opt.mergeDb().empty()) {
         if (!top.opt.writeFile().empty()) top.writeCoverage(top.opt.writeFile());
+        if (!top.opt.writeBinaryFile().empty()) {
+            top.writeCoverageBinary(top.opt.writeBinaryFile());
+        }
         if (!top.opt.writeInfoFile().empty()) top.writeInfo(top.opt.writeInfoFile());
         V3Error::abortIfWarnings();
         if (top.opt.unlink()) {
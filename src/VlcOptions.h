@@ -37,10 +37,13 @@ class VlcOptions final {
     string m_annotateOut;       // main switch: --annotate I<output_directory>
     bool m_annotateAll=false;         // main switch: --annotate-all
     int m_annotateMin=10;          // main switch: --annotate-min I<count>
+    string m_mergeDb;           // main switch: --merge-db
     VlStringSet m_readFiles;    // main switch: --read
     bool m_rank=false;                // main switch: --rank
+    int m_threads=0;                  // main switch: --threads
     bool m_unlink=false;              // main switch: --unlink
     string m_writeFile;         // main switch: --write
+    string m_writeBinaryFile;   // main switch: --write-binary
     string m_writeInfoFile;     // main switch: --write-info
     // clang-format on
 
@@ -60,12 +63,15 @@ public:
 
     // ACCESSORS (options)
     const VlStringSet& readFiles() const { return m_readFiles; }
+    string mergeDb() const { return m_mergeDb; }
     string annotateOut() const { return m_annotateOut; }
     bool annotateAll() const { return m_annotateAll; }
     int annotateMin() const { return m_annotateMin; }
     bool rank() const { return m_rank; }
+    int threads() const { return m_threads; }
     bool unlink() const { return m_unlink; }
     string writeFile() const { return m_writeFile; }
+    string writeBinaryFile() const { return m_writeBinaryFile; }
     string writeInfoFile() const { return m_writeInfoFile; }
 
     // METHODS (from main)
@@ -118,6 +118,7 @@ public:
             point.dump();
         }
     }
+    vluint64_t size() const { return m_numPoints; }
     VlcPoint& pointNumber(vluint64_t num) { return m_points[num]; }
     vluint64_t findAddPoint(const string& name, vluint64_t count) {
         vluint64_t pointnum;
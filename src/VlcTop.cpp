@@ -20,44 +20,530 @@
 #include "VlcTop.h"
 
 #include <algorithm>
+#include <atomic>
 #include <fstream>
+#include <thread>
+
+// clang-format off
+#if defined(_WIN32) || defined(__MINGW32__)
+# include <iterator>
+#else
+# include <fcntl.h>
+# include <sys/file.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+// clang-format on
 
 //######################################################################
+// VlcMappedFile - Read-only view of an entire file, memory mapped if possible
+
+class VlcMappedFile final {
+    // MEMBERS
+    const char* m_datap = nullptr;  //< Start of file contents
+    size_t m_size = 0;  //< Bytes in file
+    bool m_ok = false;  //< Opened successfully
+#if defined(_WIN32) || defined(__MINGW32__)
+    string m_contents;  //< File contents, as no mmap
+#endif
+
+public:
+    // CONSTRUCTORS
+    explicit VlcMappedFile(const string& filename) {
+#if defined(_WIN32) || defined(__MINGW32__)
+        std::ifstream is(filename.c_str(), std::ios::in | std::ios::binary);
+        if (!is) return;
+        m_contents.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+        m_datap = m_contents.data();
+        m_size = m_contents.size();
+        m_ok = true;
+#else
+        const int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat st;
+        if (fstat(fd, &st) == 0) {
+            m_size = st.st_size;
+            m_ok = true;
+            if (m_size) {
+                void* mapp = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (mapp == MAP_FAILED) {
+                    m_size = 0;
+                    m_ok = false;
+                } else {
+                    m_datap = static_cast<const char*>(mapp);
+                }
+            }
+        }
+        ::close(fd);
+#endif
+    }
+    ~VlcMappedFile() {
+#if !defined(_WIN32) && !defined(__MINGW32__)
+        if (m_datap) munmap(const_cast<char*>(m_datap), m_size);
+#endif
+    }
+    VL_UNCOPYABLE(VlcMappedFile);
+
+    // ACCESSORS
+    bool ok() const { return m_ok; }
+    const char* datap() const { return m_datap; }
+    size_t size() const { return m_size; }
+};
+
+//######################################################################
+// VlcFileData - Coverage data of one file, before merging into VlcTop
+
+struct VlcFileData final {
+    string m_names;  //< Point names, each NUL terminated
+    std::vector<vluint64_t> m_counts;  //< Count of each point, in m_names order
+    string m_error;  //< Error message if the file could not be read
+
+    void clear() {
+        m_names.clear();
+        m_counts.clear();
+        m_error.clear();
+    }
+};
+
+// Read a text or binary coverage file. Does not touch VlcTop, so is thread safe.
+static void vlcReadFileData(const string& filename, VlcFileData& data) {
+    data.clear();
+    const VlcMappedFile file(filename);
+    if (!file.ok()) {
+        data.m_error = "Can't read " + filename;
+        return;
+    }
+    const char* const datap = file.datap();
+    const size_t size = file.size();
+
+    if (size >= 8 && 0 == memcmp(datap, VL_COV_BINARY_MAGIC, 8)) {
+        // See verilated_cov_key.h for the format
+        const size_t headerBytes = 8 + 2 * sizeof(vluint32_t) + 2 * sizeof(vluint64_t);
+        if (size < headerBytes) {
+            data.m_error = "Truncated binary coverage data: " + filename;
+            return;
+        }
+        vluint32_t endian;
+        vluint64_t numPoints;
+        vluint64_t namesBytes;
+        memcpy(&endian, datap + 8, sizeof(endian));
+        memcpy(&numPoints, datap + 16, sizeof(numPoints));
+        memcpy(&namesBytes, datap + 24, sizeof(namesBytes));
+        if (endian != VL_COV_BINARY_ENDIAN) {
+            data.m_error = "Binary coverage data written with other byte order: " + filename;
+            return;
+        }
+        if (namesBytes > size - headerBytes
+            || numPoints > (size - headerBytes - namesBytes) / sizeof(vluint64_t)) {
+            data.m_error = "Truncated binary coverage data: " + filename;
+            return;
+        }
+        const char* const namesp = datap + headerBytes;
+        const char* const countsp = namesp + namesBytes;
+        // Drop the table padding, so equal tables compare equal
+        const char* namep = namesp;
+        for (vluint64_t i = 0; i < numPoints; ++i) {
+            const char* const endp
+                = static_cast<const char*>(memchr(namep, '\0', countsp - namep));
+            if (!endp) {
+                data.m_error = "Corrupt binary coverage data: " + filename;
+                return;
+            }
+            namep = endp + 1;
+        }
+        data.m_names.assign(namesp, namep - namesp);
+        data.m_counts.resize(numPoints);
+        if (numPoints) memcpy(data.m_counts.data(), countsp, numPoints * sizeof(vluint64_t));
+        return;
+    }
+
+    const char* const endp = datap + size;
+    for (const char* linep = datap; linep < endp;) {
+        const char* eolp = static_cast<const char*>(memchr(linep, '\n', endp - linep));
+        if (!eolp) eolp = endp;
+        // UINFO(9," got "<<string(linep, eolp - linep)<<endl);
+        if (linep[0] == 'C' && eolp - linep > 3) {
+            const char* secspacep = linep + 3;
+            for (; secspacep < eolp; ++secspacep) {
+                if (secspacep[0] == '\'' && secspacep + 1 < eolp && secspacep[1] == ' ') break;
+            }
+            data.m_names.append(linep + 3, secspacep - (linep + 3));
+            data.m_names += '\0';
+            const char* cp = secspacep + 1;
+            while (cp < eolp && isspace(*cp)) ++cp;
+            vluint64_t hits = 0;
+            for (; cp < eolp && isdigit(*cp); ++cp) hits = hits * 10 + (*cp - '0');
+            // UINFO(9,"   point '"<<point<<"'"<<" "<<hits<<endl);
+            data.m_counts.push_back(hits);
+        }
+        linep = eolp + 1;
+    }
+}
+
+const std::vector<vluint64_t>& VlcTop::namesToPoints(const string& names, vluint64_t numPoints) {
+    // Resolve a name table to point numbers, once per distinct table
+    std::vector<vluint64_t>& pointnums = m_nameTables[names];
+    if (pointnums.size() != numPoints) {
+        pointnums.clear();
+        pointnums.reserve(numPoints);
+        for (const char* namep = names.c_str(); pointnums.size() < numPoints;) {
+            const size_t len = strlen(namep);
+            pointnums.push_back(points().findAddPoint(string(namep, len), 0));
+            namep += len + 1;
+        }
+    }
+    return pointnums;
+}
+
+void VlcTop::mergeFileData(const VlcFileData& data, VlcTest* testp) {
+    const std::vector<vluint64_t>& pointnums = namesToPoints(data.m_names, data.m_counts.size());
+    if (testp && !m_dbDir.empty()) addDatabaseRun(testp->name(), pointnums, data.m_counts);
+    for (size_t i = 0; i < data.m_counts.size(); ++i) {
+        const vluint64_t hits = data.m_counts[i];
+        VlcPoint& point = points().pointNumber(pointnums[i]);
+        point.countInc(hits);
+        if (testp && opt.rank()) {  // Only if ranking - uses a lot of memory
+            if (hits >= VlcBuckets::sufficient()) {
+                point.testsCoveringInc();
+                testp->buckets().addData(pointnums[i], hits);
+            }
+        }
+    }
+}
 
 void VlcTop::readCoverage(const string& filename, bool nonfatal) {
     UINFO(2, "readCoverage " << filename << endl);
 
-    std::ifstream is(filename.c_str());
-    if (!is) {
-        if (!nonfatal) v3fatal("Can't read " << filename);
+    VlcFileData data;
+    vlcReadFileData(filename, data);
+    if (!data.m_error.empty()) {
+        if (!nonfatal) v3fatal(data.m_error);
         return;
     }
 
     // Testrun and computrons argument unsupported as yet
     VlcTest* testp = tests().newTest(filename, 0, 0);
+    mergeFileData(data, testp);
+}
 
-    while (!is.eof()) {
-        string line = V3Os::getline(is);
-        // UINFO(9," got "<<line<<endl);
-        if (line[0] == 'C') {
-            string::size_type secspace = 3;
-            for (; secspace < line.length(); secspace++) {
-                if (line[secspace] == '\'' && line[secspace + 1] == ' ') break;
+void VlcTop::readCoverages(const VlStringSet& filenames) {
+    const std::vector<string> files(filenames.begin(), filenames.end());
+    unsigned threads = opt.threads();
+    if (!threads) threads = std::max(1U, std::thread::hardware_concurrency());
+    threads = std::min<size_t>(threads, files.size());
+    if (threads <= 1) {
+        for (const auto& filename : files) readCoverage(filename);
+        return;
+    }
+    UINFO(2, "readCoverages " << files.size() << " files on " << threads << " threads" << endl);
+
+    // Testrun and computrons argument unsupported as yet
+    std::vector<VlcTest*> testps;
+    for (const auto& filename : files) testps.push_back(tests().newTest(filename, 0, 0));
+
+    if (opt.rank() || !m_dbDir.empty()) {
+        // Each test needs its own buckets or database run, so read a batch
+        // of files in parallel, then merge the batch in file order
+        const size_t batch = threads * 4;
+        std::vector<VlcFileData> datas(batch);
+        for (size_t start = 0; start < files.size(); start += batch) {
+            const size_t end = std::min(start + batch, files.size());
+            std::atomic<size_t> next{start};
+            std::vector<std::thread> workers;
+            for (unsigned t = 0; t < threads; ++t) {
+                workers.emplace_back([&]() {
+                    for (size_t i = next++; i < end; i = next++) {
+                        vlcReadFileData(files[i], datas[i - start]);
+                    }
+                });
             }
-            string point = line.substr(3, secspace - 3);
-            vluint64_t hits = atoll(line.c_str() + secspace + 1);
-            // UINFO(9,"   point '"<<point<<"'"<<" "<<hits<<endl);
+            for (auto& worker : workers) worker.join();
+            for (size_t i = start; i < end; ++i) {
+                const VlcFileData& data = datas[i - start];
+                if (!data.m_error.empty()) v3fatal(data.m_error);
+                mergeFileData(data, testps[i]);
+            }
+        }
+        return;
+    }
 
-            vluint64_t pointnum = points().findAddPoint(point, hits);
-            if (pointnum) {}  // Prevent unused
-            if (opt.rank()) {  // Only if ranking - uses a lot of memory
-                if (hits >= VlcBuckets::sufficient()) {
-                    points().pointNumber(pointnum).testsCoveringInc();
-                    testp->buckets().addData(pointnum, hits);
+    // Without ranking only the totals matter, so each thread sums the counts
+    // of the files it reads per name table, then the per-thread sums are
+    // reduced.  Runs of the same model share a name table, so the sums stay small.
+    struct Partial {
+        size_t m_firstFile;  // Lowest file index with this table, for stable numbering
+        VlcFileData m_data;  // Name table and summed counts
+    };
+    typedef std::unordered_map<string, Partial> Partials;
+    std::vector<Partials> partials(threads);
+    std::vector<string> errors(files.size());
+    {
+        std::atomic<size_t> next{0};
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t]() {
+                VlcFileData data;
+                for (size_t i = next++; i < files.size(); i = next++) {
+                    vlcReadFileData(files[i], data);
+                    if (!data.m_error.empty()) {
+                        errors[i] = data.m_error;
+                        continue;
+                    }
+                    const auto it = partials[t].find(data.m_names);
+                    if (it == partials[t].end()) {
+                        Partial& partial = partials[t][data.m_names];
+                        partial.m_firstFile = i;
+                        partial.m_data.m_names.swap(data.m_names);
+                        partial.m_data.m_counts.swap(data.m_counts);
+                    } else {
+                        std::vector<vluint64_t>& sums = it->second.m_data.m_counts;
+                        for (size_t p = 0; p < sums.size(); ++p) sums[p] += data.m_counts[p];
+                    }
                 }
+            });
+        }
+        for (auto& worker : workers) worker.join();
+    }
+    for (const auto& error : errors) {
+        if (!error.empty()) v3fatal(error);
+    }
+    std::vector<const Partial*> ordered;
+    for (const auto& threadPartials : partials) {
+        for (const auto& it : threadPartials) ordered.push_back(&it.second);
+    }
+    std::stable_sort(ordered.begin(), ordered.end(), [](const Partial* ap, const Partial* bp) {
+        return ap->m_firstFile < bp->m_firstFile;
+    });
+    for (const Partial* partialp : ordered) mergeFileData(partialp->m_data, nullptr);
+}
+
+//######################################################################
+// Merge database
+//
+// A merge database directory holds:
+//     points.dat  Point names, one per line; the line number is the point's index
+//     totals.dat  vluint64_t count of each point, summed over all runs
+//     runs.dat    For each run folded in: vluint64_t bytes of the test name,
+//                 the name, vluint64_t number of hit points, then that many
+//                 pairs of vluint64_t point index and count
+// Points and runs are only ever appended, so folding in a run costs time
+// proportional to the run and the number of points, not to the history.
+//
+// A merge first writes the new points and runs to points.dat.new and
+// runs.dat.new, and the totals to totals.dat.tmp.  It then commits by
+// renaming commit.tmp to commit.dat, which holds the vluint64_t sizes of
+// points.dat and runs.dat before the merge.  Applying a commit rewrites the
+// new points and runs at those sizes, renames the totals, and removes
+// commit.dat, so may be repeated; an interrupted merge is finished by the
+// next one if it committed, else discarded.  The lock file serializes
+// merges into the same database.
+
+static vluint64_t vlcFileSize(const string& filename) {
+    std::ifstream is(filename.c_str(), std::ios::in | std::ios::binary | std::ios::ate);
+    return is ? static_cast<vluint64_t>(is.tellg()) : 0;
+}
+
+static void vlcApplyAppend(const string& filename, vluint64_t size) {
+    // Make the file its first size bytes followed by filename.new
+    const VlcMappedFile newFile(filename + ".new");
+    if (!newFile.ok()) v3fatal("Can't read " << filename << ".new");
+    if (vlcFileSize(filename) < size) v3fatal("Corrupt coverage database: " << filename);
+    std::fstream os(filename.c_str(), size ? (std::ios::in | std::ios::out | std::ios::binary)
+                                           : (std::ios::out | std::ios::binary));
+    os.seekp(size);
+    os.write(newFile.datap(), newFile.size());
+    os.close();
+    if (!os) v3fatal("Can't write " << filename);
+}
+
+static void vlcWriteFile(const string& filename, const string& contents) {
+    std::ofstream os(filename.c_str(), std::ios::out | std::ios::binary);
+    os.write(contents.data(), contents.size());
+    os.close();
+    if (!os) v3fatal("Can't write " << filename);
+}
+
+void VlcTop::lockDatabase() {
+#if !defined(_WIN32) && !defined(__MINGW32__)
+    const string filename = m_dbDir + "/lock";
+    m_dbLockFd = ::open(filename.c_str(), O_CREAT | O_RDWR, 0666);
+    if (m_dbLockFd < 0 || ::flock(m_dbLockFd, LOCK_EX) != 0) {
+        v3fatal("Can't lock " << filename);
+    }
+#endif
+}
+
+void VlcTop::unlockDatabase() {
+#if !defined(_WIN32) && !defined(__MINGW32__)
+    if (m_dbLockFd >= 0) ::close(m_dbLockFd);  // Releases the lock
+    m_dbLockFd = -1;
+#endif
+}
+
+void VlcTop::applyDatabaseCommit() {
+    const string& dirname = m_dbDir;
+    const VlcMappedFile commit(dirname + "/commit.dat");
+    if (commit.ok()) {
+        vluint64_t sizes[2];  // points.dat and runs.dat before the merge
+        if (commit.size() != sizeof(sizes)) {
+            v3fatal("Corrupt coverage database commit: " << dirname);
+            return;
+        }
+        memcpy(sizes, commit.datap(), sizeof(sizes));
+        vlcApplyAppend(dirname + "/points.dat", sizes[0]);
+        vlcApplyAppend(dirname + "/runs.dat", sizes[1]);
+        const string tmpname = dirname + "/totals.dat.tmp";
+        if (std::ifstream(tmpname.c_str()).good()) {  // Else renamed by an earlier apply
+            if (rename(tmpname.c_str(), (dirname + "/totals.dat").c_str()) != 0) {
+                v3fatal("Can't rename " << tmpname);
             }
         }
+        // Done once the marker is gone
+        if (remove((dirname + "/commit.dat").c_str()) != 0) {
+            v3fatal("Can't remove " << dirname << "/commit.dat");
+        }
+    }
+    // Not committed, or already applied
+    remove((dirname + "/points.dat.new").c_str());
+    remove((dirname + "/runs.dat.new").c_str());
+    remove((dirname + "/totals.dat.tmp").c_str());
+    remove((dirname + "/commit.tmp").c_str());
+}
+
+void VlcTop::readDatabase(const string& dirname) {
+    UINFO(2, "readDatabase " << dirname << endl);
+    m_dbDir = dirname;
+    m_dbRuns.clear();
+    V3Os::createDir(dirname);
+    lockDatabase();  // Until writeDatabase() is done
+    applyDatabaseCommit();
+    std::ifstream pis((dirname + "/points.dat").c_str());
+    if (!pis) return;  // New database
+
+    while (!pis.eof()) {
+        const string name = V3Os::getline(pis);
+        if (name.empty()) continue;
+        if (points().findAddPoint(name, 0) != m_dbPoints) {
+            v3fatal("Duplicate point in " << dirname << "/points.dat");
+        }
+        ++m_dbPoints;
+    }
+
+    {
+        const VlcMappedFile file(dirname + "/totals.dat");
+        if (!file.ok() || file.size() != m_dbPoints * sizeof(vluint64_t)) {
+            v3fatal("Corrupt coverage database totals: " << dirname);
+            return;
+        }
+        for (vluint64_t i = 0; i < m_dbPoints; ++i) {
+            vluint64_t count;
+            memcpy(&count, file.datap() + i * sizeof(vluint64_t), sizeof(count));
+            points().pointNumber(i).countInc(count);
+        }
+    }
+
+    if (!opt.rank()) return;  // Runs are only needed for ranking
+    const VlcMappedFile file(dirname + "/runs.dat");
+    const char* cp = file.datap();
+    const char* const endp = cp + file.size();
+    const auto getu64 = [&](vluint64_t& value) {
+        if (endp - cp < static_cast<ptrdiff_t>(sizeof(value))) return false;
+        memcpy(&value, cp, sizeof(value));
+        cp += sizeof(value);
+        return true;
+    };
+    while (cp < endp) {
+        vluint64_t nameBytes;
+        vluint64_t numHits;
+        if (!getu64(nameBytes) || nameBytes > static_cast<vluint64_t>(endp - cp)) break;
+        const string name(cp, nameBytes);
+        cp += nameBytes;
+        if (!getu64(numHits)) break;
+        VlcTest* testp = tests().newTest(name, 0, 0);
+        for (vluint64_t i = 0; i < numHits; ++i) {
+            vluint64_t pointnum;
+            vluint64_t hits;
+            if (!getu64(pointnum) || !getu64(hits) || pointnum >= m_dbPoints) {
+                v3fatal("Corrupt coverage database runs: " << dirname);
+                return;
+            }
+            if (hits >= VlcBuckets::sufficient()) {
+                points().pointNumber(pointnum).testsCoveringInc();
+                testp->buckets().addData(pointnum, hits);
+            }
+        }
+    }
+    if (cp != endp) v3fatal("Corrupt coverage database runs: " << dirname);
+}
+
+void VlcTop::addDatabaseRun(const string& testname, const std::vector<vluint64_t>& pointnums,
+                            const std::vector<vluint64_t>& counts) {
+    const auto putu64 = [&](vluint64_t value) {
+        m_dbRuns.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    putu64(testname.size());
+    m_dbRuns += testname;
+    vluint64_t numHits = 0;
+    for (const vluint64_t count : counts) {
+        if (count) ++numHits;
+    }
+    putu64(numHits);
+    for (size_t i = 0; i < counts.size(); ++i) {
+        if (counts[i]) {
+            putu64(pointnums[i]);
+            putu64(counts[i]);
+        }
+    }
+}
+
+void VlcTop::writeDatabase() {
+    const string& dirname = m_dbDir;
+    UINFO(2, "writeDatabase " << dirname << endl);
+    // Stage the new points, in point number order which is their index
+    string names;
+    for (vluint64_t i = m_dbPoints; i < points().size(); ++i) {
+        names += points().pointNumber(i).name();
+        names += '\n';
+    }
+    vlcWriteFile(dirname + "/points.dat.new", names);
+    vlcWriteFile(dirname + "/runs.dat.new", m_dbRuns);
+    string totals;
+    totals.reserve(points().size() * sizeof(vluint64_t));
+    for (vluint64_t i = 0; i < points().size(); ++i) {
+        const vluint64_t count = points().pointNumber(i).count();
+        totals.append(reinterpret_cast<const char*>(&count), sizeof(count));
+    }
+    vlcWriteFile(dirname + "/totals.dat.tmp", totals);
+    // Commit
+    const vluint64_t sizes[2] = {vlcFileSize(dirname + "/points.dat"),
+                                 vlcFileSize(dirname + "/runs.dat")};
+    vlcWriteFile(dirname + "/commit.tmp", string(reinterpret_cast<const char*>(sizes),
+                                                 sizeof(sizes)));
+    if (rename((dirname + "/commit.tmp").c_str(), (dirname + "/commit.dat").c_str()) != 0) {
+        v3fatal("Can't rename " << dirname << "/commit.tmp");
+    }
+    applyDatabaseCommit();
+    m_dbPoints = points().size();
+    m_dbRuns.clear();
+    unlockDatabase();
+}
+
+void VlcTop::writeCoverageBinary(const string& filename) {
+    UINFO(2, "writeCoverageBinary " << filename << endl);
+
+    std::ofstream os(filename.c_str(), std::ios::out | std::ios::binary);
+    if (!os) {
+        v3fatal("Can't write " << filename);
+        return;
+    }
+
+    VerilatedCovBinaryWriter writer;
+    for (const auto& i : m_points) {
+        const VlcPoint& point = m_points.pointNumber(i.second);
+        writer.add(point.name(), point.count());
     }
+    writer.write(os);
 }
 
 void VlcTop::writeCoverage(const string& filename) {
@@ -154,6 +640,8 @@ void VlcTop::rank() {
         }
     }
     sort(bytime.begin(), bytime.end(), CmpComputrons());  // Sort the vector
+    tests().clearUser();
+    for (const auto& testp : bytime) testp->user(testp->buckets().popCount());
 
     VlcBuckets remaining;
     for (const auto& i : m_points) {
@@ -174,8 +662,11 @@ void VlcTop::rank() {
         VlcTest* bestTestp = nullptr;
         vluint64_t bestRemain = 0;
         for (const auto& testp : bytime) {
-            if (!testp->rank()) {
+            // A test's remaining points only shrink, so user() holds an upper
+            // bound from the last iteration; skip tests that cannot beat the best
+            if (!testp->rank() && testp->user() > bestRemain) {
                 vluint64_t remain = testp->buckets().dataPopCount(remaining);
+                testp->user(remain);
                 if (remain > bestRemain) {
                     bestTestp = testp;
                     bestRemain = remain;
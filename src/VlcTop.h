@@ -25,6 +25,11 @@
 #include "VlcPoint.h"
 #include "VlcSource.h"
 
+#include <unordered_map>
+#include <vector>
+
+struct VlcFileData;
+
 //######################################################################
 // VlcTop - Top level options container
 
@@ -37,16 +42,29 @@ private:
     VlcTests m_tests;  //< List of all tests (all coverage files)
     VlcPoints m_points;  //< List of all points
     VlcSources m_sources;  //< List of all source files to annotate
+    std::unordered_map<string, std::vector<vluint64_t>>
+        m_nameTables;  //< Binary coverage name table to point numbers
+    string m_dbDir;  //< Merge database directory, empty if none
+    vluint64_t m_dbPoints = 0;  //< Points already in the merge database
+    string m_dbRuns;  //< Run records to append to the merge database
+    int m_dbLockFd = -1;  //< Lock file held while merging into the database
 
     // METHODS
     void annotateCalc();
     void annotateCalcNeeded();
     void annotateOutputFiles(const string& dirname);
+    const std::vector<vluint64_t>& namesToPoints(const string& names, vluint64_t numPoints);
+    void mergeFileData(const VlcFileData& data, VlcTest* testp);
+    void addDatabaseRun(const string& testname, const std::vector<vluint64_t>& pointnums,
+                        const std::vector<vluint64_t>& counts);
+    void lockDatabase();
+    void unlockDatabase();
+    void applyDatabaseCommit();
 
 public:
     // CONSTRUCTORS
     VlcTop() = default;
-    ~VlcTop() = default;
+    ~VlcTop() { unlockDatabase(); }
 
     // ACCESSORS
     VlcTests& tests() { return m_tests; }
@@ -56,7 +74,11 @@ public:
     // METHODS
     void annotate(const string& dirname);
     void readCoverage(const string& filename, bool nonfatal = false);
+    void readCoverages(const VlStringSet& filenames);
+    void readDatabase(const string& dirname);
+    void writeDatabase();
     void writeCoverage(const string& filename);
+    void writeCoverageBinary(const string& filename);
     void writeInfo(const string& filename);
 
     void rank();
@@ -366,10 +366,12 @@ BISONPRE_VERSION(3.7,%define api.header.include {"V3ParseBison.h"})
 %token<fl>              yVLT_COVERAGE_BLOCK_OFF     "coverage_block_off"
 %token<fl>              yVLT_COVERAGE_OFF           "coverage_off"
 %token<fl>              yVLT_COVERAGE_ON            "coverage_on"
+%token<fl>              yVLT_DPI_GROUP              "dpi_group"
 %token<fl>              yVLT_FULL_CASE              "full_case"
 %token<fl>              yVLT_HIER_BLOCK             "hier_block"
 %token<fl>              yVLT_INLINE                 "inline"
 %token<fl>              yVLT_ISOLATE_ASSIGNMENTS    "isolate_assignments"
+%token<fl>              yVLT_LAZY_ARRAY             "lazy_array"
 %token<fl>              yVLT_LINT_OFF               "lint_off"
 %token<fl>              yVLT_LINT_ON                "lint_on"
 %token<fl>              yVLT_NO_CLOCKER             "no_clocker"
@@ -389,6 +391,7 @@ BISONPRE_VERSION(3.7,%define api.header.include {"V3ParseBison.h"})
 %token<fl>              yVLT_D_BLOCK    "--block"
 %token<fl>              yVLT_D_FILE     "--file"
 %token<fl>              yVLT_D_FUNCTION "--function"
+%token<fl>              yVLT_D_GROUP    "--group"
 %token<fl>              yVLT_D_LINES    "--lines"
 %token<fl>              yVLT_D_MODULE   "--module"
 %token<fl>              yVLT_D_MATCH    "--match"
@@ -833,10 +836,13 @@ BISONPRE_VERSION(3.7,%define api.header.include {"V3ParseBison.h"})
 %token<fl>              yVL_CLOCKER             "/*verilator clocker*/"
 %token<fl>              yVL_CLOCK_ENABLE        "/*verilator clock_enable*/"
 %token<fl>              yVL_COVERAGE_BLOCK_OFF  "/*verilator coverage_block_off*/"
+%token<fl>              yVL_DPI_ASYNC           "/*verilator dpi_async*/"
+%token<strp>            yVL_DPI_GROUP           "/*verilator dpi_group*/"
 %token<fl>              yVL_FULL_CASE           "/*verilator full_case*/"
 %token<fl>              yVL_HIER_BLOCK          "/*verilator hier_block*/"
 %token<fl>              yVL_INLINE_MODULE       "/*verilator inline_module*/"
 %token<fl>              yVL_ISOLATE_ASSIGNMENTS "/*verilator isolate_assignments*/"
+%token<fl>              yVL_LAZY_ARRAY          "/*verilator lazy_array*/"
 %token<fl>              yVL_NO_CLOCKER          "/*verilator no_clocker*/"
 %token<fl>              yVL_NO_INLINE_MODULE    "/*verilator no_inline_module*/"
 %token<fl>              yVL_NO_INLINE_TASK      "/*verilator no_inline_task*/"
@@ -2630,6 +2636,7 @@ sigAttr<nodep>:
 	|	yVL_PUBLIC_FLAT_RW attr_event_control	{ $$ = new AstAttrOf($1,AstAttrType::VAR_PUBLIC_FLAT_RW); v3Global.dpi(true);
 							  $$ = $$->addNext(new AstAlwaysPublic($1,$2,nullptr)); }
 	|	yVL_ISOLATE_ASSIGNMENTS			{ $$ = new AstAttrOf($1,AstAttrType::VAR_ISOLATE_ASSIGNMENTS); }
+	|	yVL_LAZY_ARRAY				{ $$ = new AstAttrOf($1,AstAttrType::VAR_LAZY_ARRAY); }
 	|	yVL_SC_BV				{ $$ = new AstAttrOf($1,AstAttrType::VAR_SC_BV); }
 	|	yVL_SFORMAT				{ $$ = new AstAttrOf($1,AstAttrType::VAR_SFORMAT); }
 	|	yVL_SPLIT_VAR				{ $$ = new AstAttrOf($1,AstAttrType::VAR_SPLIT_VAR); }
@@ -4076,16 +4083,18 @@ array_methodWith<nodep>:
 	;
 
 dpi_import_export<nodep>:	// ==IEEE: dpi_import_export
-		yIMPORT yaSTRING dpi_tf_import_propertyE dpi_importLabelE function_prototype ';'
-			{ $$ = $5; if (*$4 != "") $5->cname(*$4);
-			  $5->dpiContext($3==iprop_CONTEXT); $5->pure($3==iprop_PURE);
-			  $5->dpiImport(true); GRAMMARP->checkDpiVer($1,*$2); v3Global.dpi(true);
+		yIMPORT yaSTRING dpi_tf_import_propertyE dpi_groupE dpi_importLabelE function_prototype ';'
+			{ $$ = $6; if (*$5 != "") $6->cname(*$5);
+			  $6->dpiContext($3==iprop_CONTEXT); $6->pure($3==iprop_PURE);
+			  $6->dpiAsync($3==iprop_ASYNC); $6->addDpiGroups(*$4);
+			  $6->dpiImport(true); GRAMMARP->checkDpiVer($1,*$2); v3Global.dpi(true);
 			  if ($$->prettyName()[0]=='$') SYMP->reinsert($$,nullptr,$$->prettyName());  // For $SysTF overriding
 			  SYMP->reinsert($$); }
-	|	yIMPORT yaSTRING dpi_tf_import_propertyE dpi_importLabelE task_prototype ';'
-			{ $$ = $5; if (*$4 != "") $5->cname(*$4);
-			  $5->dpiContext($3==iprop_CONTEXT); $5->pure($3==iprop_PURE);
-			  $5->dpiImport(true); $5->dpiTask(true); GRAMMARP->checkDpiVer($1,*$2); v3Global.dpi(true);
+	|	yIMPORT yaSTRING dpi_tf_import_propertyE dpi_groupE dpi_importLabelE task_prototype ';'
+			{ $$ = $6; if (*$5 != "") $6->cname(*$5);
+			  $6->dpiContext($3==iprop_CONTEXT); $6->pure($3==iprop_PURE);
+			  $6->dpiAsync($3==iprop_ASYNC); $6->addDpiGroups(*$4);
+			  $6->dpiImport(true); $6->dpiTask(true); GRAMMARP->checkDpiVer($1,*$2); v3Global.dpi(true);
 			  if ($$->prettyName()[0]=='$') SYMP->reinsert($$,nullptr,$$->prettyName());  // For $SysTF overriding
 			  SYMP->reinsert($$); }
 	|	yEXPORT yaSTRING dpi_importLabelE yFUNCTION idAny ';'
@@ -4105,6 +4114,13 @@ dpi_tf_import_propertyE<iprop>:	// IEEE: [ dpi_function_import_property + dpi_ta
 		/* empty */				{ $$ = iprop_NONE; }
 	|	yCONTEXT				{ $$ = iprop_CONTEXT; }
 	|	yPURE					{ $$ = iprop_PURE; }
+	//			// Verilator extension: side-effect-only import run off the eval thread
+	|	yVL_DPI_ASYNC				{ $$ = iprop_ASYNC; }
+	;
+
+dpi_groupE<strp>:		// Verilator extension: DPI hazard groups for --threads
+		/* empty */				{ static string s; $$ = &s; }
+	|	yVL_DPI_GROUP				{ $$ = $1; }
 	;
 
 //************************************************
@@ -6328,6 +6344,8 @@ vltItem:
 			{ V3Config::addCoverageBlockOff(*$3, $5->toUInt()); }
 	|	yVLT_COVERAGE_BLOCK_OFF yVLT_D_MODULE yaSTRING yVLT_D_BLOCK yaSTRING
 			{ V3Config::addCoverageBlockOff(*$3, *$5); }
+	|	yVLT_DPI_GROUP vltDModuleE vltDFTaskE yVLT_D_GROUP str
+			{ V3Config::addDpiGroup($<fl>1, *$2, *$3, *$5); }
 	|	yVLT_FULL_CASE yVLT_D_FILE yaSTRING
 			{ V3Config::addCaseFull(*$3, 0); }
 	|	yVLT_FULL_CASE yVLT_D_FILE yaSTRING yVLT_D_LINES yaINTNUM
@@ -6391,6 +6409,7 @@ vltVarAttrFront<attrtypeen>:
 		yVLT_CLOCK_ENABLE           { $$ = AstAttrType::VAR_CLOCK_ENABLE; }
 	|	yVLT_CLOCKER                { $$ = AstAttrType::VAR_CLOCKER; }
 	|	yVLT_ISOLATE_ASSIGNMENTS    { $$ = AstAttrType::VAR_ISOLATE_ASSIGNMENTS; }
+	|	yVLT_LAZY_ARRAY             { $$ = AstAttrType::VAR_LAZY_ARRAY; }
 	|	yVLT_NO_CLOCKER             { $$ = AstAttrType::VAR_NO_CLOCKER; }
 	|	yVLT_PUBLIC                 { $$ = AstAttrType::VAR_PUBLIC; v3Global.dpi(true); }
 	|	yVLT_PUBLIC_FLAT            { $$ = AstAttrType::VAR_PUBLIC_FLAT; v3Global.dpi(true); }
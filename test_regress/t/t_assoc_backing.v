@@ -0,0 +1,85 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2020 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`define checkh(gotv,expv) do if ((gotv) !== (expv)) begin $write("%%Error: %s:%0d:  got='h%x exp='h%x\n", `__FILE__,`__LINE__, (gotv), (expv)); $stop; end while(0);
+`define checks(gotv,expv) do if ((gotv) !== (expv)) begin $write("%%Error: %s:%0d:  got='%s' exp='%s'\n", `__FILE__,`__LINE__, (gotv), (expv)); $stop; end while(0);
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+
+   // Only indexed and order-free methods: hashed
+   int hmem[int];
+   int names[string];
+   // Iterated in index order: paged
+   bit [31:0] pmem[bit [31:0]];
+   // Printed whole: stays ordered
+   int omap[int];
+
+   int i;
+   int n;
+   bit [31:0] k;
+   bit [31:0] prev;
+   string s;
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc == 1) begin
+         for (i = 0; i < 1000; i++) hmem[i * 7919] = i;
+         for (i = 0; i < 1000; i += 2) hmem.delete(i * 7919);
+         `checkh(hmem.size(), 500);
+         `checkh(hmem.exists(7919), 1);
+         `checkh(hmem.exists(2 * 7919), 0);
+         `checkh(hmem[999 * 7919], 999);
+         `checkh(hmem.sum(), 250000);
+         hmem.delete();
+         `checkh(hmem.size(), 0);
+
+         names["alpha"] = 1;
+         names["beta"] = 2;
+         names.delete("alpha");
+         `checkh(names.exists("alpha"), 0);
+         `checkh(names["beta"], 2);
+      end
+      else if (cyc == 2) begin
+         // Sparse, spanning many pages
+         for (i = 0; i < 300; i++) pmem[32'h8000_0000 + i * 37] = i;
+         pmem.delete(32'h8000_0000 + 37);
+         `checkh(pmem.size(), 299);
+         n = 0;
+         if (pmem.first(k)) begin
+            `checkh(k, 32'h8000_0000);
+            do begin
+               if (n != 0) `checkh(k > prev, 1'b1);
+               prev = k;
+               n++;
+            end while (pmem.next(k));
+         end
+         `checkh(n, 299);
+         `checkh(pmem.last(k), 1);
+         `checkh(k, 32'h8000_0000 + 299 * 37);
+         `checkh(pmem.prev(k), 1);
+         `checkh(k, 32'h8000_0000 + 298 * 37);
+         k = 32'h8000_0000 + 2 * 37;
+         `checkh(pmem.prev(k), 1);
+         `checkh(k, 32'h8000_0000);
+      end
+      else if (cyc == 3) begin
+         omap[3] = 30;
+         omap[1] = 10;
+         s = $sformatf("%p", omap);
+         `checks(s, "'{'h1:'ha, 'h3:'h1e} ");
+      end
+      else if (cyc == 9) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
@@ -16,6 +16,8 @@ module t (/*AUTOARG*/);
       int qi[$];  // Index returns
       int i;
       string v;
+      int qs[string];  // Key type differs from value type
+      string qk[$];  // String index returns
 
       q = '{10:1, 11:2, 12:2, 13:4, 14:3};
       v = $sformatf("%p", q); `checks(v, "'{'ha:'h1, 'hb:'h2, 'hc:'h2, 'hd:'h4, 'he:'h3} ");
@@ -67,6 +69,16 @@ module t (/*AUTOARG*/);
       qi = q.find_last_index with (item == 20);
       v = $sformatf("%p", qi); `checks(v, "'{}");
 
+      qs = '{"a":1, "b":2, "c":2};
+      qk = qs.find_first_index with (item == 2);
+      v = $sformatf("%p", qk); `checks(v, "'{\"b\"} ");
+      qk = qs.find_last_index with (item == 2);
+      v = $sformatf("%p", qk); `checks(v, "'{\"c\"} ");
+      qk = qs.find_first_index with (item == 20);
+      v = $sformatf("%p", qk); `checks(v, "'{}");
+      qk = qs.find_last_index with (item == 20);
+      v = $sformatf("%p", qk); `checks(v, "'{}");
+
       qi = q.find_index with (item.index == 12);
       v = $sformatf("%p", qi); `checks(v, "'{'hc} ");
       qi = q.find with (item.index == 12);
@@ -27,5 +27,13 @@ files_identical_sorted("$Self->{obj_dir}/coverage2.dat", "t/t_cover_lib_2.out");
 files_identical_sorted("$Self->{obj_dir}/coverage3.dat", "t/t_cover_lib_3.out");
 files_identical_sorted("$Self->{obj_dir}/coverage4.dat", "t/t_cover_lib_4.out");
 
+# Binary data read back by verilator_coverage must match the text data
+run(cmd => ["../bin/verilator_coverage",
+            "--write", "$Self->{obj_dir}/coverage1_bin.dat",
+            "$Self->{obj_dir}/coverage1.bin"],
+    verilator_run => 1,
+    );
+files_identical_sorted("$Self->{obj_dir}/coverage1_bin.dat", "t/t_cover_lib_1.out");
+
 ok(1);
 1;
@@ -41,6 +41,7 @@ int main() {
     coverw[1] = 220;
 
     VerilatedCov::write(VL_STRINGIFY(TEST_OBJ_DIR) "/coverage1.dat");
+    VerilatedCov::writeBinary(VL_STRINGIFY(TEST_OBJ_DIR) "/coverage1.bin");
     VerilatedCov::clearNonMatch("kept_");
     VerilatedCov::write(VL_STRINGIFY(TEST_OBJ_DIR) "/coverage2.dat");
     VerilatedCov::zero();
@@ -0,0 +1,33 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vltmt => 1);
+
+compile(
+    verilator_flags2 => ["--threads 4", $Self->wno_unopthreads_for_few_cores()],
+    );
+
+execute(
+    logfile => "$Self->{obj_dir}/sync.log",
+    check_finished => 1,
+    );
+
+# Each eval writes more than a ring holds, and $finish is in the middle of
+# an mtask's output, so output must still match the synchronous version
+execute(
+    all_run_flags => ["+verilator+log+async"],
+    logfile => "$Self->{obj_dir}/async.log",
+    check_finished => 1,
+    );
+
+files_identical("$Self->{obj_dir}/async.log", "$Self->{obj_dir}/sync.log");
+
+ok(1);
+1;
@@ -0,0 +1,49 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2020 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      $display("[%0d] top", cyc);
+   end
+
+   sub #(.ID(0)) sub0 (.clk, .cyc);
+   sub #(.ID(1)) sub1 (.clk, .cyc);
+   sub #(.ID(2)) sub2 (.clk, .cyc);
+   sub #(.ID(3)) sub3 (.clk, .cyc);
+endmodule
+
+module sub #(parameter ID = 0)
+   (/*AUTOARG*/
+   // Inputs
+   clk, cyc
+   );
+   input clk;
+   input integer cyc;
+
+   integer i;
+   reg [31:0] sum;
+
+   always @ (posedge clk) begin
+      sum = cyc;
+      for (i = 0; i < 400; i = i + 1) begin
+         sum = sum * 32'h9e3779b9 + ID;
+         $display("[%0d] id=%0d line=%0d sum=%x ............................................",
+                  cyc, ID, i, sum);
+         if (ID == 1 && cyc == 8 && i == 200) begin
+            $write("*-* All Finished *-*\n");
+            $finish;
+         end
+      end
+   end
+endmodule
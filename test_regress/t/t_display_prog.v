@@ -0,0 +1,42 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2020 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`define checks(gotv,expv) do if ((gotv) != (expv)) begin $write("%%Error: %s:%0d:  got='%s' exp='%s'\n", `__FILE__,`__LINE__, (gotv), (expv)); $stop; end while(0);
+
+module t (/*AUTOARG*/);
+
+   logic [7:0]  b8;
+   logic [40:0] q41;
+   logic [99:0] w100;
+   int          i;
+   string       s;
+   string       out;
+
+   initial begin
+      b8 = 8'h5a;
+      q41 = 41'h1_2345_6789;
+      w100 = 100'h1_2345_6789_abcd_ef01_2345;
+      i = -42;
+      s = "str";
+
+      $sformat(out, "b8=%x %0d %b", b8, b8, b8);
+      `checks(out, "b8=5a 90 01011010");
+      out = $sformatf("%0x|%0d|%5d|%-5d|", q41, i, i, b8);
+      `checks(out, "123456789|-42|  -42|90   |");
+      out = $sformatf("%d|%d", i, b8);
+      `checks(out, "        -42| 90");
+      out = $sformatf("%x %0d", w100, w100);
+      `checks(out, "0000123456789abcdef012345 1375488932539311398658885");
+      out = $sformatf("%s|%5s|", s, s);
+      `checks(out, "str|  str|");
+      out = $sformatf("100%% done %c", 8'h41);
+      `checks(out, "100% done A");
+
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+
+endmodule
@@ -0,0 +1,37 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2020 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   int cyc = 0;
+   bit [69:0] wide = 70'h3f_12345678_9abcdef0;
+
+   import "DPI-C" /*verilator dpi_async*/ function void dpii_log_int(input int cyc,
+                                                                     input bit [69:0] w);
+   import "DPI-C" /*verilator dpi_async*/ function void dpii_log_str(input string s);
+   import "DPI-C" /*verilator dpi_async*/ task dpii_log_task(input longint v);
+   // Synchronous; flushes the queue then checks what was logged
+   import "DPI-C" function int dpii_check(input int ncalls);
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      wide <= {wide[68:0], wide[69]};
+      dpii_log_int(cyc, wide);
+      dpii_log_str($sformatf("cyc%0d", cyc));
+      dpii_log_task(64'(cyc) << 32);
+      if (cyc == 50) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+   // With --threads, calls of this eval are only queued once it completes
+   final if (dpii_check(3 * 51) != 0) $stop;
+endmodule
@@ -0,0 +1,21 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2020 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/);
+
+   int i;
+   int arr[3];
+
+   import "DPI-C" /*verilator dpi_async*/ function int dpii_ret(input int a);
+   import "DPI-C" /*verilator dpi_async*/ function void dpii_out(output int o);
+   import "DPI-C" /*verilator dpi_async*/ function void dpii_open(input int a[]);
+
+   initial begin
+      i = dpii_ret(1);
+      dpii_out(i);
+      dpii_open(arr);
+   end
+endmodule
@@ -0,0 +1,64 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2020 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+//
+//*************************************************************************
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include "svdpi.h"
+#include "verilated_dpi.h"
+
+#include "Vt_dpi_async__Dpi.h"
+
+//======================================================================
+
+// Only touched by the async worker until dpii_check has flushed it
+static int s_ncalls = 0;
+static int s_failure = 0;
+
+#define CHECK_RESULT_HEX(got, exp) \
+    do { \
+        if ((got) != (exp)) { \
+            std::cout << std::dec << "%Error: " << __FILE__ << ":" << __LINE__ << std::hex \
+                      << ": GOT=" << (got) << "   EXP=" << (exp) << std::endl; \
+            s_failure = __LINE__; \
+        } \
+    } while (0)
+
+//======================================================================
+
+void dpii_log_int(int cyc, const svBitVecVal* w) {
+    // Calls made in the same eval thread must arrive in posting order
+    CHECK_RESULT_HEX(s_ncalls, cyc * 3);
+    // The 70-bit vector is rotated left once per cycle
+    static svBitVecVal exp[3] = {0x9abcdef0, 0x12345678, 0x3f};
+    for (int i = 0; i < 3; ++i) CHECK_RESULT_HEX(w[i], exp[i]);
+    const svBitVecVal top = (exp[2] >> 5) & 1;
+    exp[2] = ((exp[2] << 1) | (exp[1] >> 31)) & 0x3f;
+    exp[1] = (exp[1] << 1) | (exp[0] >> 31);
+    exp[0] = (exp[0] << 1) | top;
+    ++s_ncalls;
+}
+
+void dpii_log_str(const char* s) {
+    // The string must outlive the wrapper that posted it
+    CHECK_RESULT_HEX(std::string(s), "cyc" + std::to_string(s_ncalls / 3));
+    ++s_ncalls;
+}
+
+int dpii_log_task(long long v) {
+    CHECK_RESULT_HEX(v, static_cast<long long>(s_ncalls / 3) << 32);
+    ++s_ncalls;
+    return 0;
+}
+
+int dpii_check(int ncalls) {
+    VerilatedDpiAsync::flush();
+    CHECK_RESULT_HEX(s_ncalls, ncalls);
+    return s_failure;
+}
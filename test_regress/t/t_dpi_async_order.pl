@@ -0,0 +1,32 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vltmt => 1);
+
+compile(
+    v_flags2 => ["t/t_dpi_async_order_c.cpp"],
+    verilator_flags2 => ["-Wall -Wno-DECLFILENAME --threads 4",
+                         $Self->wno_unopthreads_for_few_cores()],
+    );
+
+# Calls posted by different mtasks must be made in the same order every run
+foreach my $run (1 .. 3) {
+    execute(
+        logfile => "$Self->{obj_dir}/run${run}.log",
+        check_finished => 1,
+        );
+}
+
+file_grep("$Self->{obj_dir}/run1.log", qr/Order: [0-7]{328}\n/);
+files_identical("$Self->{obj_dir}/run2.log", "$Self->{obj_dir}/run1.log");
+files_identical("$Self->{obj_dir}/run3.log", "$Self->{obj_dir}/run1.log");
+
+ok(1);
+1;
@@ -0,0 +1,38 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2020 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   int cyc = 0;
+
+   import "DPI-C" /*verilator dpi_async*/ function void dpii_push(input int id, input int cyc,
+                                                                  input int v);
+   // Synchronous; flushes the queue then checks what was pushed
+   import "DPI-C" function int dpii_check(input int ncalls);
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc == 40) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+   // Independent blocks, so with --threads the pushes come from several mtasks
+   for (genvar g = 0; g < 8; ++g) begin : blk
+      int acc = g;
+      always @(posedge clk) begin
+         acc <= acc * 1103515245 + 12345;
+         dpii_push(g, cyc, acc);
+      end
+   end
+
+   final if (dpii_check(8 * 41) != 0) $stop;
+endmodule
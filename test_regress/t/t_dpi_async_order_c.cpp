@@ -0,0 +1,55 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2020 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+//
+//*************************************************************************
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include "svdpi.h"
+#include "verilated_dpi.h"
+
+#include "Vt_dpi_async_order__Dpi.h"
+
+//======================================================================
+
+// Only touched by the async worker until dpii_check has flushed it
+static int s_ncalls = 0;
+static int s_failure = 0;
+static int s_lastCyc = 0;
+static int s_acc[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+static std::string s_order;
+
+#define CHECK_RESULT_HEX(got, exp) \
+    do { \
+        if ((got) != (exp)) { \
+            std::cout << std::dec << "%Error: " << __FILE__ << ":" << __LINE__ << std::hex \
+                      << ": GOT=" << (got) << "   EXP=" << (exp) << std::endl; \
+            s_failure = __LINE__; \
+        } \
+    } while (0)
+
+//======================================================================
+
+void dpii_push(int id, int cyc, int v) {
+    // Calls of one eval all come before calls of the next
+    if (cyc < s_lastCyc) CHECK_RESULT_HEX(cyc, s_lastCyc);
+    s_lastCyc = cyc;
+    // Calls of one block come in posting order
+    CHECK_RESULT_HEX(v, s_acc[id]);
+    s_acc[id] = static_cast<int>(static_cast<unsigned>(s_acc[id]) * 1103515245U + 12345U);
+    s_order += std::to_string(id);
+    ++s_ncalls;
+}
+
+int dpii_check(int ncalls) {
+    VerilatedDpiAsync::flush();
+    CHECK_RESULT_HEX(s_ncalls, ncalls);
+    // Compared between runs by the test driver
+    printf("Order: %s\n", s_order.c_str());
+    return s_failure;
+}
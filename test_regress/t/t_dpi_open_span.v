@@ -0,0 +1,47 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2020 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/);
+
+   int i_int [0:1023];
+   int o_int [0:1023];
+   longint i_long [7:0];
+   longint o_long [7:0];
+   bit [69:0] i_wide [3:-3];
+   bit [69:0] o_wide [3:-3];
+   logic [7:0] i_byte [1:0] [0:4];
+   logic [7:0] o_byte [1:0] [0:4];
+
+   import "DPI-C" function void dpii_span_int(input int i [], output int o []);
+   import "DPI-C" function void dpii_span_long(input longint i [], output longint o []);
+   import "DPI-C" function void dpii_span_wide(input bit [69:0] i [], output bit [69:0] o []);
+   import "DPI-C" function void dpii_span_byte(input logic [7:0] i [] [],
+                                               output logic [7:0] o [] []);
+   import "DPI-C" function int dpii_failure();
+
+   initial begin
+      foreach (i_int[a]) i_int[a] = a * 3;
+      foreach (i_long[a]) i_long[a] = {32'(a), 32'hf0000000};
+      foreach (i_wide[a]) i_wide[a] = {6'(a), 32'(a * 5), 32'hdeadbeef};
+      foreach (i_byte[a, b]) i_byte[a][b] = 8'(a * 16 + b);
+
+      dpii_span_int(i_int, o_int);
+      foreach (o_int[a]) if (o_int[a] !== a * 3 + 1) $stop;
+      dpii_span_long(i_long, o_long);
+      foreach (o_long[a]) if (o_long[a] !== {32'(a), 32'hf0000001}) $stop;
+      dpii_span_wide(i_wide, o_wide);
+      foreach (o_wide[a]) if (o_wide[a] !== {6'(a), 32'(a * 5), 32'hdeadbef0}) $stop;
+      dpii_span_byte(i_byte, o_byte);
+      foreach (o_byte[a, b]) if (o_byte[a][b] !== 8'(a * 16 + b + 1)) $stop;
+
+      if (dpii_failure() != 0) begin
+         $write("%%Error: Failure in DPI tests\n");
+         $stop;
+      end
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
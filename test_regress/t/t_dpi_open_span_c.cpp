@@ -0,0 +1,86 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2020 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+//
+//*************************************************************************
+
+#include <cstdio>
+#include <iostream>
+#include "svdpi.h"
+#include "verilated_dpi.h"
+
+#include "Vt_dpi_open_span__Dpi.h"
+
+//======================================================================
+
+int failure = 0;
+int dpii_failure() { return failure; }
+
+#define CHECK_RESULT_HEX(got, exp) \
+    do { \
+        if ((got) != (exp)) { \
+            std::cout << std::dec << "%Error: " << __FILE__ << ":" << __LINE__ << std::hex \
+                      << ": GOT=" << (got) << "   EXP=" << (exp) << std::endl; \
+            failure = __LINE__; \
+        } \
+    } while (0)
+
+//======================================================================
+
+void dpii_span_int(const svOpenArrayHandle i, const svOpenArrayHandle o) {
+    static svBitVecVal buf[1024];
+    const int size = svSize(i, 1);
+    CHECK_RESULT_HEX(size, 1024);
+    // Copy out in two pieces, the second clipped at the end of the array
+    CHECK_RESULT_HEX(vl_sv_get_bit_arr_elems(buf, i, svLow(i, 1), 1000), 1000);
+    CHECK_RESULT_HEX(vl_sv_get_bit_arr_elems(buf + 1000, i, svLow(i, 1) + 1000, 1000), 24);
+    for (int a = 0; a < size; ++a) {
+        svBitVecVal elem;
+        svGetBitArrElem1VecVal(&elem, i, a);
+        CHECK_RESULT_HEX(buf[a], elem);
+        buf[a] += 1;
+    }
+    CHECK_RESULT_HEX(vl_sv_put_bit_arr_elems(o, buf, svLow(o, 1), size), size);
+    // Direct pointer into simulator storage
+    int count = 0;
+    int bytes = 0;
+    const int* datap = static_cast<const int*>(vl_sv_arr_span(i, 10, &count, &bytes));
+    CHECK_RESULT_HEX(count, 1014);
+    CHECK_RESULT_HEX(bytes, 4);
+    if (datap) CHECK_RESULT_HEX(datap[5], 45);
+}
+
+void dpii_span_long(const svOpenArrayHandle i, const svOpenArrayHandle o) {
+    svLogicVecVal buf[16];
+    CHECK_RESULT_HEX(vl_sv_get_logic_arr_elems(buf, i, 0, 8), 8);
+    for (int a = 0; a < 8; ++a) {
+        CHECK_RESULT_HEX(buf[2 * a].aval, 0xf0000000U);
+        CHECK_RESULT_HEX(buf[2 * a + 1].aval, static_cast<unsigned>(a));
+        CHECK_RESULT_HEX(buf[2 * a + 1].bval, 0U);
+        buf[2 * a].aval += 1;
+    }
+    CHECK_RESULT_HEX(vl_sv_put_logic_arr_elems(o, buf, 0, 8), 8);
+}
+
+void dpii_span_wide(const svOpenArrayHandle i, const svOpenArrayHandle o) {
+    svBitVecVal buf[7 * SV_PACKED_DATA_NELEMS(70)];
+    CHECK_RESULT_HEX(vl_sv_get_bit_arr_elems(buf, i, -3, 7), 7);
+    for (int a = -3; a <= 3; ++a) {
+        svBitVecVal* elemp = buf + (a + 3) * SV_PACKED_DATA_NELEMS(70);
+        CHECK_RESULT_HEX(elemp[1], static_cast<unsigned>(a * 5));
+        elemp[0] += 1;
+    }
+    CHECK_RESULT_HEX(vl_sv_put_bit_arr_elems(o, buf, -3, 7), 7);
+}
+
+void dpii_span_byte(const svOpenArrayHandle i, const svOpenArrayHandle o) {
+    // Each first dimension index covers all of the second dimension
+    svLogicVecVal buf[10];
+    CHECK_RESULT_HEX(vl_sv_get_logic_arr_elems(buf, i, 0, 2), 2);
+    CHECK_RESULT_HEX(buf[6].aval, 0x11U);
+    for (int a = 0; a < 10; ++a) buf[a].aval += 1;
+    CHECK_RESULT_HEX(vl_sv_put_logic_arr_elems(o, buf, 0, 2), 2);
+}
@@ -0,0 +1,26 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+# Like t_dpi_threads_collide, relies on the calls in different groups
+# really running at the same time
+$Self->skip_if_too_few_cores();
+
+scenarios(vltmt => 1);
+
+compile(
+    v_flags2 => ["t/t_dpi_threads_group_c.cpp t/t_dpi_threads_group.vlt --no-threads-coarsen"],
+    );
+
+execute(
+    check_finished => 1,
+    );
+
+ok(1);
+1;
@@ -0,0 +1,39 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2020 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+
+   // Two models, each only safe to call from one thread at a time
+   import "DPI-C" /*verilator dpi_group mem_a*/ function void dpii_mem_a(input int id);
+   import "DPI-C" function void dpii_mem_b(input int id);  // Group from .vlt file
+   import "DPI-C" function int dpii_failure();
+   import "DPI-C" function int dpii_overlaps();
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc == 2) begin
+         $write("* failure = %0d overlaps = %0d\n", dpii_failure(), dpii_overlaps());
+         // Same group calls must never overlap, but different groups should
+         if (dpii_failure() != 0) $stop;
+         if (dpii_overlaps() == 0) $stop;
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+   // Independent always blocks, so only the dpi_group hazards order them
+   always @(posedge clk) if (cyc < 2) dpii_mem_a(0);
+   always @(posedge clk) if (cyc < 2) dpii_mem_a(1);
+   always @(posedge clk) if (cyc < 2) dpii_mem_b(0);
+   always @(posedge clk) if (cyc < 2) dpii_mem_b(1);
+
+endmodule
@@ -0,0 +1,43 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2020 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+//
+//*************************************************************************
+
+#include <atomic>
+#include <cstdio>
+#include <iostream>
+#include <unistd.h>
+#include "svdpi.h"
+
+#include "Vt_dpi_threads_group__Dpi.h"
+
+//======================================================================
+
+static std::atomic<bool> s_runningA{false};  // A mem_a call is running
+static std::atomic<bool> s_runningB{false};  // A mem_b call is running
+static std::atomic<int> s_active{0};  // Calls running, any group
+static std::atomic<int> s_failure{0};
+static std::atomic<int> s_overlaps{0};  // Calls that started while another ran
+
+static void memCall(std::atomic<bool>& running, const char* group, int id) {
+    if (running.exchange(true)) {
+        s_failure = 1;
+        std::cerr << "t_dpi_threads_group_c.cpp " << group << "(" << id
+                  << ") saw threads collide.\n";
+    }
+    if (s_active++) ++s_overlaps;
+    // Long enough that calls in other groups should start meanwhile; see
+    // t_dpi_threads_c.cpp
+    usleep(500 * 1000);
+    --s_active;
+    running = false;
+}
+
+void dpii_mem_a(int id) { memCall(s_runningA, "dpii_mem_a", id); }
+void dpii_mem_b(int id) { memCall(s_runningB, "dpii_mem_b", id); }
+int dpii_failure() { return s_failure; }
+int dpii_overlaps() { return s_overlaps; }
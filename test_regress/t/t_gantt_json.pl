@@ -0,0 +1,72 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+use IO::File;
+use JSON::PP;
+
+# Test for +verilator+prof+threads+json and +verilator+prof+threads+counters
+scenarios(vltmt => 1);
+
+top_filename("t/t_gen_alw.v");
+
+compile(
+    v_flags2 => ["--prof-threads --threads 2"]
+    );
+
+execute(
+    all_run_flags => ["+verilator+prof+threads+start+2",
+                      " +verilator+prof+threads+window+2",
+                      " +verilator+prof+threads+counters",
+                      " +verilator+prof+threads+file+$Self->{obj_dir}/profile_threads.dat",
+                      " +verilator+prof+threads+json+$Self->{obj_dir}/profile_threads.json",
+                      ],
+    check_finished => 1,
+    );
+
+# Counters may read zero if perf_event is not permitted, but must be present
+file_grep("$Self->{obj_dir}/profile_threads.dat",
+          qr/ wait \d+ spin \d+ yield \d+ cycles \d+ instructions \d+ llc_misses \d+/);
+file_grep("$Self->{obj_dir}/profile_threads.dat",
+          qr/VLPROF thread 2 busy \d+ wait \d+ spin \d+ yield \d+ idle \d+/);
+
+{
+    my $text = file_contents("$Self->{obj_dir}/profile_threads.json");
+    my $json = eval { decode_json($text) };
+    $json or error("profile_threads.json is not valid JSON: $@");
+    my $mtasks = 0;
+    my %tids;
+    foreach my $event (@{$json->{traceEvents} || []}) {
+        $tids{$event->{tid}} = 1;
+        if (($event->{cat} || "") eq "wait") {
+            (exists $event->{args}{spin} && exists $event->{args}{yield})
+                or error("wait event without spin and yield for mtask $event->{args}{mtask}");
+        }
+        next if ($event->{cat} || "") ne "mtask";
+        $mtasks++;
+        ($event->{ph} eq "X" && $event->{dur} >= 0 && exists $event->{args}{cycles})
+            or error("bad mtask event for $event->{name}");
+    }
+    $mtasks > 0 or error("no mtask events in timeline");
+    scalar(keys %tids) == 2 or error("wrong number of threads in timeline");
+}
+
+run(cmd => ["$ENV{VERILATOR_ROOT}/bin/verilator_gantt",
+            "$Self->{obj_dir}/profile_threads.dat",
+            "--no-vcd",
+            "| tee $Self->{obj_dir}/gantt.log"],
+    verilator_run => 1,
+    );
+
+file_grep("$Self->{obj_dir}/gantt.log",
+          qr/thread 2 +busy +[0-9.]+% +spin +[0-9.]+% +yield +[0-9.]+%/);
+file_grep("$Self->{obj_dir}/gantt.log", qr/Longest mtasks, with hardware counters/);
+
+ok(1);
+1;
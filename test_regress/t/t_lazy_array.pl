@@ -0,0 +1,30 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt_all => 1);
+
+$Self->{verilated_randReset} = 2;
+
+compile(
+    verilator_flags2 => ["--x-initial unique --lazy-array-size 65536"],
+    );
+
+execute(
+    check_finished => 1,
+    );
+
+file_grep("$Self->{obj_dir}/$Self->{VM_PREFIX}.h", qr/VlPagedUnpacked<IData\S*, 16777216> big;/);
+file_grep("$Self->{obj_dir}/$Self->{VM_PREFIX}.h", qr/VlPagedUnpacked<VlWide<3>, 4096> wide;/);
+file_grep("$Self->{obj_dir}/$Self->{VM_PREFIX}.h", qr/VlPagedUnpacked<CData\S*, 65536> sized;/);
+file_grep_not("$Self->{obj_dir}/$Self->{VM_PREFIX}.h", qr/VlPagedUnpacked<[^;]*> (small|pub);/);
+file_grep("$Self->{obj_dir}/$Self->{VM_PREFIX}__Slow.cpp", qr/big\.reset\(true, 32, name\(\), "big"\);/);
+
+ok(1);
+1;
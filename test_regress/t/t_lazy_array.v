@@ -0,0 +1,56 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2020 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   // verilator lint_off UNDRIVEN
+   reg [31:0] big [0:(1<<24)-1] /*verilator lazy_array*/;
+   reg [69:0] wide [0:4095] /*verilator lazy_array*/;
+   reg [7:0]  sized [0:65535];  // Lazy from --lazy-array-size
+   reg [7:0]  small [0:15];  // Below --lazy-array-size
+   reg [7:0]  pub [0:65535] /*verilator public*/;  // Public, so never lazy
+   // verilator lint_on UNDRIVEN
+
+   integer    cyc = 0;
+   integer    i;
+   reg [31:0] untouched;
+   reg [69:0] untouched_w;
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc == 0) begin
+         // Reads of never written elements must be stable
+         untouched = big[77];
+         untouched_w = wide[1];
+         big[0] <= 32'h12345678;
+         big[(1<<24)-1] <= 32'hfeedface;
+         big[1<<20] <= 32'h1;
+         wide[4095] <= {6'h2a, 64'h01234567_89abcdef};
+         for (i = 0; i < 65536; i = i + 4096) sized[i] <= i[19:12];
+         small[3] <= 8'h33;
+         pub[5] <= 8'h55;
+      end
+      else if (cyc == 1) begin
+         if (big[0] !== 32'h12345678) $stop;
+         if (big[(1<<24)-1] !== 32'hfeedface) $stop;
+         if (big[1<<20] !== 32'h1) $stop;
+         if (big[77] !== untouched) $stop;
+         if (wide[4095] !== {6'h2a, 64'h01234567_89abcdef}) $stop;
+         if (wide[1] !== untouched_w) $stop;
+         for (i = 0; i < 65536; i = i + 4096) begin
+            if (sized[i] !== i[19:12]) $stop;
+         end
+         if (small[3] !== 8'h33) $stop;
+         if (pub[5] !== 8'h55) $stop;
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
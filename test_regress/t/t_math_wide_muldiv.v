@@ -0,0 +1,61 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2020 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+
+   input clk;
+
+   integer cyc = 0;
+   reg [63:0] crc;
+
+   // RSA-sized operands, with a divisor of varying length
+   wire [2047:0] a = {32{crc ^ {cyc, ~cyc}}};
+   wire [2047:0] b = {a[1023:0], ~a[1023:0]} >> (crc[5:0] * 7);
+   wire [2047:0] q = a / b;
+   wire [2047:0] r = a % b;
+   wire [2047:0] prod = q * b;
+   wire [2047:0] cube = a ** 3;
+   wire signed [2047:0] sa = $signed(a);
+   wire signed [2047:0] sb = $signed(b);
+   wire signed [2047:0] sprod = sa * sb;
+   // Products of 95 words or more, up to VL_MULS_MAX_WORDS
+   wire [3039:0] wa = {a[991:0], a};
+   wire [3039:0] wb = {b[991:0], b};
+   wire [3039:0] wprod = wa * wb;
+   wire [4095:0] xprod = {a, a} * {b, b};
+
+   always @ (posedge clk) begin
+`ifdef TEST_VERBOSE
+      $write("[%0t] cyc==%0d crc=%x q=%x\n", $time, cyc, crc, q[63:0]);
+`endif
+      cyc <= cyc + 1;
+      crc <= {crc[62:0], crc[63] ^ crc[2] ^ crc[0]};
+      if (cyc == 0) begin
+         crc <= 64'h5aef0c8d_d70a4497;
+      end
+      else begin
+         if (prod + r != a) $stop;
+         if (r >= b) $stop;
+         if (cube != a * a * a) $stop;
+         if (sprod != (a * b)) $stop;  // Low bits match unsigned product
+         if ((a * 2048'd1) != a) $stop;
+         if ((a * b) != (b * a)) $stop;
+         if (wprod[2047:0] != a * b) $stop;
+         if (wprod != wb * wa) $stop;
+         if (wa * (wb + 3040'd1) != wprod + wa) $stop;
+         if (xprod[2047:0] != a * b) $stop;
+         if (xprod != {b, b} * {a, a}) $stop;
+         if (cyc == 99) begin
+            $write("*-* All Finished *-*\n");
+            $finish;
+         end
+      end
+   end
+
+endmodule
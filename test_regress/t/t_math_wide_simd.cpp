@@ -0,0 +1,153 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// Checks the vectorized wide-operation kernels against the portable word loops.
+// Set VL_WIDE_BENCH_ITERS to also time them against each other.
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2020 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+#include <verilated.h>
+#include VM_PREFIX_INCLUDE
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+double sc_time_stamp() { return 0; }
+
+static int errors = 0;
+
+#define CHECK(got, exp) \
+    do { \
+        if ((got) != (exp)) { \
+            printf("%%Error: %s:%d: words=%d got=%d exp=%d\n", __FILE__, __LINE__, words, \
+                   static_cast<int>(got), static_cast<int>(exp)); \
+            ++errors; \
+        } \
+    } while (false)
+
+#ifdef VL_HAVE_AVX2
+// Portable references, as in verilated.h without VL_HAVE_AVX2
+static void refAnd(int words, WDataOutP owp, WDataInP lwp, WDataInP rwp) {
+    for (int i = 0; i < words; ++i) owp[i] = lwp[i] & rwp[i];
+}
+static void refNot(int words, WDataOutP owp, WDataInP lwp) {
+    for (int i = 0; i < words; ++i) owp[i] = ~lwp[i];
+}
+static EData refRedOr(int words, WDataInP lwp) {
+    EData r = 0;
+    for (int i = 0; i < words; ++i) r |= lwp[i];
+    return r;
+}
+static EData refRedAnd(int words, WDataInP lwp) {
+    EData r = ~VL_EUL(0);
+    for (int i = 0; i < words; ++i) r &= lwp[i];
+    return r;
+}
+static EData refRedXor(int words, WDataInP lwp) {
+    EData r = 0;
+    for (int i = 0; i < words; ++i) r ^= lwp[i];
+    return r;
+}
+static int refCmp(int words, WDataInP lwp, WDataInP rwp) {
+    for (int i = words - 1; i >= 0; --i) {
+        if (lwp[i] > rwp[i]) return 1;
+        if (lwp[i] < rwp[i]) return -1;
+    }
+    return 0;
+}
+
+static EData randWord() {
+    return static_cast<EData>(rand()) ^ (static_cast<EData>(rand()) << 16);
+}
+
+static void checkWords(int words) {
+    WData l[256];
+    WData r[256];
+    WData o1[256];
+    WData o2[256];
+    for (int iter = 0; iter < 200; ++iter) {
+        for (int i = 0; i < words; ++i) l[i] = r[i] = randWord();
+        // Mostly-equal operands exercise the compare scan
+        if (iter & 1) r[rand() % words] ^= VL_EUL(1) << (rand() % VL_EDATASIZE);
+        if (iter & 2) {
+            for (int i = 0; i < words; ++i) l[i] = ~VL_EUL(0);
+        }
+        refAnd(words, o1, l, r);
+        _vl_simd_and_w(words, o2, l, r);
+        for (int i = 0; i < words; ++i) CHECK(o2[i], o1[i]);
+        refNot(words, o1, l);
+        _vl_simd_not_w(words, o2, l);
+        for (int i = 0; i < words; ++i) CHECK(o2[i], o1[i]);
+        _vl_simd_copy_w(words, o2, r);
+        for (int i = 0; i < words; ++i) CHECK(o2[i], r[i]);
+        CHECK(_vl_simd_redor_w(words, l), refRedOr(words, l));
+        CHECK(_vl_simd_redand_w(words, l), refRedAnd(words, l));
+        CHECK(VL_REDAND_IW(1, words * VL_EDATASIZE, l), refRedAnd(words, l) == ~VL_EUL(0));
+        CHECK(_vl_simd_redxor_w(words, l), refRedXor(words, l));
+        CHECK(_vl_simd_neq_w(words, l, r) != 0, refCmp(words, l, r) != 0);
+        CHECK(_vl_simd_cmp_w(words, l, r), refCmp(words, l, r));
+        CHECK(_vl_simd_cmp_w(words, r, l), refCmp(words, r, l));
+    }
+}
+
+template <typename T_Func> static double timeIt(int iters, T_Func func) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iters; ++i) func();
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / iters;
+}
+
+static void benchWords(int words, int iters) {
+    WData l[256];
+    WData r[256];
+    WData o[256];
+    for (int i = 0; i < words; ++i) l[i] = r[i] = randWord();
+    volatile EData sink = 0;
+    printf("  %4d bits:  and %6.1f/%6.1f  redxor %6.1f/%6.1f  cmp %6.1f/%6.1f ns\n",
+           words * VL_EDATASIZE,  //
+           timeIt(iters, [&]() { refAnd(words, o, l, r); sink = sink + o[0]; }),
+           timeIt(iters, [&]() { _vl_simd_and_w(words, o, l, r); sink = sink + o[0]; }),
+           timeIt(iters, [&]() { sink = sink + refRedXor(words, l); }),
+           timeIt(iters, [&]() { sink = sink + _vl_simd_redxor_w(words, l); }),
+           timeIt(iters, [&]() { sink = sink + refCmp(words, l, r); }),
+           timeIt(iters, [&]() { sink = sink + _vl_simd_cmp_w(words, l, r); }));
+}
+#endif
+
+int main(int argc, char** argv, char** env) {
+    Verilated::commandArgs(argc, argv);
+
+#ifdef VL_HAVE_AVX2
+#ifdef VL_HAVE_AVX512
+    printf("Wide kernels: AVX-512\n");
+#else
+    printf("Wide kernels: AVX2\n");
+#endif
+    const int checkWordsList[] = {8, 9, 15, 16, 17, 32, 33, 64, 255};
+    for (const int w : checkWordsList) checkWords(w);
+    // Timings vary between hosts, so are only printed on request
+    if (const char* itersp = getenv("VL_WIDE_BENCH_ITERS")) {
+        const int iters = atoi(itersp);
+        printf("Timings, portable/vector:\n");
+        const int benchWordsList[] = {8, 16, 32, 128};
+        for (const int w : benchWordsList) benchWords(w, iters);
+    }
+#else
+    printf("Wide kernels: portable only\n");
+#endif
+    if (errors) vl_fatal(__FILE__, __LINE__, "main", "Vectorized kernels mismatch");
+
+    VM_PREFIX* topp = new VM_PREFIX;
+    topp->clk = 0;
+    while (!Verilated::gotFinish()) {
+        topp->clk = !topp->clk;
+        topp->eval();
+    }
+    topp->final();
+    VL_DO_DANGLING(delete topp, topp);
+    return 0;
+}
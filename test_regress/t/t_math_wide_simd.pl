@@ -0,0 +1,30 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt_all => 1);
+
+# Build the vectorized kernels when the host can run them
+my $cpuinfo = (-r "/proc/cpuinfo") ? file_contents("/proc/cpuinfo") : "";
+my $cflags = ($cpuinfo =~ /\bavx512f\b/ ? "-mavx512f -mavx2"
+              : $cpuinfo =~ /\bavx2\b/ ? "-mavx2" : "");
+
+compile(
+    make_top_shell => 0,
+    make_main => 0,
+    verilator_flags2 => ["--exe", "$Self->{t_dir}/$Self->{name}.cpp",
+                         ($cflags ? ("-CFLAGS", "'$cflags'") : ())],
+    );
+
+execute(
+    check_finished => 1,
+    );
+
+ok(1);
+1;
@@ -0,0 +1,48 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2020 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+
+   input clk;
+
+   integer cyc = 0;
+   reg [63:0] crc;
+
+   // 512 and 288 bits, to cover whole and partial vector tails
+   wire [511:0] a = {8{crc ^ {cyc, cyc}}};
+   wire [511:0] b = {a[255:0], ~a[511:256]};
+   wire [287:0] c = {crc[31:0], {4{crc}}};
+   wire [287:0] d = {c[287:32], c[31:0] + 32'd1};
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      crc <= {crc[62:0], crc[63] ^ crc[2] ^ crc[0]};
+      if (cyc == 0) begin
+         crc <= 64'h5aef0c8d_d70a4497;
+      end
+      else begin
+         if (((a & b) | (a & ~b)) != a) $stop;
+         if (((a ^ b) ^ a) != b) $stop;
+         if (~(a | b) != (~a & ~b)) $stop;
+         if (!(|a)) $stop;
+         if (|(a ^ a)) $stop;
+         if (^a != 1'b0) $stop;  // Eight identical copies
+         if (&(a | ~a) != 1'b1) $stop;
+         if (&{c, ~c[0]}) $stop;
+         if (c == d) $stop;
+         if (!(c < d) && c[31:0] != 32'hffffffff) $stop;
+         if ((cyc[0] ? a : b) != (cyc[0] ? b ^ (a ^ b) : a ^ (a ^ b))) $stop;
+         if (cyc == 99) begin
+            $write("*-* All Finished *-*\n");
+            $finish;
+         end
+      end
+   end
+
+endmodule
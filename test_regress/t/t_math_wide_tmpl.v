@@ -0,0 +1,60 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2020 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+
+   input clk;
+
+   integer cyc = 0;
+   reg [63:0] crc;
+
+   // Operands wide enough to use the VL_*_W<words> templates
+   wire [159:0] a = {crc[31:0], ~crc, crc};
+   wire [159:0] b = {crc[47:16], crc ^ 64'h5a5a_a5a5_0f0f_f0f0, ~crc};
+   wire [159:0] c = {~crc[31:0], crc, crc ^ 64'h1234_5678_9abc_def0};
+   wire [7:0]   s = crc[7:0];
+
+   wire [159:0] sum = a + b;
+   wire [159:0] diff = sum - b;
+   wire [159:0] prod1 = a * (b + c);
+   wire [159:0] prod2 = (a * b) + (a * c);
+   wire [159:0] prod3 = b * a;
+   wire [159:0] neg = -a;
+   wire [159:0] shl = a << s;
+   wire [159:0] shr = shl >> s;
+   wire [159:0] mask = ~(160'h0) >> s;
+
+   always @ (posedge clk) begin
+`ifdef TEST_VERBOSE
+      $write("[%0t] cyc==%0d crc=%x prod=%x\n", $time, cyc, crc, prod1);
+`endif
+      cyc <= cyc + 1;
+      crc <= {crc[62:0], crc[63] ^ crc[2] ^ crc[0]};
+      if (cyc == 0) begin
+         crc <= 64'h5aef0c8d_d70a4497;
+      end
+      else begin
+         if (diff != a) $stop;
+         if (prod1 != prod2) $stop;
+         if ((a * b) != prod3) $stop;
+         if ((neg + a) != 160'h0) $stop;
+         if (~(~a) != a) $stop;
+         if (((a ^ b) ^ b) != a) $stop;
+         if (((a & b) | (a & ~b)) != a) $stop;
+         if (shr != (a & mask)) $stop;
+         if (|(a ^ a)) $stop;
+         if (^(a ^ b) != (^a ^ ^b)) $stop;
+         if (cyc == 99) begin
+            $write("*-* All Finished *-*\n");
+            $finish;
+         end
+      end
+   end
+
+endmodule
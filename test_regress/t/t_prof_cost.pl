@@ -0,0 +1,33 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt_all => 1);
+
+compile(
+    v_flags2 => ["--prof-cost"],
+    );
+
+execute(
+    all_run_flags => ["+verilator+prof+cost+file+$Self->{obj_dir}/profile_cost.dat"],
+    check_finished => 1,
+    );
+
+# Both instances share a module, but are accounted separately
+file_grep("$Self->{obj_dir}/profile_cost.dat", qr/^VLPROFCOST ticks \d+$/m);
+file_grep("$Self->{obj_dir}/profile_cost.dat", qr/^VLPROFCOST module \d+ \d+ [0-9.]+ sub$/m);
+foreach my $inst ("TOP.t.sub1", "TOP.t.sub2") {
+    file_grep("$Self->{obj_dir}/profile_cost.dat",
+              qr/^VLPROFCOST instance [1-9]\d* \d+ [0-9.]+ \Q$inst\E sub$/m);
+    file_grep("$Self->{obj_dir}/profile_cost.dat",
+              qr/^VLPROFCOST func [1-9]\d* \d+ \d+ [0-9.]+ \Q$inst\E sub _sequent\w*$/m);
+}
+
+ok(1);
+1;
@@ -0,0 +1,37 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2020 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   wire [31:0] out1;
+   wire [31:0] out2;
+
+   sub #(.STEP(1)) sub1 (.clk(clk), .out(out1));
+   sub #(.STEP(1)) sub2 (.clk(clk), .out(out2));
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc == 99) begin
+         if (out1 !== out2) $stop;
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
+
+module sub
+  #(parameter STEP = 1)
+   (input clk,
+    output reg [31:0] out);
+   /*verilator no_inline_module*/
+   initial out = 0;
+   always @ (posedge clk) out <= out * 3 + STEP;
+endmodule
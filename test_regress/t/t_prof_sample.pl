@@ -0,0 +1,45 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt_all => 1);
+
+compile(
+    v_flags2 => ["--prof-sample"],
+    );
+
+# Functions are tabled for the sampler, and carry no instrumentation
+{
+    my $text = "";
+    foreach my $file (glob("$Self->{obj_dir}/$Self->{VM_PREFIX}*.cpp")) {
+        $text .= file_contents($file);
+    }
+    $text =~ /\{VlProfSample::funcAddr\(&\w+::_eval\), "_eval", "\w+", "[^"]+", \d+\}/
+        or error("no function table in generated code");
+    $text !~ /VlProfSampleScope|VlProfSample::site/
+        or error("instrumentation in generated code");
+}
+file_grep("$Self->{obj_dir}/$Self->{VM_PREFIX}.h", qr/ _eval\(.*\) VL_ATTR_PROF_SAMPLE;/);
+
+execute(
+    all_run_flags => ["+verilator+prof+sample+rate+2000",
+                      " +verilator+prof+sample+file+$Self->{obj_dir}/profile_sample.dat"],
+    check_finished => 1,
+    );
+
+# The run is long enough to take samples in the model
+file_grep("$Self->{obj_dir}/profile_sample.dat",
+          qr/VLPROFSAMPLE rate 2000 samples [1-9]\d* other \d+\n/);
+file_grep("$Self->{obj_dir}/profile_sample.dat",
+          qr/VLPROFSAMPLE module [1-9]\d* [\d.]+ (TOP|t)\n/);
+file_grep("$Self->{obj_dir}/profile_sample.dat",
+          qr/VLPROFSAMPLE func [1-9]\d* [\d.]+ (TOP|t) \S+ t\/t_prof_sample.v:\d+\n/);
+
+ok(1);
+1;
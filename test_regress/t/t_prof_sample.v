@@ -0,0 +1,39 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2020 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   reg [63:0] crc;
+   reg [63:0] sum = 64'h0;
+
+   integer i;
+
+   // Enough work in the model that it takes many samples
+   always @ (posedge clk) begin
+      for (i = 0; i < 1000; i = i + 1) begin
+         sum = (sum * 64'h9e3779b9_7f4a7c15) ^ (sum >> 7) ^ crc;
+      end
+   end
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      crc <= {crc[62:0], crc[63] ^ crc[2] ^ crc[0]};
+      if (cyc == 0) begin
+         crc <= 64'h5aef0c8d_d70a4497;
+      end
+      else if (cyc == 200000) begin
+         $write("[%0t] sum=%x\n", $time, sum);
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+endmodule
@@ -0,0 +1,73 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2020 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+// Queue storage wraps around and grows out of its inline space
+module t (/*AUTOARG*/);
+
+   int q[$];
+   string s[$];
+   int b[$ : 3];  // Size at most 4
+   int v;
+   int exp;
+
+   initial begin
+      // FIFO whose head moves around the ring
+      exp = 0;
+      for (int i = 0; i < 100; ++i) begin
+         q.push_back(i);
+         if (q.size() > 3) begin
+            v = q.pop_front();
+            if (v != exp) $stop;
+            ++exp;
+         end
+      end
+      if (q.size() != 3) $stop;
+      if (q[0] != 97 || q[2] != 99) $stop;
+
+      // Grow while wrapped, then edit both halves
+      for (int i = 100; i < 140; ++i) q.push_front(i);
+      if (q.size() != 43) $stop;
+      if (q[0] != 139 || q[39] != 100 || q[40] != 97) $stop;
+      q.insert(1, 1000);
+      q.insert(40, 2000);
+      if (q[1] != 1000 || q[40] != 2000 || q[41] != 100) $stop;
+      q.delete(1);
+      q.delete(39);
+      if (q.size() != 43) $stop;
+      if (q[1] != 138 || q[39] != 100) $stop;
+      v = q.pop_back();
+      if (v != 99) $stop;
+      v = q.pop_front();
+      if (v != 139) $stop;
+
+      for (int i = 0; i < 20; ++i) begin
+         s.push_back($sformatf("str%0d", i));
+         if (s.size() > 2) s.pop_front();
+      end
+      if (s.size() != 2) $stop;
+      if (s[0] != "str18" || s[1] != "str19") $stop;
+      s.push_front("first");
+      if (s[0] != "first" || s[2] != "str19") $stop;
+
+      // Bounded queue stays within its bound while wrapping
+      for (int i = 0; i < 10; ++i) begin
+         b.push_back(i);
+         if (b.size() > 2) b.pop_front();
+      end
+      b.push_back(10);
+      b.push_back(11);
+      b.push_back(12);  // Dropped
+      if (b.size() != 4) $stop;
+      if (b[0] != 8 || b[3] != 11) $stop;
+      b.insert(1, 20);  // Drops back element
+      if (b.size() != 4) $stop;
+      if (b[0] != 8 || b[1] != 20 || b[2] != 9 || b[3] != 10) $stop;
+
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+
+endmodule
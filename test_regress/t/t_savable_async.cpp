@@ -0,0 +1,66 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2020 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+#include <verilated.h>
+#include <verilated_save.h>
+#include VM_PREFIX_INCLUDE
+
+#include <memory>
+
+double main_time = 0;
+double sc_time_stamp() { return main_time; }
+
+static const char* const filenamep = VL_STRINGIFY(TEST_OBJ_DIR) "/saved.vltsv";
+
+int main(int argc, char** argv, char** env) {
+    Verilated::commandArgs(argc, argv);
+    const bool restore = Verilated::commandArgsPlusMatch("save_restore=")[0];
+    std::unique_ptr<VM_PREFIX> topp{new VM_PREFIX};
+
+    if (restore) {
+        VL_PRINTF("Restoring model from '%s'\n", filenamep);
+        VerilatedRestore os;
+        os.open(filenamep);
+        os >> main_time;
+        os >> *topp;
+        os.close();
+    } else {
+        topp->clk = false;
+        topp->eval();
+        main_time += 10;
+    }
+
+    VerilatedSaveAsync saver;
+    saver.maxPendingBytes(64 * 1024);  // Exercise writer back-pressure
+    bool saved = false;
+    while (main_time < 5000 && !Verilated::gotFinish()) {
+        topp->clk = !topp->clk;
+        topp->eval();
+        if (!restore && !saved && main_time == 500) {
+            VL_PRINTF("Saving model to '%s'\n", filenamep);
+            saver.open(filenamep);
+            saver << main_time;
+            saver << *topp;
+            saver.close();
+            saved = true;
+        }
+        // Simulation continues while the snapshot is written
+        if (saved && !saver.busy()) {
+            VL_PRINTF("Exiting after save_model\n");
+            break;
+        }
+        main_time += 10;
+    }
+    saver.wait();
+    if (!restore) return 0;
+    if (!Verilated::gotFinish()) {
+        vl_fatal(__FILE__, __LINE__, "main", "%Error: Timeout; never got a $finish");
+    }
+    topp->final();
+    return 0;
+}
@@ -0,0 +1,80 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2020 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+#include <verilated.h>
+#include <verilated_save.h>
+#include VM_PREFIX_INCLUDE
+
+#include <memory>
+#include <string>
+#include <vector>
+
+double main_time = 0;
+double sc_time_stamp() { return main_time; }
+
+static std::string filename(int n) {
+    return std::string(VL_STRINGIFY(TEST_OBJ_DIR) "/saved_") + std::to_string(n) + ".vltsv";
+}
+
+int main(int argc, char** argv, char** env) {
+    Verilated::commandArgs(argc, argv);
+    const bool restore = Verilated::commandArgsPlusMatch("save_restore=")[0];
+    std::unique_ptr<VM_PREFIX> topp{new VM_PREFIX};
+
+    if (restore) {
+        // Full checkpoint then each delta, oldest first
+        const std::vector<std::string> filenames{filename(0), filename(1), filename(2)};
+        VL_PRINTF("Restoring model from '%s' and deltas\n", filenames[0].c_str());
+        VerilatedRestoreDelta os;
+        os.open(filenames);
+        if (!os.isOpen()) vl_fatal(__FILE__, __LINE__, "main", "%Error: Can't open checkpoints");
+        os >> main_time;
+        std::string pad;
+        os >> pad;
+        if (pad.size() != 2000) vl_fatal(__FILE__, __LINE__, "main", "%Error: Bad pad restore");
+        os >> *topp;
+        os.close();
+    } else {
+        topp->clk = false;
+        topp->eval();
+        main_time += 10;
+    }
+
+    VerilatedSaveDelta saver;
+    int checkpoint = 0;
+    while (main_time < 5000 && !Verilated::gotFinish()) {
+        topp->clk = !topp->clk;
+        topp->eval();
+        if (!restore && (main_time == 300 || main_time == 400 || main_time == 500)) {
+            VL_PRINTF("Saving checkpoint to '%s'\n", filename(checkpoint).c_str());
+            saver.open(filename(checkpoint));
+            saver << main_time;
+            // Data changing size, so later pages move unless in its own region
+            std::string pad(checkpoint * 1000, 'p');
+            saver.region();
+            saver << pad;
+            saver.region();
+            saver << *topp;
+            saver.close();
+            if (saver.isDelta() != (checkpoint != 0)) {
+                vl_fatal(__FILE__, __LINE__, "main", "%Error: Unexpected checkpoint kind");
+            }
+            if (++checkpoint == 3) {
+                VL_PRINTF("Exiting after save_model\n");
+                return 0;
+            }
+        }
+        main_time += 10;
+    }
+    if (!restore) return 0;
+    if (!Verilated::gotFinish()) {
+        vl_fatal(__FILE__, __LINE__, "main", "%Error: Timeout; never got a $finish");
+    }
+    topp->final();
+    return 0;
+}
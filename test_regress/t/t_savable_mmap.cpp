@@ -0,0 +1,59 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2020 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+#include <verilated.h>
+#include <verilated_save.h>
+#include VM_PREFIX_INCLUDE
+
+#include <memory>
+
+double main_time = 0;
+double sc_time_stamp() { return main_time; }
+
+static const char* const filenamep = VL_STRINGIFY(TEST_OBJ_DIR) "/saved.vltsv";
+
+int main(int argc, char** argv, char** env) {
+    Verilated::commandArgs(argc, argv);
+    const bool restore = Verilated::commandArgsPlusMatch("save_restore=")[0];
+    std::unique_ptr<VM_PREFIX> topp{new VM_PREFIX};
+
+    if (restore) {
+        VL_PRINTF("Restoring model from '%s'\n", filenamep);
+        VerilatedRestoreMmap os;
+        os.open(filenamep);
+        os >> main_time;
+        os >> *topp;
+        os.close();
+    } else {
+        topp->clk = false;
+        topp->eval();
+        main_time += 10;
+    }
+
+    while (main_time < 5000 && !Verilated::gotFinish()) {
+        topp->clk = !topp->clk;
+        topp->eval();
+        if (!restore && main_time == 500) {
+            VL_PRINTF("Saving model to '%s'\n", filenamep);
+            VerilatedSave os;
+            os.open(filenamep);
+            os << main_time;
+            os << *topp;
+            os.close();
+            VL_PRINTF("Exiting after save_model\n");
+            return 0;
+        }
+        main_time += 10;
+    }
+    if (!restore) return 0;
+    if (!Verilated::gotFinish()) {
+        vl_fatal(__FILE__, __LINE__, "main", "%Error: Timeout; never got a $finish");
+    }
+    topp->final();
+    return 0;
+}
@@ -0,0 +1,46 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt_all => 1);
+
+compile(
+    verilator_flags2 => ["--rand-streams"],
+    );
+
+my $runs = 0;
+sub values_with_seed {
+    my $seed = shift;
+    execute(
+        all_run_flags => ["+verilator+seed+${seed}"],
+        check_finished => 1,
+        );
+    # Keep each run's log, as file_contents caches by filename
+    my $log = "$Self->{obj_dir}/vlt_sim_" . (++$runs) . ".log";
+    rename("$Self->{obj_dir}/vlt_sim.log", $log);
+    return join("\n", grep { /^a=/ } split(/\n/, file_contents($log)));
+}
+
+my $first = values_with_seed(5);
+my $again = values_with_seed(5);
+my $other = values_with_seed(6);
+$Self->error("Same seed gave different values") if $first ne $again;
+$Self->error("Different seeds gave same values") if $first eq $other;
+$Self->error("Instances gave same values") if $first =~ /^a=(\S+) \1$/m;
+
+file_grep("$Self->{obj_dir}/$Self->{VM_PREFIX}__Slow.cpp", qr/VL_RANDOM_STREAM_I\(/);
+file_grep("$Self->{obj_dir}/$Self->{VM_PREFIX}__Slow.cpp", qr/VL_URANDOM_RANGE_STREAM_I\(/);
+file_grep("$Self->{obj_dir}/$Self->{VM_PREFIX}__Slow.cpp", qr/VL_RAND_STREAM_INIT\(__Vrandstream\d+, name\(\), \d+ULL\);/);
+# Class objects are keyed by the stream of the new call site
+my $cpp = join("", map { file_contents($_) } glob("$Self->{obj_dir}/*.cpp"));
+$Self->error("No class object stream") if $cpp !~ /VL_RAND_STREAM_INIT_OBJ\(__Vrandstream\d+, "/;
+$Self->error("No new call site stream") if $cpp !~ /VL_NEW_RAND_STREAM<\w+>\(__Vrandstream\d+, vlSymsp\)/;
+
+ok(1);
+1;
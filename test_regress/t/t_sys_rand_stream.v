@@ -0,0 +1,55 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2020 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+typedef enum bit [1:0] { ONE = 1, TWO, THREE } num_t;
+
+class Cls;
+   rand bit [7:0] b;
+   rand bit [69:0] w;
+   rand num_t e;
+endclass
+
+module sub (output int r);
+   initial r = $urandom;
+endmodule
+
+module t (/*AUTOARG*/);
+   int r1, r2;
+   sub sub1 (.r(r1));
+   sub sub2 (.r(r2));
+
+   initial begin
+      Cls c;
+      int q[$];
+      int r;
+      int v;
+      int sum;
+
+      c = new;
+      q = '{1, 2, 3, 4, 5, 6, 7, 8};
+
+      #1;
+      $display("a=%x %x", r1, r2);
+      for (int i = 0; i < 4; ++i) begin
+         r = $random;
+         v = $urandom_range(10, 3);
+         if (v < 3 || v > 10) $stop;
+         $display("a=%x %0d", r, v);
+      end
+      for (int i = 0; i < 4; ++i) begin
+         if (c.randomize() != 1) $stop;
+         if (!(c.e inside {ONE, TWO, THREE})) $stop;
+         $display("a=%x %x %0d", c.b, c.w, c.e);
+      end
+      q.shuffle();
+      sum = 0;
+      foreach (q[i]) sum += q[i];
+      if (sum != 36) $stop;
+      $display("a=%p", q);
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
@@ -0,0 +1,36 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vltmt => 1);
+
+my $runs = 0;
+sub values_with_threads {
+    my $threads = shift;
+    compile(
+        verilator_flags2 => ["--rand-streams --threads $threads",
+                             $Self->wno_unopthreads_for_few_cores()],
+        );
+    execute(
+        all_run_flags => ["+verilator+seed+5"],
+        check_finished => 1,
+        );
+    # Keep each run's log, as file_contents caches by filename
+    my $log = "$Self->{obj_dir}/vlt_sim_" . (++$runs) . ".log";
+    rename("$Self->{obj_dir}/vlt_sim.log", $log);
+    return join("\n", grep { /^a=/ } split(/\n/, file_contents($log)));
+}
+
+my $one = values_with_threads(1);
+my $four = values_with_threads(4);
+$Self->error("No values") if $one !~ /^a=20 /m;
+$Self->error("--threads 1 and --threads 4 gave different values") if $one ne $four;
+
+ok(1);
+1;
@@ -0,0 +1,46 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2020 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+class Cls;
+   rand bit [31:0] b;
+endclass
+
+module sub (input clk, output int r, output int f);
+   function int draw;
+      // verilator no_inline_task
+      draw = $urandom;
+   endfunction
+   Cls c;
+   // Independent blocks, so may be in different mtasks
+   always @(posedge clk) r <= $urandom_range(1000, 0);
+   always @(posedge clk) f <= draw();
+   always @(posedge clk) begin
+      c = new;
+      if (c.randomize() != 1) $stop;
+   end
+endmodule
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   int cyc = 0;
+   int r1, r2, r3, f1, f2, f3;
+   sub sub1 (.clk, .r(r1), .f(f1));
+   sub sub2 (.clk, .r(r2), .f(f2));
+   sub sub3 (.clk, .r(r3), .f(f3));
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      $display("a=%0d %0d %0d %x %x %x %x", cyc, r1, r2, r3, f1, f2, f3);
+      if (cyc == 20) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
@@ -0,0 +1,35 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vltmt => 1);
+
+# Small chunks so on hosts with several cores even this file is loaded by
+# several threads
+my $memfile = "$Self->{obj_dir}/chunked.mem";
+{
+    my $out = "// Rows 0 to 'h7ff, then 'h800 onwards after an address\n";
+    for (my $i = 0; $i < 4096; ++$i) {
+        $out .= "\@" . sprintf("%x", $i) . "\n" if $i == 0x800;
+        $out .= "// Row " . sprintf("%x", $i) . "\n" if $i % 100 == 0;
+        $out .= sprintf("%08x\n", ($i * 0x9e3779b9) & 0xffffffff);
+    }
+    write_wholefile($memfile, $out);
+}
+
+compile(verilator_flags2 => ["-CFLAGS -DVL_READMEM_CHUNK_BYTES=1024"],
+        v_flags2 => ["+define+MEMFILE=\\\"$memfile\\\""],
+    );
+
+execute(
+    check_finished => 1,
+    );
+
+ok(1);
+1;
@@ -0,0 +1,24 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2020 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t;
+
+   reg [31:0] mem [0:4095];
+
+   integer    i;
+
+   initial begin
+      $readmemh(`MEMFILE, mem);
+      for (i = 0; i < 4096; i = i + 1) begin
+         if (mem[i] !== i * 32'h9e3779b9) begin
+            $write("%%Error: mem[%0x] = %x\n", i, mem[i]);
+            $stop;
+         end
+      end
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
@@ -0,0 +1,31 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt_all => 1);
+
+# Images with bits set above the row width, which must be ignored
+write_wholefile("$Self->{obj_dir}/narrow.vlmem",
+                pack("a8LLQQ", "VLMEMIMG", 1, 5, 2, 4)
+                . pack("C4", 0xe1, 0xff, 0x3f, 0x00));
+write_wholefile("$Self->{obj_dir}/wide.vlmem",
+                pack("a8LLQQ", "VLMEMIMG", 1, 70, 1, 2)
+                . pack("L6", 0x11111111, 0x22222222, 0xffffffff,
+                       0x33333333, 0x44444444, 0xc0));
+
+compile(v_flags2 => ["+define+NARROW=\\\"$Self->{obj_dir}/narrow.vlmem\\\"",
+                     "+define+WIDE=\\\"$Self->{obj_dir}/wide.vlmem\\\""],
+    );
+
+execute(
+    check_finished => 1,
+    );
+
+ok(1);
+1;
@@ -0,0 +1,49 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2020 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`define checkh(gotv,expv) do if ((gotv) !== (expv)) begin $write("%%Error: %s:%0d:  got='h%x exp='h%x\n", `__FILE__,`__LINE__, (gotv), (expv)); $stop; end while(0);
+
+module t;
+
+   reg [4:0] narrow [0:7];
+   reg [4:0] narrow_start [0:7];
+   reg [69:0] wide [0:3];
+
+   integer    i;
+
+   initial begin
+      for (i = 0; i < 8; i = i + 1) begin
+         narrow[i] = 5'h0a;
+         narrow_start[i] = 5'h0a;
+      end
+      for (i = 0; i < 4; i = i + 1) wide[i] = 70'h0;
+
+      // Image address is used when no start address is given
+      $readmemh(`NARROW, narrow);
+      `checkh(narrow[1], 5'h0a);
+      `checkh(narrow[2], 5'h01);
+      `checkh(narrow[3], 5'h1f);
+      `checkh(narrow[4], 5'h1f);
+      `checkh(narrow[5], 5'h00);
+      `checkh(narrow[6], 5'h0a);
+
+      // Image address within the given start and end addresses
+      $readmemh(`NARROW, narrow_start, 1, 5);
+      `checkh(narrow_start[1], 5'h0a);
+      `checkh(narrow_start[2], 5'h01);
+      `checkh(narrow_start[5], 5'h00);
+      `checkh(narrow_start[6], 5'h0a);
+
+      $readmemb(`WIDE, wide);
+      `checkh(wide[0], 70'h0);
+      `checkh(wide[1], 70'h3f_22222222_11111111);
+      `checkh(wide[2], 70'h00_44444444_33333333);
+      `checkh(wide[3], 70'h0);
+
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
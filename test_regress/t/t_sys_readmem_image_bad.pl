@@ -0,0 +1,26 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+
+# Image starting at address 2, below the start address given to $readmem
+write_wholefile("$Self->{obj_dir}/t_sys_readmem_image_bad.vlmem",
+                pack("a8LLQQ", "VLMEMIMG", 1, 8, 2, 4) . pack("C4", 1, 2, 3, 4));
+
+compile(v_flags2 => ["+define+IMAGE=\\\"$Self->{obj_dir}/t_sys_readmem_image_bad.vlmem\\\""],
+    );
+
+execute(
+    fails => 1,
+    expect_filename => $Self->{golden_filename},
+    );
+
+ok(1);
+1;
@@ -0,0 +1,16 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2020 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t;
+
+   reg [7:0] mem [0:15];
+
+   initial begin
+      $readmemh(`IMAGE, mem, 4);
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
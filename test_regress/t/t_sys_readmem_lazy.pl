@@ -0,0 +1,33 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt_all => 1);
+
+top_filename("t/t_sys_readmem.v");
+
+# All memories lazily allocated
+compile(verilator_flags2 => ["--lazy-array-size 1"],
+        v_flags2 => [
+            "+define+WRITEMEM_READ_BACK=1",
+            "+define+OUT_TMP1=\\\"$Self->{obj_dir}/tmp1.mem\\\"",
+            "+define+OUT_TMP2=\\\"$Self->{obj_dir}/tmp2.mem\\\"",
+            "+define+OUT_TMP3=\\\"$Self->{obj_dir}/tmp3.mem\\\"",
+            "+define+OUT_TMP4=\\\"$Self->{obj_dir}/tmp4.mem\\\"",
+            "+define+OUT_TMP5=\\\"$Self->{obj_dir}/tmp5.mem\\\"",
+        ]);
+
+execute(
+    check_finished => 1,
+    );
+
+file_grep("$Self->{obj_dir}/$Self->{VM_PREFIX}.h", qr/VlPagedUnpacked</);
+
+ok(1);
+1;
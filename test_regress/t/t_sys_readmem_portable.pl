@@ -0,0 +1,26 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+# Same test as t_sys_readmem, but with the scalar parser in place of SSE2
+
+scenarios(vlt => 1);
+
+top_filename("t/t_sys_readmem.v");
+
+compile(
+    verilator_flags2 => ['-CFLAGS -DVL_PORTABLE_ONLY'],
+    );
+
+execute(
+    check_finished => 1,
+    );
+
+ok(1);
+1;
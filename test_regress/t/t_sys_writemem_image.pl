@@ -0,0 +1,36 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt_all => 1);
+
+top_filename("t/t_sys_readmem.v");
+
+# Files ending in .vlmem are written and read back as binary images
+$Self->{verilated_randReset} = 2;  # 2 == truly random
+
+compile(v_flags2 => [
+            "+define+WRITEMEM_READ_BACK=1",
+            "+define+OUT_TMP1=\\\"$Self->{obj_dir}/tmp1.vlmem\\\"",
+            "+define+OUT_TMP2=\\\"$Self->{obj_dir}/tmp2.vlmem\\\"",
+            "+define+OUT_TMP3=\\\"$Self->{obj_dir}/tmp3.vlmem\\\"",
+            "+define+OUT_TMP4=\\\"$Self->{obj_dir}/tmp4.vlmem\\\"",
+            "+define+OUT_TMP5=\\\"$Self->{obj_dir}/tmp5.vlmem\\\"",
+        ]);
+
+execute(
+    check_finished => 1,
+    );
+
+for (my $i = 1; $i <= 5; $i++) {
+    file_grep("$Self->{obj_dir}/tmp${i}.vlmem", qr/^VLMEMIMG/);
+}
+
+ok(1);
+1;
@@ -0,0 +1,49 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2020 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+
+   input clk;
+
+   integer cyc = 0;
+
+   reg [31:0] a = 32'h12345678;
+   reg [31:0] b = 32'h9abcdef0;
+
+   // Independent combinational cones, all settled at time zero
+   wire [31:0] s0 = a + b;
+   wire [31:0] x0 = a ^ b;
+   wire [31:0] s1 = s0 + x0;
+   wire [31:0] x1 = s0 ^ (x0 << 1);
+   wire [31:0] r = s1 - x1;
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+`ifdef TEST_VERBOSE
+      $write("[%0t] cyc=%0d s0=%x x0=%x s1=%x x1=%x r=%x\n", $time, cyc, s0, x0, s1, x1, r);
+`endif
+      if (cyc == 0) begin
+         // Values must be settled before the first clock edge
+         if (s0 !== 32'hacf13568) $stop;
+         if (x0 !== 32'h88888888) $stop;
+         if (s1 !== 32'h3579bdf0) $stop;
+         if (x1 !== 32'hbde02478) $stop;
+         if (r !== 32'h77999978) $stop;
+         a <= 32'h0;
+      end
+      else if (cyc == 1) begin
+         if (s0 !== 32'h9abcdef0) $stop;
+         if (r !== 32'h85b45ad0) $stop;
+      end
+      else if (cyc == 2) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
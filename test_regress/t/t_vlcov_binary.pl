@@ -0,0 +1,34 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2003-2020 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(dist => 1);
+
+run(cmd => ["../bin/verilator_coverage",
+            "--write-binary", "$Self->{obj_dir}/coverage.bin",
+            "t/t_vlcov_data_a.dat",
+            "t/t_vlcov_data_b.dat",
+            "t/t_vlcov_data_c.dat",
+            "t/t_vlcov_data_d.dat",
+    ],
+    verilator_run => 1,
+    );
+
+# Converting back to text must match merging the text files directly
+run(cmd => ["../bin/verilator_coverage",
+            "--write", "$Self->{obj_dir}/coverage.dat",
+            "$Self->{obj_dir}/coverage.bin",
+    ],
+    verilator_run => 1,
+    );
+
+files_identical_sorted("$Self->{obj_dir}/coverage.dat", "t/t_vlcov_merge.out");
+
+ok(1);
+1;
@@ -0,0 +1,46 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2003-2020 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(dist => 1);
+
+my $db = "$Self->{obj_dir}/merge_db";
+
+# Fold the runs into the database incrementally
+foreach my $data ("a", "b", "c", "d") {
+    run(cmd => ["../bin/verilator_coverage",
+                "--merge-db", $db,
+                "t/t_vlcov_data_${data}.dat",
+        ],
+        verilator_run => 1,
+        );
+}
+
+run(cmd => ["../bin/verilator_coverage",
+            "--merge-db", $db,
+            "--write", "$Self->{obj_dir}/coverage.dat",
+    ],
+    verilator_run => 1,
+    );
+
+files_identical_sorted("$Self->{obj_dir}/coverage.dat", "t/t_vlcov_merge.out");
+
+run(cmd => ["../bin/verilator_coverage",
+            "--merge-db", $db,
+            "--rank",
+    ],
+    logfile => "$Self->{obj_dir}/vlcov.log",
+    tee => 0,
+    verilator_run => 1,
+    );
+
+files_identical("$Self->{obj_dir}/vlcov.log", "t/t_vlcov_rank.out");
+
+ok(1);
+1;
@@ -0,0 +1,30 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2003-2020 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(dist => 1);
+
+my $db = "$Self->{obj_dir}/merge_db";
+mkdir $db;
+
+# A database listing one point twice
+my $point = "\001f\002file1.sp\001l\002159\001h\002top\n";
+write_wholefile("$db/points.dat", $point . $point);
+
+run(fails => 1,
+    cmd => ["../bin/verilator_coverage",
+            "--merge-db", $db,
+    ],
+    logfile => $Self->{run_log_filename},
+    expect_filename => $Self->{golden_filename},
+    verilator_run => 1,
+    );
+
+ok(1);
+1;
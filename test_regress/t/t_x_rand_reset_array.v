@@ -0,0 +1,39 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2020 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/);
+
+   // verilator lint_off UNDRIVEN
+   reg [7:0] mem_a [0:1023];
+   reg [7:0] mem_b [0:1023];
+   reg [69:0] wide [0:2][0:3];
+   // verilator lint_on UNDRIVEN
+
+   integer i, j;
+   integer same_a, same_ab, same_w;
+
+   initial begin
+      same_a = 0;
+      same_ab = 0;
+      for (i = 1; i < 1024; i = i + 1) begin
+         if (mem_a[i] == mem_a[0]) same_a = same_a + 1;
+         if (mem_a[i] == mem_b[i]) same_ab = same_ab + 1;
+      end
+      // Random, so expect 1/256 of each to match
+      if (same_a > 64) $stop;
+      // Each array has its own values
+      if (same_ab > 64) $stop;
+      same_w = 0;
+      for (i = 0; i < 3; i = i + 1) begin
+         for (j = 0; j < 4; j = j + 1) begin
+            if (wide[i][j] == wide[0][0]) same_w = same_w + 1;
+         end
+      end
+      if (same_w != 1) $stop;
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule